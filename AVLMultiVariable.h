@@ -5,14 +5,15 @@
 #include "Node.h"
 #include "ComplexNode.h"
 #include "Exception.h"
+#include <climits>
 
 /*
 * Class MultiTree : Tree
 * This class is used to create a tree based on ComplexNode that is sorted by three keys:
 *       the number of goals the player scored, the number of cards they received, and their player ID
 */
-template <class T>
-class MultiTree : public Tree<ComplexNode<T>, T> {
+template <class T, class B = DefaultBalance>
+class MultiTree : public Tree<ComplexNode<T>, T, B> {
 public:
 
     /*
@@ -51,6 +52,15 @@ public:
      */
     void remove(const int id, const int goals, const int cards);
 
+    /*
+     * Change the goals and cards of a node, moving it to its new place in the order of the tree.
+     * If the node still fits between its neighbours only its keys are updated. Otherwise the same node is
+     * detached and relinked, searching for its new place upwards from its old neighbour in the direction it moves.
+     * @param - The ID, goals, and cards of the node, and its new goals and cards
+     * @return - bool, true if the node moved to a different place in the order of the tree
+     */
+    bool reposition(const int id, const int goals, const int cards, const int newGoals, const int newCards);
+
     /*
      * Search for max node by going down the right side of the tree
      * @param - none
@@ -79,13 +89,80 @@ public:
      */
     ComplexNode<T>& search_recursively(const int id, const int goals, const int cards, ComplexNode<T>* currentNode);
 
+    /*
+     * Insert the ID's of the largest nodes into a given array, from the max node downwards
+     * @param - an array and the maximum number of ID's to insert
+     * @return - the number of ID's inserted
+     */
+    int get_top_data(int* const array, const int amount);
+
+    /*
+     * Find the position of a node when the tree is ordered from the max node downwards (the max node is ranked 1)
+     * @param - The ID, goals, and cards of the requested node
+     * @return - the rank of the node
+     */
+    int get_rank(const int id, const int goals, const int cards);
+
+    /*
+     * Count the nodes with a number of goals within a given range
+     * @param - The minimum and maximum number of goals
+     * @return - the number of nodes found
+     */
+    int count_goals_range(const int minGoals, const int maxGoals);
+
+    /*
+     * Insert the ID's of the nodes with a number of goals within a given range into a given array, in tree order
+     * @param - an array, the minimum and maximum number of goals
+     * @return - the number of ID's inserted
+     */
+    int get_goals_range(int* const array, const int minGoals, const int maxGoals);
+
+    /*
+     * Count the nodes with more than a given number of cards.
+     * Cards are the secondary key of the tree, so every group of nodes with the same number of goals is counted on
+     * its own, in O(log n) per group.
+     * @param - The number of cards
+     * @return - the number of nodes found
+     */
+    int count_above_cards(const int cards);
+
+    /*
+     * Insert the ID's of the nodes with more than a given number of cards into a given array, in tree order
+     * @param - an array, the number of cards
+     * @return - the number of ID's inserted
+     */
+    int get_above_cards(int* const array, const int cards);
+
+    /*
+     * Helper function for get_closest_players in world_cup:
+     * Insert the ID's of the nodes closest to the given goals, cards, and ID into a given array, from the closest
+     * onwards. Nodes are compared like Player::get_closest - by the difference in goals, then in cards, then in ID,
+     * and finally preferring the bigger ID. A node with the given ID is skipped.
+     * The search expands from the given stats one distance of goals at a time, and within it one distance of cards
+     * at a time, walking both sides of the ID's of each group of nodes with the same goals and cards.
+     * @param - an array, the maximum number of ID's to insert, and the goals, cards, and ID to compare to
+     * @return - the number of ID's inserted
+     */
+    int get_closest_data(int* const array, const int amount, const int goals, const int cards, const int id);
+
+    /*
+     * Insert the ID's of the nodes that come after the given goals, cards, and ID into a given array, in tree order.
+     * The given node itself need not be in the tree, so a walk may resume from a node that was since removed.
+     * @param - an array, the maximum number of ID's to insert, and the goals, cards, and ID to start after, which
+     *      are set to those of the last node inserted
+     * @return - the number of ID's inserted
+     */
+    int get_data_after(int* const array, const int amount, int& goals, int& cards, int& id);
+
     /*
      * Helper function for get_all_players in world_cup:
-     * Recursively inserts the player ID's of the data of the tree into a given array
-     * @param - an array
+     * Recursively inserts the player ID's of the data of the tree into a given array. The size of every subtree is
+     * known, so so is the range of the array it fills - large subtrees fill their ranges in parallel, if a pool is
+     * given.
+     * @param - an array, and the pool
      * @return - void
      */
-    void get_all_data(int* const array) const;
+    void get_all_data(int* const array, ThreadPool* pool = nullptr) const;
 
     /*
      * Helper function for get_closest_player in world_cup:
@@ -95,23 +172,95 @@ public:
      */
     void update_closest(const int playerId, const int goals, const int cards);
 
+    /*
+     * Check the links and the subtree fields of every node, and that the nodes are sorted by their goals, cards and
+     * ID - used by the tests after the tree changes
+     * @param - none
+     * @return - bool, true if the tree is consistent
+     */
+    bool is_consistent() const;
+
     /*
      * Helper function for unite_teams in world_cup:
-     * Creates a tree from a given ordered array
-     * @param - a pointer to the array and its final index
+     * Creates a tree from a given ordered array - large subtrees are built in parallel by the pool, if one is given
+     * @param - a pointer to the array, its final index, and the pool
      * @return - void
      */
-    void insertInorder(T* data, const int end);
+    void insertInorder(T* data, const int end, ThreadPool* pool = nullptr);
 
 private:
 
     /*
      * Helper function for unite_teams in world_cup:
      * Recursively inserts the data from the array into a tree
-     * @param - a pointer to the array, its starting index, and its final index
+     * @param - a pointer to the array, its starting index, its final index, and the pool (or nullptr)
      * @return - a pointer to the root node at the end of the insertions
      */
-    ComplexNode<T>* insertInorderRecursive(T* data, const int start, const int end);
+    ComplexNode<T>* insertInorderRecursive(T* data, const int start, const int end, ThreadPool* pool = nullptr);
+
+    /*
+     * Helper function for get_data_after:
+     * Recursively inserts the ID's of the nodes of a subtree that come after the given goals, cards, and ID
+     * @param - the root of the subtree, an array, its current index, the maximum number of ID's, the goals, cards,
+     *      and ID to start after, and where the last node inserted is stored
+     * @return - the new current index of the array
+     */
+    int get_data_after_recursive(const ComplexNode<T>* node, int* const array, int index, const int amount,
+                                 const int goals, const int cards, const int id, const ComplexNode<T>*& last) const;
+
+    /*
+     * Helper function for get_all_data:
+     * Inserts the ID's of a subtree into the array from the given index, with its two subtrees filled at the same
+     * time while they are large enough
+     * @param - the root of the subtree, an array, its starting index, and the pool
+     * @return - void
+     */
+    void get_all_data_parallel(const ComplexNode<T>* node, int* const array, const int index,
+                               ThreadPool* pool) const;
+
+    /*
+     * Count the nodes that come before the given goals, cards, and ID in the order of the tree
+     * @param - The goals, cards, and ID to compare the nodes to
+     * @return - the number of nodes found
+     */
+    int count_before(const int goals, const int cards, const int id);
+
+    /*
+     * Find the first node that does not come before the given goals, cards, and ID in the order of the tree
+     * @param - The goals, cards, and ID to compare the nodes to
+     * @return - the node found, or nullptr if every node comes before them
+     */
+    ComplexNode<T>* lower_bound(const int goals, const int cards, const int id);
+
+    /*
+     * Helper function for count_before and lower_bound:
+     * Checks whether a node comes before the given goals, cards, and ID in the order of the tree
+     * @param - The node, and the goals, cards, and ID to compare it to
+     * @return - bool, true if the node comes before them
+     */
+    bool is_before(const ComplexNode<T>* node, const int goals, const int cards, const int id) const;
+
+    /*
+     * Find the last node that comes before the given goals, cards, and ID in the order of the tree
+     * @param - The goals, cards, and ID to compare the nodes to
+     * @return - the node found, or nullptr if no node comes before them
+     */
+    ComplexNode<T>* last_before(const int goals, const int cards, const int id);
+
+    /*
+     * Helper functions for get_closest_data:
+     * get_closest_goals: inserts the closest ID's out of the groups with the given goals (all at the same distance
+     *      of goals), one distance of cards at a time
+     * get_closest_blocks: inserts the closest ID's out of the blocks of nodes with the given goals and cards (all at
+     *      the same distance of goals and cards), walking to both sides of the given ID in each block
+     * @param - an array, its current index, the maximum number of ID's, the groups / blocks, and the stats to
+     *      compare to
+     * @return - the new current index of the array
+     */
+    int get_closest_goals(int* const array, int index, const int amount, const int* groupGoals, const int numGroups,
+                          const int cards, const int id);
+    int get_closest_blocks(int* const array, int index, const int amount, const int* blockGoals,
+                           const int* blockCards, const int numBlocks, const int id);
 
     /*
      * Helper functions for update_closest:
@@ -126,21 +275,22 @@ private:
 
 //-----------------------------------------Constructor--------------------------
 
-template<class T>
-MultiTree<T>::MultiTree() :
-    Tree<ComplexNode<T>, T>()
+template <class T, class B>
+MultiTree<T, B>::MultiTree() :
+    Tree<ComplexNode<T>, T, B>()
 {}
 
 
 //----------------------------------Insert and Remove---------------------------------
 
-template<class T>
-void MultiTree<T>::insert(T data, const int id, const int goals, const int cards) {
+template <class T, class B>
+void MultiTree<T, B>::insert(T data, const int id, const int goals, const int cards) {
     //If this is the first node in the tree:
     if (this->m_node->m_height == -1) {
         this->m_node->m_data = data;
         this->m_node->m_id = id;
         this->m_node->m_height++;
+        this->m_node->update_size();
         this->m_node->m_goals = goals;
         this->m_node->m_cards = cards;
         return;
@@ -196,6 +346,7 @@ void MultiTree<T>::insert(T data, const int id, const int goals, const int cards
     node->m_cards = cards;
     node->m_id = id;
     node->m_height = 0;
+    node->update_size();
     if (node->m_goals < parent->m_goals) {
         parent->m_left = node;
     }
@@ -222,30 +373,96 @@ void MultiTree<T>::insert(T data, const int id, const int goals, const int cards
 }
 
 
-template<class T>
-void MultiTree<T>::remove(const int id, const int goals, const int cards) {
+template <class T, class B>
+void MultiTree<T, B>::remove(const int id, const int goals, const int cards) {
     if (this->m_node->m_id == id && this->m_node->m_right == nullptr && this->m_node->m_left == nullptr 
                                                                                 && this->m_node->m_parent == nullptr) {
         this->m_node->m_data = nullptr;
         this->m_node->m_height = -1;
         this->m_node->m_bf = 0;
         this->m_node->m_id = 0;
+        this->m_node->m_size = 0;
         this->m_node->m_goals = 0;
         this->m_node->m_cards = 0;
         return;
     }
     ComplexNode<T>* toRemove = &(search_specific_id(id, goals, cards));
-    ComplexNode<T>* nodeToFix = Tree<ComplexNode<T>, T>::make_node_leaf(toRemove);
-    delete toRemove;
+    ComplexNode<T>* nodeToFix = Tree<ComplexNode<T>, T, B>::make_node_leaf(toRemove);
+    this->release_node(toRemove);
     //Go up the tree and check the balance factors and complete needed rotations
-    Tree<ComplexNode<T>, T>::rebalance_tree(nodeToFix);
+    Tree<ComplexNode<T>, T, B>::rebalance_tree(nodeToFix);
+}
+
+
+template <class T, class B>
+bool MultiTree<T, B>::reposition(const int id, const int goals, const int cards, const int newGoals,
+                              const int newCards) {
+    ComplexNode<T>* node = &(search_specific_id(id, goals, cards));
+    ComplexNode<T>* closestLeft = findLeftClosest(node);
+    ComplexNode<T>* closestRight = findRightClosest(node);
+    //The order does not change - update the keys in place
+    if ((closestLeft == nullptr || is_before(closestLeft, newGoals, newCards, id)) &&
+                                (closestRight == nullptr || !is_before(closestRight, newGoals, newCards, id))) {
+        node->m_goals = newGoals;
+        node->m_cards = newCards;
+        return false;
+    }
+    //The node moves towards one of its neighbours, which stays in the tree and is the start of the search
+    bool movesRight = (closestRight != nullptr && is_before(closestRight, newGoals, newCards, id));
+    ComplexNode<T>* x;
+    if (movesRight) {
+        x = closestRight;
+    }
+    else {
+        x = closestLeft;
+    }
+    ComplexNode<T>* nodeToFix = Tree<ComplexNode<T>, T, B>::make_node_leaf(node);
+    Tree<ComplexNode<T>, T, B>::rebalance_tree(nodeToFix);
+    //Go up until the subtree of x is bounded on the far side by its parent
+    while (x->m_parent != nullptr) {
+        bool fromLeft = (x->m_parent->m_left == x);
+        if (movesRight && fromLeft && !is_before(x->m_parent, newGoals, newCards, id)) {
+            break;
+        }
+        if (!movesRight && !fromLeft && is_before(x->m_parent, newGoals, newCards, id)) {
+            break;
+        }
+        x = x->m_parent;
+    }
+    //Go down from x to the new place of the node
+    ComplexNode<T>* parent = x;
+    while (x != nullptr) {
+        parent = x;
+        if (is_before(x, newGoals, newCards, id)) {
+            x = x->m_right;
+        }
+        else {
+            x = x->m_left;
+        }
+    }
+    node->m_parent = parent;
+    node->m_left = nullptr;
+    node->m_right = nullptr;
+    node->m_goals = newGoals;
+    node->m_cards = newCards;
+    node->m_height = 0;
+    node->m_bf = 0;
+    node->update_size();
+    if (is_before(parent, newGoals, newCards, id)) {
+        parent->m_right = node;
+    }
+    else {
+        parent->m_left = node;
+    }
+    this->rebalance_tree(parent);
+    return true;
 }
 
 
 //-----------------------------------------Search Functions-----------------------------------------
 
-template<class T>
-T& MultiTree<T>::search_and_return_max() {
+template <class T, class B>
+T& MultiTree<T, B>::search_and_return_max() {
     ComplexNode<T>* node = this->m_node;
     while(node->m_right != nullptr) {
         node = node->m_right;
@@ -254,20 +471,20 @@ T& MultiTree<T>::search_and_return_max() {
 }
 
 
-template<class T>
-T& MultiTree<T>::search_and_return_data(const int id, const int goals, const int cards) {
+template <class T, class B>
+T& MultiTree<T, B>::search_and_return_data(const int id, const int goals, const int cards) {
     return search_recursively(id, goals, cards, this->m_node).m_data;
 }
 
 
-template<class T>
-ComplexNode<T>& MultiTree<T>::search_specific_id(const int id, const int goals, const int cards) {
+template <class T, class B>
+ComplexNode<T>& MultiTree<T, B>::search_specific_id(const int id, const int goals, const int cards) {
     return search_recursively(id, goals, cards, this->m_node);
 }
 
 
-template<class T>
-ComplexNode<T>& MultiTree<T>::search_recursively(const int id, const int goals, const int cards,
+template <class T, class B>
+ComplexNode<T>& MultiTree<T, B>::search_recursively(const int id, const int goals, const int cards,
              ComplexNode<T>* currentNode) {
     if (currentNode == nullptr) {
         throw NodeNotFound();
@@ -288,19 +505,180 @@ ComplexNode<T>& MultiTree<T>::search_recursively(const int id, const int goals,
 }
 
 
+template <class T, class B>
+int MultiTree<T, B>::get_top_data(int* const array, const int amount) {
+    if (this->m_node->m_height == -1) {
+        return 0;
+    }
+    ComplexNode<T>* node = this->m_node;
+    while (node->m_right != nullptr) {
+        node = node->m_right;
+    }
+    //Walk backwards from the max node, one predecessor at a time
+    int index = 0;
+    while (node != nullptr && index < amount) {
+        array[index++] = node->m_id;
+        node = findLeftClosest(node);
+    }
+    return index;
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::get_rank(const int id, const int goals, const int cards) {
+    ComplexNode<T>* node = &(search_specific_id(id, goals, cards));
+    //Every node in the right subtree is larger than the node
+    int rank = 1;
+    if (node->m_right != nullptr) {
+        rank += node->m_right->m_size;
+    }
+    //Every ancestor reached from its left side is larger, together with its right subtree
+    while (node->m_parent != nullptr) {
+        if (node->m_parent->m_left == node) {
+            rank++;
+            if (node->m_parent->m_right != nullptr) {
+                rank += node->m_parent->m_right->m_size;
+            }
+        }
+        node = node->m_parent;
+    }
+    return rank;
+}
+
+
+//-----------------------------------------Range Functions-----------------------------------------
+
+template <class T, class B>
+int MultiTree<T, B>::count_goals_range(const int minGoals, const int maxGoals) {
+    //No node comes before (goals, INT_MAX, 0) with the same number of goals
+    int upTo = this->get_size();
+    if (maxGoals < INT_MAX) {
+        upTo = count_before(maxGoals + 1, INT_MAX, 0);
+    }
+    return upTo - count_before(minGoals, INT_MAX, 0);
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::get_goals_range(int* const array, const int minGoals, const int maxGoals) {
+    ComplexNode<T>* node = lower_bound(minGoals, INT_MAX, 0);
+    int index = 0;
+    while (node != nullptr && node->m_goals <= maxGoals) {
+        array[index++] = node->m_id;
+        node = findRightClosest(node);
+    }
+    return index;
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::count_above_cards(const int cards) {
+    int counter = 0;
+    ComplexNode<T>* group = lower_bound(INT_MIN, INT_MAX, 0);
+    while (group != nullptr) {
+        //Within a group of the same goals the nodes are sorted by descending cards
+        int goals = group->m_goals;
+        counter += count_before(goals, cards, 0) - count_before(goals, INT_MAX, 0);
+        if (goals == INT_MAX) {
+            break;
+        }
+        group = lower_bound(goals + 1, INT_MAX, 0);
+    }
+    return counter;
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::get_above_cards(int* const array, const int cards) {
+    int index = 0;
+    ComplexNode<T>* node = lower_bound(INT_MIN, INT_MAX, 0);
+    while (node != nullptr) {
+        int goals = node->m_goals;
+        while (node != nullptr && node->m_goals == goals && node->m_cards > cards) {
+            array[index++] = node->m_id;
+            node = findRightClosest(node);
+        }
+        if (goals == INT_MAX) {
+            break;
+        }
+        node = lower_bound(goals + 1, INT_MAX, 0);
+    }
+    return index;
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::get_closest_data(int* const array, const int amount, const int goals, const int cards,
+                                   const int id) {
+    int index = 0;
+    //The closest groups of goals on each side: the last with at most the given goals and the first with more
+    ComplexNode<T>* lowNode = last_before(goals, INT_MIN, INT_MIN);
+    ComplexNode<T>* highNode = lower_bound(goals, INT_MIN, INT_MIN);
+    while (index < amount && (lowNode != nullptr || highNode != nullptr)) {
+        int distance = INT_MAX;
+        if (lowNode != nullptr) {
+            distance = goals - lowNode->m_goals;
+        }
+        if (highNode != nullptr && highNode->m_goals - goals < distance) {
+            distance = highNode->m_goals - goals;
+        }
+        //Every group at the current distance of goals is searched together
+        int groupGoals[2];
+        int numGroups = 0;
+        bool lowUsed = false, highUsed = false;
+        if (lowNode != nullptr && goals - lowNode->m_goals == distance) {
+            groupGoals[numGroups++] = lowNode->m_goals;
+            lowUsed = true;
+        }
+        if (highNode != nullptr && highNode->m_goals - goals == distance) {
+            groupGoals[numGroups++] = highNode->m_goals;
+            highUsed = true;
+        }
+        index = get_closest_goals(array, index, amount, groupGoals, numGroups, cards, id);
+        if (lowUsed) {
+            lowNode = last_before(lowNode->m_goals, INT_MAX, INT_MIN);
+        }
+        if (highUsed) {
+            highNode = lower_bound(highNode->m_goals, INT_MIN, INT_MIN);
+        }
+    }
+    return index;
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::get_data_after(int* const array, const int amount, int& goals, int& cards, int& id) {
+    if (this->m_node->m_height == -1) {
+        return 0;
+    }
+    const ComplexNode<T>* last = nullptr;
+    int index = get_data_after_recursive(this->m_node, array, 0, amount, goals, cards, id, last);
+    if (last != nullptr) {
+        goals = last->m_goals;
+        cards = last->m_cards;
+        id = last->m_id;
+    }
+    return index;
+}
+
+
 //-----------------------------------------Helper Functions for world_cup-----------------------------------------
 
-template <class T>
-void MultiTree<T>::get_all_data(int* const array) const
+template <class T, class B>
+void MultiTree<T, B>::get_all_data(int* const array, ThreadPool* pool) const
 {
     if (this != nullptr) {
+        if (pool != nullptr && pool->get_num_threads() > 1 && this->m_node->m_height != -1) {
+            get_all_data_parallel(this->m_node, array, 0, pool);
+            return;
+        }
         this->m_node->get_data_inorder(array, 0);
     }
 }
 
 
-template<class T>
-void MultiTree<T>::update_closest(const int playerId, const int goals, const int cards)
+template <class T, class B>
+void MultiTree<T, B>::update_closest(const int playerId, const int goals, const int cards)
 {
     //Search for specific node
     typename ComplexNode<T>::ComplexNode* currentPlayer = &(this->search_specific_id(playerId, goals, cards));
@@ -323,8 +701,31 @@ void MultiTree<T>::update_closest(const int playerId, const int goals, const int
 }
 
 
-template <class T>
-typename ComplexNode<T>::ComplexNode* MultiTree<T>::findLeftClosest(ComplexNode<T>* currentPlayerNode)
+template <class T, class B>
+bool MultiTree<T, B>::is_consistent() const
+{
+    if (this->m_node->m_height == -1) {
+        return this->m_node->m_size == 0;
+    }
+    if (this->m_node->m_parent != nullptr || !this->is_consistent_subtree(this->m_node)) {
+        return false;
+    }
+    const ComplexNode<T>* node = this->m_node;
+    while (node->m_left != nullptr) {
+        node = node->m_left;
+    }
+    for (const ComplexNode<T>* next = this->next_inorder(node); next != nullptr; next = this->next_inorder(next)) {
+        if (!is_before(node, next->m_goals, next->m_cards, next->m_id)) {
+            return false;
+        }
+        node = next;
+    }
+    return true;
+}
+
+
+template <class T, class B>
+typename ComplexNode<T>::ComplexNode* MultiTree<T, B>::findLeftClosest(ComplexNode<T>* currentPlayerNode)
 {
     typename ComplexNode<T>::ComplexNode* closestLeft = currentPlayerNode;
     if (closestLeft->m_left != nullptr) {
@@ -354,8 +755,8 @@ typename ComplexNode<T>::ComplexNode* MultiTree<T>::findLeftClosest(ComplexNode<
 }
 
 
-template <class T>
-typename ComplexNode<T>::ComplexNode* MultiTree<T>::findRightClosest(ComplexNode<T>* currentPlayerNode)
+template <class T, class B>
+typename ComplexNode<T>::ComplexNode* MultiTree<T, B>::findRightClosest(ComplexNode<T>* currentPlayerNode)
 {
     typename ComplexNode<T>::ComplexNode* closestRight = currentPlayerNode;
     if (closestRight->m_right != nullptr) {
@@ -385,36 +786,295 @@ typename ComplexNode<T>::ComplexNode* MultiTree<T>::findRightClosest(ComplexNode
 }
 
 
-template <class T>
-void MultiTree<T>::insertInorder(T* data, const int end) {
+template <class T, class B>
+void MultiTree<T, B>::insertInorder(T* data, const int end, ThreadPool* pool) {
     ComplexNode<T>* tmp = this->m_node;
-    this->m_node = insertInorderRecursive(data, 0, end);
-    delete tmp;
+    this->m_node = insertInorderRecursive(data, 0, end, pool);
+    this->release_node(tmp);
+    if (!B::KEPT_BY_REBUILD) {
+        this->restore_policy(this->m_node);
+    }
 }
 
-template <class T>
-ComplexNode<T>* MultiTree<T>::insertInorderRecursive(T* data, const int start, const int end) {
+template <class T, class B>
+ComplexNode<T>* MultiTree<T, B>::insertInorderRecursive(T* data, const int start, const int end,
+                                                        ThreadPool* pool) {
     //Stop recursion
     if (start > end)
         return nullptr;
     //Get the middle player and make root
     int mid = (start + end)/2;
     ComplexNode<T>* root = new ComplexNode<T>(data[mid]);
-    //Construct left subtree
-    root->m_left =  insertInorderRecursive(data, start, mid-1);
+    if (pool != nullptr && end - start >= this->PARALLEL_GRAIN) {
+        //The subtrees share no nodes, so they are built at the same time
+        pool->parallel_invoke([&]() { root->m_left = insertInorderRecursive(data, start, mid-1, pool); },
+                              [&]() { root->m_right = insertInorderRecursive(data, mid+1, end, pool); });
+    }
+    else {
+        root->m_left = insertInorderRecursive(data, start, mid-1);
+        root->m_right = insertInorderRecursive(data, mid+1, end);
+    }
+    //Link the subtrees
     if (root->m_left != nullptr) {
         root->m_left->m_parent = root;
     }
-    //Construct right subtree
-    root->m_right = insertInorderRecursive(data, mid+1, end);
     if (root->m_right != nullptr) {
         root->m_right->m_parent = root;
     }
     root->update_bf();
     root->update_height();
+    root->update_size();
     return root;
 }
 
+
+template <class T, class B>
+int MultiTree<T, B>::get_data_after_recursive(const ComplexNode<T>* node, int* const array, int index,
+                                              const int amount, const int goals, const int cards, const int id,
+                                              const ComplexNode<T>*& last) const {
+    while (node != nullptr && index < amount) {
+        //The given node and the nodes before it are skipped, along with their left subtrees
+        if (is_before(node, goals, cards, id) ||
+                                    (node->m_goals == goals && node->m_cards == cards && node->m_id == id)) {
+            node = node->m_right;
+            continue;
+        }
+        index = get_data_after_recursive(node->m_left, array, index, amount, goals, cards, id, last);
+        if (index < amount) {
+            array[index++] = node->m_id;
+            last = node;
+        }
+        node = node->m_right;
+    }
+    return index;
+}
+
+
+template <class T, class B>
+void MultiTree<T, B>::get_all_data_parallel(const ComplexNode<T>* node, int* const array, const int index,
+                                            ThreadPool* pool) const {
+    if (node->m_size < this->PARALLEL_GRAIN) {
+        node->get_data_inorder(array, index);
+        return;
+    }
+    //The node comes right after its left subtree, so the two subtrees fill disjoint ranges of the array
+    int position = index + ((node->m_left != nullptr) ? node->m_left->m_size : 0);
+    array[position] = node->m_id;
+    pool->parallel_invoke([&]() { if (node->m_left != nullptr) {
+                                      get_all_data_parallel(node->m_left, array, index, pool);
+                                  } },
+                          [&]() { if (node->m_right != nullptr) {
+                                      get_all_data_parallel(node->m_right, array, position + 1, pool);
+                                  } });
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::count_before(const int goals, const int cards, const int id) {
+    if (this->m_node->m_height == -1) {
+        return 0;
+    }
+    int counter = 0;
+    ComplexNode<T>* x = this->m_node;
+    while (x != nullptr) {
+        if (is_before(x, goals, cards, id)) {
+            //x and its whole left subtree come before
+            counter++;
+            if (x->m_left != nullptr) {
+                counter += x->m_left->m_size;
+            }
+            x = x->m_right;
+        }
+        else {
+            x = x->m_left;
+        }
+    }
+    return counter;
+}
+
+
+template <class T, class B>
+ComplexNode<T>* MultiTree<T, B>::lower_bound(const int goals, const int cards, const int id) {
+    if (this->m_node->m_height == -1) {
+        return nullptr;
+    }
+    ComplexNode<T>* x = this->m_node;
+    ComplexNode<T>* found = nullptr;
+    while (x != nullptr) {
+        if (is_before(x, goals, cards, id)) {
+            x = x->m_right;
+        }
+        else {
+            found = x;
+            x = x->m_left;
+        }
+    }
+    return found;
+}
+
+
+template <class T, class B>
+bool MultiTree<T, B>::is_before(const ComplexNode<T>* node, const int goals, const int cards, const int id) const {
+    if (node->m_goals != goals) {
+        return node->m_goals < goals;
+    }
+    if (node->m_cards != cards) {
+        return node->m_cards > cards;
+    }
+    return node->m_id < id;
+}
+
+
+template <class T, class B>
+ComplexNode<T>* MultiTree<T, B>::last_before(const int goals, const int cards, const int id) {
+    if (this->m_node->m_height == -1) {
+        return nullptr;
+    }
+    ComplexNode<T>* x = this->m_node;
+    ComplexNode<T>* found = nullptr;
+    while (x != nullptr) {
+        if (is_before(x, goals, cards, id)) {
+            found = x;
+            x = x->m_right;
+        }
+        else {
+            x = x->m_left;
+        }
+    }
+    return found;
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::get_closest_goals(int* const array, int index, const int amount, const int* groupGoals,
+                                    const int numGroups, const int cards, const int id) {
+    //Within a group of goals the cards are descending: the closest block with at most the given cards is the first
+    //after them, and the closest block with more cards is the last before them
+    ComplexNode<T>* lowNodes[2];
+    ComplexNode<T>* highNodes[2];
+    for (int i = 0; i < numGroups; i++) {
+        lowNodes[i] = lower_bound(groupGoals[i], cards, INT_MIN);
+        if (lowNodes[i] != nullptr && lowNodes[i]->m_goals != groupGoals[i]) {
+            lowNodes[i] = nullptr;
+        }
+        highNodes[i] = last_before(groupGoals[i], cards, INT_MIN);
+        if (highNodes[i] != nullptr && highNodes[i]->m_goals != groupGoals[i]) {
+            highNodes[i] = nullptr;
+        }
+    }
+    while (index < amount) {
+        int distance = INT_MAX;
+        for (int i = 0; i < numGroups; i++) {
+            if (lowNodes[i] != nullptr && cards - lowNodes[i]->m_cards < distance) {
+                distance = cards - lowNodes[i]->m_cards;
+            }
+            if (highNodes[i] != nullptr && highNodes[i]->m_cards - cards < distance) {
+                distance = highNodes[i]->m_cards - cards;
+            }
+        }
+        if (distance == INT_MAX) {
+            break;
+        }
+        //Every block at the current distance of cards is searched together, then replaced by the next block
+        int blockGoals[4];
+        int blockCards[4];
+        int numBlocks = 0;
+        for (int i = 0; i < numGroups; i++) {
+            if (lowNodes[i] != nullptr && cards - lowNodes[i]->m_cards == distance) {
+                blockGoals[numBlocks] = groupGoals[i];
+                blockCards[numBlocks++] = lowNodes[i]->m_cards;
+                if (lowNodes[i]->m_cards == INT_MIN) {
+                    lowNodes[i] = nullptr;
+                }
+                else {
+                    lowNodes[i] = lower_bound(groupGoals[i], lowNodes[i]->m_cards - 1, INT_MIN);
+                }
+                if (lowNodes[i] != nullptr && lowNodes[i]->m_goals != groupGoals[i]) {
+                    lowNodes[i] = nullptr;
+                }
+            }
+            if (highNodes[i] != nullptr && highNodes[i]->m_cards - cards == distance) {
+                blockGoals[numBlocks] = groupGoals[i];
+                blockCards[numBlocks++] = highNodes[i]->m_cards;
+                highNodes[i] = last_before(groupGoals[i], highNodes[i]->m_cards, INT_MIN);
+                if (highNodes[i] != nullptr && highNodes[i]->m_goals != groupGoals[i]) {
+                    highNodes[i] = nullptr;
+                }
+            }
+        }
+        index = get_closest_blocks(array, index, amount, blockGoals, blockCards, numBlocks, id);
+    }
+    return index;
+}
+
+
+template <class T, class B>
+int MultiTree<T, B>::get_closest_blocks(int* const array, int index, const int amount, const int* blockGoals,
+                                     const int* blockCards, const int numBlocks, const int id) {
+    //Each block is walked from the given ID outwards, to the right (bigger ID's) and to the left (smaller ID's)
+    ComplexNode<T>* heads[8];
+    bool toRight[8];
+    int goals[8];
+    int cards[8];
+    int numHeads = 0;
+    for (int i = 0; i < numBlocks; i++) {
+        ComplexNode<T>* right = nullptr;
+        if (id < INT_MAX) {
+            right = lower_bound(blockGoals[i], blockCards[i], id + 1);
+        }
+        ComplexNode<T>* left = last_before(blockGoals[i], blockCards[i], id);
+        if (right != nullptr && right->m_goals == blockGoals[i] && right->m_cards == blockCards[i]) {
+            heads[numHeads] = right;
+            toRight[numHeads] = true;
+            goals[numHeads] = blockGoals[i];
+            cards[numHeads++] = blockCards[i];
+        }
+        if (left != nullptr && left->m_goals == blockGoals[i] && left->m_cards == blockCards[i]) {
+            heads[numHeads] = left;
+            toRight[numHeads] = false;
+            goals[numHeads] = blockGoals[i];
+            cards[numHeads++] = blockCards[i];
+        }
+    }
+    while (index < amount && numHeads > 0) {
+        //Take the head with the closest ID - on a tie, the bigger ID (the right side) is closer
+        int best = 0;
+        for (int i = 1; i < numHeads; i++) {
+            long long diffBest = (long long) heads[best]->m_id - id;
+            long long diff = (long long) heads[i]->m_id - id;
+            if (diffBest < 0) {
+                diffBest = -diffBest;
+            }
+            if (diff < 0) {
+                diff = -diff;
+            }
+            if (diff < diffBest || (diff == diffBest && toRight[i])) {
+                best = i;
+            }
+        }
+        array[index++] = heads[best]->m_id;
+        ComplexNode<T>* next;
+        if (toRight[best]) {
+            next = findRightClosest(heads[best]);
+        }
+        else {
+            next = findLeftClosest(heads[best]);
+        }
+        if (next != nullptr && next->m_goals == goals[best] && next->m_cards == cards[best]) {
+            heads[best] = next;
+        }
+        else {
+            //The block is exhausted on this side - replace it with the last head
+            numHeads--;
+            heads[best] = heads[numHeads];
+            toRight[best] = toRight[numHeads];
+            goals[best] = goals[numHeads];
+            cards[best] = cards[numHeads];
+        }
+    }
+    return index;
+}
+
 //----------------------------------------------------------------------------------------------
 
-#endif //AVLMULTIVARIABLE_H
\ No newline at end of file
+#endif //AVLMULTIVARIABLE_H
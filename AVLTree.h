@@ -5,12 +5,15 @@
 #include <memory>
 #include "Exception.h"
 #include "Node.h"
+#include "BalancePolicy.h"
+#include "ThreadPool.h"
 
 /*
 * Class Tree
-* This class is used to create a basic AVL tree sorted by a single key.
+* This class is used to create a basic balanced tree sorted by a single key.
+* The tree is balanced by the policy B (see BalancePolicy.h) - an AVL tree unless another policy is chosen.
 */
-template <class N, class T>
+template <class N, class T, class B = DefaultBalance>
 class Tree {
 public:
 
@@ -95,6 +98,34 @@ public:
      */
     virtual T& search_and_return_data(const int id) const;
 
+    /*
+     * Search for node with specific data, according to the id given, without throwing if it does not exist
+     * @param - The ID of the requested node
+     * @return - a pointer to the data the node holds, or nullptr if there is no such node
+     */
+    T* find_data(const int id) const;
+
+    /*
+     * Return the data of the node with the largest ID, without throwing if the tree is empty
+     * @param - none
+     * @return - a pointer to the data the node holds, or nullptr if the tree is empty
+     */
+    T* find_max_data() const;
+
+    /*
+     * Return the number of nodes in the tree
+     * @param - none
+     * @return - the number of nodes
+     */
+    int get_size() const;
+
+    /*
+     * Recalculate the subtree fields of a node and of all its ancestors, after the data of the node changed
+     * @param - The ID of the node whose data changed
+     * @return - none
+     */
+    void update_path(const int id);
+
     /*
     * Helper function for get_all_players in world_cup:
     * Add all of the tree keys to the given array
@@ -121,21 +152,92 @@ public:
 
     /*
      * Helper function for unite_teams in world_cup:
-     * Creates a tree from a given ordered array
-     * @param - a pointer to the array and its final index
+     * Creates a tree from a given ordered array - large subtrees are built in parallel by the pool, if one is given
+     * @param - a pointer to the array, its final index, and the pool
      * @return - void
      */
-    void insertInorder(T* data, const int end);
+    void insertInorder(T* data, const int end, ThreadPool* pool = nullptr);
+
+    /*
+     * Move all the nodes of the tree into a single block of memory, in the order of their keys, and rebuild the
+     * tree as a perfectly balanced tree. Nodes inserted later are allocated separately, and the block is freed once
+     * all of its nodes were removed. Only for trees of players, whose nodes can be rebuilt from their data.
+     * @param - none
+     * @return - void
+     */
+    void compact();
+
+    /*
+     * Set how far the heights of the two subtrees of a node may differ before the node is rotated, for AVLBalance.
+     * The default of 1 keeps the tree a strict AVL tree - larger values defer most rotations during bursts of
+     * inserts and removes, at the cost of a deeper tree until rebalance_all is called. Searches stay correct either
+     * way.
+     * @param - the allowed difference, at least 1
+     * @return - void
+     */
+    void set_relaxed(const int slack);
+
+    /*
+     * Restore the AVL balance of the whole tree after rotations were deferred, by relinking its nodes into a
+     * perfectly balanced tree - the nodes themselves are not moved or copied
+     * @param - none
+     * @return - void
+     */
+    void rebalance_all();
+
+    /*
+     * Check the links and the subtree fields of every node, that the keys increase from left to right, and that
+     * m_max is the last node - used by the tests after the tree changes
+     * @param - none
+     * @return - bool, true if the tree is consistent
+     */
+    bool is_consistent() const;
+
+    /*
+     * Check that every node keeps the balance of the policy B, with the current slack - used by the tests after the
+     * tree changes
+     * @param - none
+     * @return - bool, true if every node is balanced
+     */
+    bool is_balanced() const;
 
 protected:
 
+    /*
+     * Helper functions for is_consistent:
+     * is_consistent_subtree: checks the parent links, heights and sizes of a subtree.
+     * next_inorder: returns the node following the given node in the order of the tree, or nullptr for the last one.
+     */
+    bool is_consistent_subtree(const N* node) const;
+    static const N* next_inorder(const N* node);
+
+    /*
+     * Helper function for is_balanced:
+     * Checks the balance of every node of a subtree
+     * @param - the root of the subtree
+     * @return - bool, true if every node of the subtree is balanced
+     */
+    bool is_balanced_subtree(const N* node) const;
+
+    /*
+     * Free a node of the tree, whether it was allocated on its own or lies in the block made by compact
+     * @param - the node
+     * @return - void
+     */
+    void release_node(N* node);
+
     /*
      * Helper function for unite_teams in world_cup:
      * Recursively inserts the data from the array into a tree
-     * @param - a pointer to the array, its starting index, and its final index
+     * @param - a pointer to the array, its starting index, its final index, and the pool (or nullptr)
      * @return - a pointer to the root node at the end of the insertions
      */
-    N* insertInorderRecursive(T* data, const int start, const int end);
+    N* insertInorderRecursive(T* data, const int start, const int end, ThreadPool* pool = nullptr);
+
+    /*
+     * The number of nodes below which a subtree is built or walked by a single thread
+     */
+    static const int PARALLEL_GRAIN = 2048;
 
     /*
     * Make the node a leaf without breaking the sorted tree
@@ -144,8 +246,26 @@ protected:
     */
     N* make_node_leaf(N* node);
 
+    /*
+     * Helper function for the rebuilds of compact, insertInorder and rebalance_all:
+     * Rotates every node of a subtree, from the leaves up, until the policy B is satisfied - for the policies whose
+     * balance is not kept by a perfectly balanced tree (B::KEPT_BY_REBUILD is false)
+     * @param - the root of the subtree
+     * @return - void
+     */
+    void restore_policy(N* currentNode);
+
 private:
 
+    /*
+     * Helper function for rebalance_tree and restore_policy:
+     * Rotates the node down until the policy B chooses no rotation for it - a rotation moves the node one level down,
+     * where it may still be out of balance
+     * @param - the node
+     * @return - void
+     */
+    void rotate_until_balanced(N* currentNode);
+
     /*
      * Helper functions for update_closest:
      * Finds the right and left closest players
@@ -155,13 +275,83 @@ private:
     N* findLeftClosest(N* currentTeam);
     N* findRightClosest(N* currentTeam);
 
+    /*
+     * Read-only access to the nodes for the balancing policy B
+     * @param - a node
+     * @return - its left child, right child, balance factor, number of nodes in its subtree (0 for nullptr), and ID
+     */
+    static N* get_left(const N* node);
+    static N* get_right(const N* node);
+    static int get_bf(const N* node);
+    static int get_subtree_size(const N* node);
+    static int get_id(const N* node);
+
+    /*
+     * The balancing policy reads the nodes through the functions above
+     */
+    friend B;
+
+    /*
+     * Helper function for compact:
+     * Recursively builds the tree from the ordered array, placing the node of every index at the same index of
+     * the block
+     * @param - a pointer to the array, the block, the starting index, and the final index
+     * @return - a pointer to the root node of the built subtree
+     */
+    N* compactRecursive(T* data, N* block, const int start, const int end);
+
+    /*
+     * Find the node with the largest ID again, after it was removed or the tree was rebuilt
+     * @param - none
+     * @return - void
+     */
+    void update_max();
+
+    /*
+     * Helper functions for rebalance_all:
+     * collectInorder: adds the nodes of a subtree to the array in order, and returns the next free index.
+     * relinkRecursive: links the nodes of the array between the two indexes into a balanced subtree, and returns
+     *      its root.
+     */
+    int collectInorder(N* currentNode, N** nodes, int index);
+    N* relinkRecursive(N** nodes, const int start, const int end);
+
+    /*
+     * The block of nodes made by compact:
+     *   The first node of the block, the number of nodes it has room for, and the number of them still in the tree
+     */
+    N* m_block;
+    int m_blockCapacity;
+    int m_blockLive;
+
+    /*
+     * The node with the largest ID, so new IDs larger than all the others are appended without searching for their
+     * place - nullptr while the tree is empty, and always for MultiTree, which is not sorted by ID alone
+     */
+    N* m_max;
+
+    /*
+     * The balance settings of the tree:
+     *   The allowed difference between the heights of the subtrees of a node
+     *   Whether a node may have been left out of AVL balance since the tree was last balanced
+     */
+    int m_slack;
+    bool m_unbalanced;
+
 };
 
 
 //-------------------------------Constructor, Destructors, and Helpers--------------------------------------
 
-template <class N, class T>
-Tree<N, T>::Tree()
+template <class N, class T, class B>
+Tree<N, T, B>::Tree() :
+    m_node(nullptr),
+    m_block(nullptr),
+    m_blockCapacity(0),
+    m_blockLive(0),
+    m_max(nullptr),
+    m_slack(1),
+    m_unbalanced(false)
 {
     //Creating empty beginning node
     try {
@@ -174,15 +364,15 @@ Tree<N, T>::Tree()
 }
 
 
-template <class N, class T>
-Tree<N, T>::~Tree()
+template <class N, class T, class B>
+Tree<N, T, B>::~Tree()
 {
     destroy_tree(m_node);
 }
 
 
-template <class N, class T>
-void Tree<N, T>::destroy_tree(N* currentNode)
+template <class N, class T, class B>
+void Tree<N, T, B>::destroy_tree(N* currentNode)
 {
     if (currentNode != nullptr) {
         destroy_tree(currentNode->m_left);
@@ -196,14 +386,14 @@ void Tree<N, T>::destroy_tree(N* currentNode)
             }
             currentNode->m_parent = nullptr;
         }
-        delete currentNode;
+        release_node(currentNode);
     }
 }
 
 
 //Free tree's data recursively
-template <class N, class T>
-void Tree<N, T>::erase_data(N* currentNode)
+template <class N, class T, class B>
+void Tree<N, T, B>::erase_data(N* currentNode)
 {
     if (currentNode != nullptr) {
         erase_data(currentNode->m_left);
@@ -215,18 +405,25 @@ void Tree<N, T>::erase_data(N* currentNode)
 
 //----------------------------------Insert, Remove, and Rebalance---------------------------------
 
-template<class N, class T>
-void Tree<N, T>::insert(T data, const int id) {
+template <class N, class T, class B>
+void Tree<N, T, B>::insert(T data, const int id) {
     //If this is the first node in the tree:
     if (m_node->m_height == -1) {
         m_node->m_data = data;
         m_node->m_id = id;
         m_node->m_height++;
+        m_node->update_size();
+        m_max = m_node;
         return;
     }
-    //Find the proper location of the new node (when it's not the first):
+    //Find the proper location of the new node (when it's not the first) - an ID larger than all the others is the
+    //right child of the largest one, so only the right spine is walked and rebalanced
     N* x = m_node;
     N* y = nullptr;
+    if (m_max != nullptr && id > m_max->m_id) {
+        x = nullptr;
+        y = m_max;
+    }
     while (x != nullptr) {
         y = x;
         if (x->m_id == id) {
@@ -240,8 +437,8 @@ void Tree<N, T>::insert(T data, const int id) {
             x = x->m_right;
         }
     }
-    //Create the new node and add it to the tree:
-    N* node;
+    //Create the new node and add it to the tree - if it cannot be allocated, node stays nullptr for the catch below
+    N* node = nullptr;
     try {
         node = new N();
         node->m_parent = y;
@@ -250,11 +447,15 @@ void Tree<N, T>::insert(T data, const int id) {
         node->m_data = data;
         node->m_id = id;
         node->m_height = 0;
+        node->update_size();
         if (id < y->m_id) {
             y->m_left = node;
         }
         else {
             y->m_right = node;
+            if (y == m_max) {
+                m_max = node;
+            }
         }
         rebalance_tree((node->m_parent));
     }
@@ -266,84 +467,128 @@ void Tree<N, T>::insert(T data, const int id) {
 }
 
 
-template <class N, class T>
-void Tree<N, T>::remove(const int id)
+template <class N, class T, class B>
+void Tree<N, T, B>::remove(const int id)
 {
     if (m_node->m_id == id && m_node->m_right == nullptr && m_node->m_left == nullptr && m_node->m_parent == nullptr) {
         m_node->m_data = nullptr;
         m_node->m_height = -1;
         m_node->m_bf = 0;
         m_node->m_id = 0;
+        m_node->m_size = 0;
+        m_max = nullptr;
         return;
     }
     N* toRemove = &(search_specific_id(id));
+    bool removesMax = (toRemove == m_max);
     N* nodeToFix = make_node_leaf(toRemove);
-    delete toRemove;
+    release_node(toRemove);
     //Go up the tree and check the balance factors and complete needed rotations
     rebalance_tree(nodeToFix);
+    if (removesMax) {
+        update_max();
+    }
 }
 
 
-template <class N, class T>
-void Tree<N, T>::rebalance_tree(N* currentNode) {
+template <class N, class T, class B>
+void Tree<N, T, B>::rebalance_tree(N* currentNode) {
     if (currentNode == nullptr) {
         return;
     }
     currentNode->update_height();
     currentNode->update_bf();
-    if (currentNode->m_bf > 1 || currentNode->m_bf < -1) {
-        if (currentNode->m_bf == 2) {
-            if (currentNode->m_left->m_bf == -1) {
-                m_node = currentNode->lr_rotation(m_node);
-            }
-            else {
-                m_node = currentNode->ll_rotation(m_node);
-            }
+    currentNode->update_size();
+    if (m_slack > 1 && (currentNode->m_bf > 1 || currentNode->m_bf < -1)) {
+        //Rotations are deferred while the node is within the relaxed balance, and even a rotation may not bring the
+        //node back to AVL balance - the whole tree is balanced again by rebalance_all
+        m_unbalanced = true;
+    }
+    rotate_until_balanced(currentNode);
+    rebalance_tree(currentNode->m_parent);
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::rotate_until_balanced(N* currentNode) {
+    //A rotation moves the node one level down, where it may still be out of balance - as when the successor of a
+    //removed node sinks below its children in a treap - so it is rotated until its policy is satisfied
+    Rotation rotation = B::template choose_rotation<Tree<N, T, B>, N>(currentNode, m_slack);
+    while (rotation != Rotation::NONE) {
+        if (rotation == Rotation::LL) {
+            m_node = currentNode->ll_rotation(m_node);
         }
-        else if (currentNode->m_bf == -2) {
-            if (currentNode->m_right->m_bf == 1) {
-                m_node = currentNode->rl_rotation(m_node);
-            }
-            else {
-                m_node = currentNode->rr_rotation(m_node);
-            }
+        else if (rotation == Rotation::LR) {
+            m_node = currentNode->lr_rotation(m_node);
+        }
+        else if (rotation == Rotation::RR) {
+            m_node = currentNode->rr_rotation(m_node);
+        }
+        else {
+            m_node = currentNode->rl_rotation(m_node);
         }
         if (currentNode->m_parent != nullptr) {
             if (currentNode->m_parent->m_left != nullptr) {
                 currentNode->m_parent->m_left->update_height();
                 currentNode->m_parent->m_left->update_bf();
+                currentNode->m_parent->m_left->update_size();
             }
             if (currentNode->m_parent->m_right != nullptr) {
                 currentNode->m_parent->m_right->update_height();
                 currentNode->m_parent->m_right->update_bf();
+                currentNode->m_parent->m_right->update_size();
             }
         }
         else {
             if (currentNode->m_left != nullptr) {
                 currentNode->m_left->update_height();
                 currentNode->m_left->update_bf();
+                currentNode->m_left->update_size();
             }
             if (currentNode->m_right != nullptr) {
                 currentNode->m_right->update_height();
                 currentNode->m_right->update_bf();
+                currentNode->m_right->update_size();
             }
         }
+        rotation = B::template choose_rotation<Tree<N, T, B>, N>(currentNode, m_slack);
+    }
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::restore_policy(N* currentNode) {
+    if (currentNode == nullptr) {
+        return;
+    }
+    //The subtrees are fixed first, so the node only sinks through subtrees that already keep the policy
+    restore_policy(currentNode->m_left);
+    restore_policy(currentNode->m_right);
+    currentNode->update_height();
+    currentNode->update_bf();
+    currentNode->update_size();
+    N* parent = currentNode->m_parent;
+    rotate_until_balanced(currentNode);
+    //The nodes that rose above the node on its way down are updated from the bottom up
+    for (N* risen = currentNode->m_parent; risen != parent; risen = risen->m_parent) {
+        risen->update_height();
+        risen->update_bf();
+        risen->update_size();
     }
-    rebalance_tree(currentNode->m_parent);
 }
 
 
 //-----------------------------------------Search Functions-----------------------------------------
 
-template <class N, class T>
-N& Tree<N, T>::search_specific_id(const int id) const
+template <class N, class T, class B>
+N& Tree<N, T, B>::search_specific_id(const int id) const
 {
     return search_recursively(id, m_node);
 }
 
 
-template <class N, class T>
-N& Tree<N, T>::search_recursively(const int id, N* currentNode) const
+template <class N, class T, class B>
+N& Tree<N, T, B>::search_recursively(const int id, N* currentNode) const
 {
     if (currentNode == nullptr) {
         throw NodeNotFound();
@@ -358,8 +603,8 @@ N& Tree<N, T>::search_recursively(const int id, N* currentNode) const
 }
 
 
-template <class N, class T>
-T& Tree<N, T>::search_and_return_data(const int id) const
+template <class N, class T, class B>
+T& Tree<N, T, B>::search_and_return_data(const int id) const
 {
     N* tmpNode;
     try {
@@ -372,10 +617,141 @@ T& Tree<N, T>::search_and_return_data(const int id) const
 }
 
 
+template <class N, class T, class B>
+T* Tree<N, T, B>::find_data(const int id) const
+{
+    //A new ID larger than all the others is not in the tree
+    if (m_node->m_height == -1 || (m_max != nullptr && id > m_max->m_id)) {
+        return nullptr;
+    }
+    N* x = m_node;
+    while (x != nullptr) {
+        if (x->m_id == id) {
+            return &(x->m_data);
+        }
+        if (x->m_id < id) {
+            x = x->m_right;
+        }
+        else {
+            x = x->m_left;
+        }
+    }
+    return nullptr;
+}
+
+
+template <class N, class T, class B>
+T* Tree<N, T, B>::find_max_data() const
+{
+    if (m_max == nullptr) {
+        return nullptr;
+    }
+    return &(m_max->m_data);
+}
+
+
+template <class N, class T, class B>
+int Tree<N, T, B>::get_size() const
+{
+    return m_node->m_size;
+}
+
+
+template <class N, class T, class B>
+bool Tree<N, T, B>::is_consistent() const
+{
+    if (m_node->m_height == -1) {
+        return m_node->m_size == 0 && m_max == nullptr;
+    }
+    if (m_node->m_parent != nullptr || !is_consistent_subtree(m_node)) {
+        return false;
+    }
+    const N* node = m_node;
+    while (node->m_left != nullptr) {
+        node = node->m_left;
+    }
+    for (const N* next = next_inorder(node); next != nullptr; next = next_inorder(next)) {
+        if (next->m_id <= node->m_id) {
+            return false;
+        }
+        node = next;
+    }
+    return node == m_max;
+}
+
+
+template <class N, class T, class B>
+bool Tree<N, T, B>::is_consistent_subtree(const N* node) const
+{
+    int height = 0;
+    int size = 1;
+    const N* children[] = {node->m_left, node->m_right};
+    for (const N* child : children) {
+        if (child == nullptr) {
+            continue;
+        }
+        if (child->m_parent != node || !is_consistent_subtree(child)) {
+            return false;
+        }
+        if (child->m_height + 1 > height) {
+            height = child->m_height + 1;
+        }
+        size += child->m_size;
+    }
+    return node->m_height == height && node->m_size == size;
+}
+
+
+template <class N, class T, class B>
+bool Tree<N, T, B>::is_balanced() const
+{
+    return m_node->m_height == -1 || is_balanced_subtree(m_node);
+}
+
+
+template <class N, class T, class B>
+bool Tree<N, T, B>::is_balanced_subtree(const N* node) const
+{
+    if (node == nullptr) {
+        return true;
+    }
+    return B::template is_balanced<Tree<N, T, B>, N>(node, m_slack) && is_balanced_subtree(node->m_left) &&
+           is_balanced_subtree(node->m_right);
+}
+
+
+template <class N, class T, class B>
+const N* Tree<N, T, B>::next_inorder(const N* node)
+{
+    if (node->m_right != nullptr) {
+        node = node->m_right;
+        while (node->m_left != nullptr) {
+            node = node->m_left;
+        }
+        return node;
+    }
+    while (node->m_parent != nullptr && node->m_parent->m_right == node) {
+        node = node->m_parent;
+    }
+    return node->m_parent;
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::update_path(const int id)
+{
+    N* node = &(search_specific_id(id));
+    while (node != nullptr) {
+        node->update_size();
+        node = node->m_parent;
+    }
+}
+
+
 //-----------------------------------------Helper Functions for world_cup-----------------------------------------
 
-template <class N, class T>
-void Tree<N, T>::get_all_data(int* const array) const
+template <class N, class T, class B>
+void Tree<N, T, B>::get_all_data(int* const array) const
 {
     if (this != nullptr) {
         m_node->get_data_inorder(array, 0);
@@ -383,8 +759,8 @@ void Tree<N, T>::get_all_data(int* const array) const
 }
 
 
-template<class N, class T>
-void Tree<N, T>::update_closest(const int teamId)
+template <class N, class T, class B>
+void Tree<N, T, B>::update_closest(const int teamId)
 {
     //Search for specific node
     N* currentTeam = &(this->search_specific_id(teamId));
@@ -407,48 +783,236 @@ void Tree<N, T>::update_closest(const int teamId)
 }
 
 
-template<class N, class T>
-void Tree<N, T>::unite_update_games(const int numTeamGames) {
+template <class N, class T, class B>
+void Tree<N, T, B>::unite_update_games(const int numTeamGames) {
     m_node->update_games_inorder(numTeamGames);
 }
 
 
-template<class N, class T>
-void Tree<N, T>::insertInorder(T* data, const int end) {
+template <class N, class T, class B>
+void Tree<N, T, B>::insertInorder(T* data, const int end, ThreadPool* pool) {
     N* tmp = this->m_node;
-    m_node = insertInorderRecursive(data, 0, end);
-    delete tmp;
+    m_node = insertInorderRecursive(data, 0, end, pool);
+    release_node(tmp);
+    if (!B::KEPT_BY_REBUILD) {
+        restore_policy(m_node);
+    }
+    update_max();
+    m_unbalanced = false;
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::compact() {
+    int size = get_size();
+    if (size < 2) {
+        return;
+    }
+    T* data = new T[size];
+    N* block;
+    try {
+        block = static_cast<N*>(::operator new(sizeof(N) * size));
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] data;
+        throw e;
+    }
+    m_node->unite_insert(data, 0);
+    N* root = compactRecursive(data, block, 0, size - 1);
+    delete[] data;
+    //Free the previous nodes - the previous block is freed together with its last node
+    destroy_tree(m_node);
+    m_node = root;
+    m_block = block;
+    m_blockCapacity = size;
+    m_blockLive = size;
+    if (!B::KEPT_BY_REBUILD) {
+        restore_policy(m_node);
+    }
+    if (m_max != nullptr) {
+        update_max();
+    }
+    m_unbalanced = false;
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::set_relaxed(const int slack) {
+    m_slack = (slack < 1) ? 1 : slack;
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::rebalance_all() {
+    int size = get_size();
+    if (!m_unbalanced || size < 2) {
+        m_unbalanced = false;
+        return;
+    }
+    N** nodes = new N*[size];
+    collectInorder(m_node, nodes, 0);
+    m_node = relinkRecursive(nodes, 0, size - 1);
+    m_node->m_parent = nullptr;
+    delete[] nodes;
+    if (!B::KEPT_BY_REBUILD) {
+        restore_policy(m_node);
+    }
+    m_unbalanced = false;
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::release_node(N* node) {
+    if (m_block != nullptr && node >= m_block && node < m_block + m_blockCapacity) {
+        node->~N();
+        m_blockLive--;
+        if (m_blockLive == 0) {
+            ::operator delete(m_block);
+            m_block = nullptr;
+            m_blockCapacity = 0;
+        }
+        return;
+    }
+    delete node;
 }
 
 
 //-----------------------------------------Internal Helper Functions-----------------------------------------
 
-template<class N, class T>
-N* Tree<N, T>::insertInorderRecursive(T* data, const int start, const int end) {
+template <class N, class T, class B>
+N* Tree<N, T, B>::compactRecursive(T* data, N* block, const int start, const int end) {
+    if (start > end) {
+        return nullptr;
+    }
+    int mid = (start + end)/2;
+    N* root = new (block + mid) N(data[mid]);
+    root->m_left = compactRecursive(data, block, start, mid-1);
+    if (root->m_left != nullptr) {
+        root->m_left->m_parent = root;
+    }
+    root->m_right = compactRecursive(data, block, mid+1, end);
+    if (root->m_right != nullptr) {
+        root->m_right->m_parent = root;
+    }
+    root->update_bf();
+    root->update_height();
+    root->update_size();
+    return root;
+}
+
+
+template <class N, class T, class B>
+int Tree<N, T, B>::collectInorder(N* currentNode, N** nodes, int index) {
+    if (currentNode == nullptr) {
+        return index;
+    }
+    index = collectInorder(currentNode->m_left, nodes, index);
+    nodes[index++] = currentNode;
+    return collectInorder(currentNode->m_right, nodes, index);
+}
+
+
+template <class N, class T, class B>
+N* Tree<N, T, B>::relinkRecursive(N** nodes, const int start, const int end) {
+    if (start > end) {
+        return nullptr;
+    }
+    int mid = (start + end)/2;
+    N* root = nodes[mid];
+    root->m_left = relinkRecursive(nodes, start, mid-1);
+    if (root->m_left != nullptr) {
+        root->m_left->m_parent = root;
+    }
+    root->m_right = relinkRecursive(nodes, mid+1, end);
+    if (root->m_right != nullptr) {
+        root->m_right->m_parent = root;
+    }
+    root->update_bf();
+    root->update_height();
+    root->update_size();
+    return root;
+}
+
+
+template <class N, class T, class B>
+N* Tree<N, T, B>::get_left(const N* node) {
+    return node->m_left;
+}
+
+
+template <class N, class T, class B>
+N* Tree<N, T, B>::get_right(const N* node) {
+    return node->m_right;
+}
+
+
+template <class N, class T, class B>
+int Tree<N, T, B>::get_bf(const N* node) {
+    return node->m_bf;
+}
+
+
+template <class N, class T, class B>
+int Tree<N, T, B>::get_subtree_size(const N* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    return node->m_size;
+}
+
+
+template <class N, class T, class B>
+int Tree<N, T, B>::get_id(const N* node) {
+    return node->m_id;
+}
+
+
+template <class N, class T, class B>
+void Tree<N, T, B>::update_max() {
+    if (m_node->m_height == -1) {
+        m_max = nullptr;
+        return;
+    }
+    m_max = m_node;
+    while (m_max->m_right != nullptr) {
+        m_max = m_max->m_right;
+    }
+}
+
+
+template <class N, class T, class B>
+N* Tree<N, T, B>::insertInorderRecursive(T* data, const int start, const int end, ThreadPool* pool) {
     //Stop recursion
     if (start > end)
         return nullptr;
     //Get the middle player and make root
     int mid = (start + end)/2;
     N* root = new N(data[mid]);
-    //Construct left subtree
-    root->m_left =  insertInorderRecursive(data, start, mid-1);
+    if (pool != nullptr && end - start >= PARALLEL_GRAIN) {
+        //The subtrees share no nodes, so they are built at the same time
+        pool->parallel_invoke([&]() { root->m_left = insertInorderRecursive(data, start, mid-1, pool); },
+                              [&]() { root->m_right = insertInorderRecursive(data, mid+1, end, pool); });
+    }
+    else {
+        root->m_left = insertInorderRecursive(data, start, mid-1);
+        root->m_right = insertInorderRecursive(data, mid+1, end);
+    }
+    //Link the subtrees
     if (root->m_left != nullptr) {
         root->m_left->m_parent = root;
     }
-    //Construct right subtree
-    root->m_right = insertInorderRecursive(data, mid+1, end);
     if (root->m_right != nullptr) {
         root->m_right->m_parent = root;
     }
     root->update_bf();
     root->update_height();
+    root->update_size();
     return root;
 }
 
 
-template <class N, class T>
-N* Tree<N, T>::make_node_leaf(N* node)
+template <class N, class T, class B>
+N* Tree<N, T, B>::make_node_leaf(N* node)
 {
     //Node to be deleted is already a leaf
     if (node->m_left == nullptr && node->m_right == nullptr) {
@@ -543,8 +1107,8 @@ N* Tree<N, T>::make_node_leaf(N* node)
 }
 
 
-template<class N, class T>
-N* Tree<N, T>::findLeftClosest(N* currentTeam)
+template <class N, class T, class B>
+N* Tree<N, T, B>::findLeftClosest(N* currentTeam)
 {
     N* closestLeft = currentTeam;
     if (currentTeam->m_left != nullptr) {
@@ -574,8 +1138,8 @@ N* Tree<N, T>::findLeftClosest(N* currentTeam)
 }
 
 
-template<class N, class T>
-N* Tree<N, T>::findRightClosest(N* currentTeam)
+template <class N, class T, class B>
+N* Tree<N, T, B>::findRightClosest(N* currentTeam)
 {
     N* closestRight = currentTeam;
     if (currentTeam->m_right != nullptr) {
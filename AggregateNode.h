@@ -0,0 +1,365 @@
+#ifndef WORLD_CUP_SYSTEM_AGGREGATENODE_H
+#define WORLD_CUP_SYSTEM_AGGREGATENODE_H
+#include "Node.h"
+#include "Teams.h"
+#include "TeamSummary.h"
+
+/*
+* Class Tree : Aggregate Node
+* This class is used to create the separate nodes in a basic AVL tree of teams, where every node also holds the
+* summary of the stats of all the teams in its subtree.
+*/
+template <class T>
+class AggregateNode : Node<T> {
+public:
+
+    /*
+    * Constructor of AggregateNode class
+    * @param - none
+    * @return - A new instance of AggregateNode
+    */
+    AggregateNode();
+
+    /*
+    * Copy Constructor and Assignment Operator of AggregateNode class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    AggregateNode(const AggregateNode&) = delete;
+    AggregateNode& operator=(const AggregateNode& other) = delete;
+
+    /*
+    * Destructor of AggregateNode class
+    * @param - none
+    * @return - void
+    */
+    ~AggregateNode() = default;
+
+    /*
+     * Helper function for get_teams_summary in world_cup:
+     * Summarizes the stats of all the teams within a given range of ID's
+     * @param - The minimum and maximum team ID's
+     * @return - the summary of the teams found
+     */
+    TeamSummary summarize_range(const int minTeamId, const int maxTeamId);
+
+    /*
+    * Returns the height of a node
+    * @param - none
+    * @return - height
+    */
+    int get_height() const;
+
+private:
+
+    /*
+     * Left-Right Rotation
+     * @param - Node with balance factor of +2
+     * @return - pointer to AggregateNode
+     */
+    AggregateNode* ll_rotation(AggregateNode* node);
+
+    /*
+     * Right-Right Rotation
+     * @param - Node with balance factor of -2
+     * @return - pointer to AggregateNode
+     */
+    AggregateNode* rr_rotation(AggregateNode* node);
+
+    /*
+     * Right-Left Rotation
+     * @param - Node with balance factor of -2
+     * @return - pointer to AggregateNode
+    */
+    AggregateNode* rl_rotation(AggregateNode* node);
+
+    /*
+     * Left-Left Rotation
+     * @param - Node with balance factor of +2
+     * @return - pointer to AggregateNode
+    */
+    AggregateNode* lr_rotation(AggregateNode* node);
+
+    /*
+     * Update balance factor of the current node
+     * @param - none
+     * @return - void
+    */
+    void update_bf();
+
+    /*
+     * Update height of the current node
+     * @param - none
+     * @return - void
+    */
+    void update_height();
+
+    /*
+     * Update the number of nodes in the subtree of the current node, together with the summary of their stats
+     * @param - none
+     * @return - void
+    */
+    void update_size();
+
+    /*
+     * Helper functions for summarize_range:
+     * Summarize the teams of the subtree with an ID of at least minTeamId / at most maxTeamId
+     * @param - The minimum / maximum team ID
+     * @return - the summary of the teams found
+     */
+    TeamSummary summarize_from(const int minTeamId);
+    TeamSummary summarize_to(const int maxTeamId);
+
+    /*
+     * The internal fields of AggregateNode:
+     *   Pointers to the parent node and two child nodes
+     *   The summary of the stats of the teams in the subtree of the node
+     */
+    AggregateNode* m_parent;
+    AggregateNode* m_left;
+    AggregateNode* m_right;
+    TeamSummary m_summary;
+
+    /*
+     * The following class is a friend class in order to allow full access to private fields and functions of
+     * AggregateNode, allowing AggregateNode to be a mostly private class, while allowing the system to run smoothly.
+    */
+    template <class N, class M, class B>
+    friend class Tree;
+
+};
+
+//--------------------------------------------Constructor---------------------------------------------------
+
+template <class T>
+AggregateNode<T>::AggregateNode() :
+        Node<T>(),
+        m_parent(nullptr),
+        m_left(nullptr),
+        m_right(nullptr),
+        m_summary()
+{}
+
+
+//--------------------------------Public Helper Functions for world_cup--------------------------------------------
+
+template <class T>
+TeamSummary AggregateNode<T>::summarize_range(const int minTeamId, const int maxTeamId) {
+    TeamSummary summary;
+    if (this->m_height == -1) {
+        return summary;
+    }
+    //Find the highest node within the range - the rest of the range is split between its two subtrees
+    AggregateNode<T>* split = this;
+    while (split != nullptr && (split->m_id < minTeamId || split->m_id > maxTeamId)) {
+        if (split->m_id < minTeamId) {
+            split = split->m_right;
+        }
+        else {
+            split = split->m_left;
+        }
+    }
+    if (split == nullptr) {
+        return summary;
+    }
+    summary = TeamSummary(split->m_data);
+    if (split->m_left != nullptr) {
+        summary.combine(split->m_left->summarize_from(minTeamId));
+    }
+    if (split->m_right != nullptr) {
+        summary.combine(split->m_right->summarize_to(maxTeamId));
+    }
+    return summary;
+}
+
+
+template<class T>
+int AggregateNode<T>::get_height() const {
+    return this->m_height;
+}
+
+
+//--------------------------------------------Rotations---------------------------------------------------
+
+//Left-Left tree rotation, on the node with balance factor of +2
+template <class T>
+typename AggregateNode<T>::AggregateNode* AggregateNode<T>::ll_rotation(AggregateNode<T>* node)
+{
+    AggregateNode<T>* tmpToReturn = node;
+    //Changing A->B to A->Parent
+    m_left->m_parent = m_parent;
+    //Changing Parent->B to Parent->A
+    if (m_parent != nullptr) {
+        if (m_parent->m_left == this) {
+            m_parent->m_left = m_left;
+        }
+        else {
+            m_parent->m_right = m_left;
+        }
+    }
+    else {
+        tmpToReturn = m_left;
+    }
+    //Changing B->Parent to B->A
+    m_parent = m_left;
+    //Changing Ar->A to Ar->B
+    if (m_left->m_right != nullptr) {
+        m_left->m_right->m_parent = this;
+    }
+    //Changing B->A to B->Ar
+    m_left = m_left->m_right;
+    //Changing A->Ar to A->B
+    m_parent->m_right = this;
+    return tmpToReturn;
+}
+
+
+//Right-Right tree rotation, on the node with balance factor of -2
+template <class T>
+typename AggregateNode<T>::AggregateNode* AggregateNode<T>::rr_rotation(AggregateNode<T>* node)
+{
+    AggregateNode<T>* tmpToReturn = node;
+    m_right->m_parent = m_parent;
+    if (m_parent != nullptr) {
+        if (m_parent->m_right == this) {
+            m_parent->m_right = m_right;
+        }
+        else {
+            m_parent->m_left = m_right;
+        }
+    }
+    else {
+        tmpToReturn = m_right;
+    }
+    m_parent = m_right;
+    if(m_right->m_left != nullptr) {
+        m_right->m_left->m_parent = this;
+    }
+    m_right = m_right->m_left;
+    m_parent->m_left = this;
+    return tmpToReturn;
+}
+
+
+//Right-Left tree rotation, on the node with balance factor of -2
+template <class T>
+typename AggregateNode<T>::AggregateNode* AggregateNode<T>::rl_rotation(AggregateNode<T>* node)
+{
+    AggregateNode<T>* tmp = m_right->ll_rotation(node);
+    tmp = rr_rotation(tmp);
+    return tmp;
+}
+
+
+//Left-Right tree rotation, on the node with balance factor of +2
+template <class T>
+typename AggregateNode<T>::AggregateNode* AggregateNode<T>::lr_rotation(AggregateNode<T>* node)
+{
+    AggregateNode<T>* tmp = m_left->rr_rotation(node);
+    tmp = ll_rotation(tmp);
+    return tmp;
+}
+
+
+//----------------------------------------------Node Stats---------------------------------------------------
+
+//Update the balance factor of the specific node
+template <class T>
+void AggregateNode<T>::update_bf()
+{
+    int heightLeft = 0, heightRight = 0;
+    if (m_left != nullptr) {
+        heightLeft = m_left->m_height + 1;
+    }
+    if (m_right != nullptr) {
+        heightRight = m_right->m_height + 1;
+    }
+    this->m_bf = heightLeft - heightRight;
+}
+
+
+//Update the subtree height of the specific node
+template <class T>
+void AggregateNode<T>::update_height()
+{
+    int heightLeft = 0, heightRight = 0;
+    if (m_left != nullptr) {
+        heightLeft = m_left->m_height + 1;
+    }
+    if (m_right != nullptr) {
+        heightRight = m_right->m_height + 1;
+    }
+    if (heightLeft >= heightRight) {
+        this->m_height = heightLeft;
+    }
+    else {
+        this->m_height = heightRight;
+    }
+}
+
+
+//Update the number of nodes in the subtree of the specific node and the summary of their stats
+template <class T>
+void AggregateNode<T>::update_size()
+{
+    int sizeLeft = 0, sizeRight = 0;
+    m_summary = TeamSummary(this->m_data);
+    if (m_left != nullptr) {
+        sizeLeft = m_left->m_size;
+        m_summary.combine(m_left->m_summary);
+    }
+    if (m_right != nullptr) {
+        sizeRight = m_right->m_size;
+        m_summary.combine(m_right->m_summary);
+    }
+    this->m_size = sizeLeft + sizeRight + 1;
+}
+
+
+//---------------------------------Private Helper Functions for world_cup---------------------------------------------
+
+template <class T>
+TeamSummary AggregateNode<T>::summarize_from(const int minTeamId) {
+    TeamSummary summary;
+    AggregateNode<T>* x = this;
+    while (x != nullptr) {
+        if (x->m_id >= minTeamId) {
+            //x and its whole right subtree are in the range
+            summary.combine(TeamSummary(x->m_data));
+            if (x->m_right != nullptr) {
+                summary.combine(x->m_right->m_summary);
+            }
+            x = x->m_left;
+        }
+        else {
+            x = x->m_right;
+        }
+    }
+    return summary;
+}
+
+
+template <class T>
+TeamSummary AggregateNode<T>::summarize_to(const int maxTeamId) {
+    TeamSummary summary;
+    AggregateNode<T>* x = this;
+    while (x != nullptr) {
+        if (x->m_id <= maxTeamId) {
+            //x and its whole left subtree are in the range
+            summary.combine(TeamSummary(x->m_data));
+            if (x->m_left != nullptr) {
+                summary.combine(x->m_left->m_summary);
+            }
+            x = x->m_right;
+        }
+        else {
+            x = x->m_left;
+        }
+    }
+    return summary;
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+
+#endif //WORLD_CUP_SYSTEM_AGGREGATENODE_H
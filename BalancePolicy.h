@@ -0,0 +1,195 @@
+#ifndef WORLD_CUP_SYSTEM_BALANCEPOLICY_H
+#define WORLD_CUP_SYSTEM_BALANCEPOLICY_H
+
+/*
+* The rotation a balancing policy chooses for a node of a tree, named after the rotation functions of the nodes:
+*   LL - the left child takes the place of the node, RR - the right child takes the place of the node,
+*   LR / RL - the inner grandchild on the left / right takes the place of the node (double rotations)
+*/
+enum struct Rotation {
+    NONE = 0,
+    LL   = 1,
+    RR   = 2,
+    LR   = 3,
+    RL   = 4,
+};
+
+/*
+* Balancing policies of Tree and MultiTree
+* After every insert and remove, Tree walks from the changed node up to the root, updating the height, balance factor
+* and size of every node on the way. At each of these nodes it asks its policy which rotation, if any, should be made.
+* A policy reads the nodes only through the static functions of the tree: get_left, get_right, get_bf,
+* get_subtree_size (0 for nullptr) and get_id. Its is_balanced function checks the balance it keeps at a single node,
+* for Tree::is_balanced. KEPT_BY_REBUILD tells whether the perfectly balanced trees built by compact, insertInorder
+* and rebalance_all already keep its balance - if not, the tree rotates every rebuilt node until its policy is
+* satisfied.
+*/
+
+/*
+* Policy AVLBalance
+* Keeps the heights of the two subtrees of every node within slack of each other - a strict AVL tree for the default
+* slack of 1.
+*/
+struct AVLBalance {
+    template <class Tree, class N>
+    static Rotation choose_rotation(const N* node, const int slack);
+
+    template <class Tree, class N>
+    static bool is_balanced(const N* node, const int slack);
+
+    static const bool KEPT_BY_REBUILD = true;
+};
+
+/*
+* Policy TreapBalance
+* Keeps the nodes in heap order of a priority hashed from their ID, so the shape of the tree is that of a random
+* binary search tree, whatever the order of the inserts. Nodes rise above a parent with a lower priority, one
+* rotation at a time.
+*/
+struct TreapBalance {
+    template <class Tree, class N>
+    static Rotation choose_rotation(const N* node, const int slack);
+
+    template <class Tree, class N>
+    static bool is_balanced(const N* node, const int slack);
+
+    static const bool KEPT_BY_REBUILD = false;
+
+    /*
+    * Return the priority of an ID
+    * @param - the ID
+    * @return - the priority
+    */
+    static unsigned int priority(const int id);
+};
+
+/*
+* Policy WeightBalance
+* Keeps the number of nodes in the two subtrees of every node within a factor of DELTA of each other, using the
+* sizes the tree already holds for its rank queries. A single rotation is made when the outer grandchild is heavy
+* enough (by the factor GAMMA), and a double rotation otherwise.
+*/
+struct WeightBalance {
+    template <class Tree, class N>
+    static Rotation choose_rotation(const N* node, const int slack);
+
+    template <class Tree, class N>
+    static bool is_balanced(const N* node, const int slack);
+
+    static const bool KEPT_BY_REBUILD = true;
+
+    static const int DELTA = 3;
+    static const int GAMMA = 2;
+};
+
+/*
+* The policy used by trees that do not choose one - every tree of world_cup, unless the build sets another one with
+* -DWC_BALANCE=<policy>, as bench/build.sh does for bench/policy_stream.cpp
+*/
+#ifndef WC_BALANCE
+#define WC_BALANCE AVLBalance
+#endif
+typedef WC_BALANCE DefaultBalance;
+
+//--------------------------------------------------AVLBalance------------------------------------------------------
+
+template <class Tree, class N>
+Rotation AVLBalance::choose_rotation(const N* node, const int slack)
+{
+    int bf = Tree::get_bf(node);
+    if (bf > slack) {
+        return (Tree::get_bf(Tree::get_left(node)) < 0) ? Rotation::LR : Rotation::LL;
+    }
+    if (bf < -slack) {
+        return (Tree::get_bf(Tree::get_right(node)) > 0) ? Rotation::RL : Rotation::RR;
+    }
+    return Rotation::NONE;
+}
+
+
+template <class Tree, class N>
+bool AVLBalance::is_balanced(const N* node, const int slack)
+{
+    int bf = Tree::get_bf(node);
+    return bf <= slack && bf >= -slack;
+}
+
+
+//-------------------------------------------------TreapBalance-----------------------------------------------------
+
+template <class Tree, class N>
+Rotation TreapBalance::choose_rotation(const N* node, const int slack)
+{
+    unsigned int highest = priority(Tree::get_id(node));
+    Rotation rotation = Rotation::NONE;
+    const N* left = Tree::get_left(node);
+    const N* right = Tree::get_right(node);
+    if (left != nullptr && priority(Tree::get_id(left)) > highest) {
+        highest = priority(Tree::get_id(left));
+        rotation = Rotation::LL;
+    }
+    if (right != nullptr && priority(Tree::get_id(right)) > highest) {
+        rotation = Rotation::RR;
+    }
+    return rotation;
+}
+
+
+template <class Tree, class N>
+bool TreapBalance::is_balanced(const N* node, const int slack)
+{
+    unsigned int nodePriority = priority(Tree::get_id(node));
+    const N* left = Tree::get_left(node);
+    const N* right = Tree::get_right(node);
+    return (left == nullptr || priority(Tree::get_id(left)) <= nodePriority) &&
+           (right == nullptr || priority(Tree::get_id(right)) <= nodePriority);
+}
+
+
+inline unsigned int TreapBalance::priority(const int id)
+{
+    unsigned int x = (unsigned int) id;
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+
+//-------------------------------------------------WeightBalance----------------------------------------------------
+
+template <class Tree, class N>
+Rotation WeightBalance::choose_rotation(const N* node, const int slack)
+{
+    const N* left = Tree::get_left(node);
+    const N* right = Tree::get_right(node);
+    int leftWeight = Tree::get_subtree_size(left) + 1;
+    int rightWeight = Tree::get_subtree_size(right) + 1;
+    if (rightWeight > DELTA * leftWeight) {
+        int innerWeight = Tree::get_subtree_size(Tree::get_left(right)) + 1;
+        int outerWeight = Tree::get_subtree_size(Tree::get_right(right)) + 1;
+        return (innerWeight < GAMMA * outerWeight) ? Rotation::RR : Rotation::RL;
+    }
+    if (leftWeight > DELTA * rightWeight) {
+        int innerWeight = Tree::get_subtree_size(Tree::get_right(left)) + 1;
+        int outerWeight = Tree::get_subtree_size(Tree::get_left(left)) + 1;
+        return (innerWeight < GAMMA * outerWeight) ? Rotation::LL : Rotation::LR;
+    }
+    return Rotation::NONE;
+}
+
+
+template <class Tree, class N>
+bool WeightBalance::is_balanced(const N* node, const int slack)
+{
+    int leftWeight = Tree::get_subtree_size(Tree::get_left(node)) + 1;
+    int rightWeight = Tree::get_subtree_size(Tree::get_right(node)) + 1;
+    return leftWeight <= DELTA * rightWeight && rightWeight <= DELTA * leftWeight;
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+
+#endif //WORLD_CUP_SYSTEM_BALANCEPOLICY_H
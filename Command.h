@@ -0,0 +1,50 @@
+#ifndef WORLD_CUP_SYSTEM_COMMAND_H
+#define WORLD_CUP_SYSTEM_COMMAND_H
+
+#include "wet1util.h"
+
+/*
+* The operations of world_cup that can be sent in a batch, one for each public function of the exercise
+*/
+enum struct CommandType {
+    ADD_TEAM              = 0,
+    REMOVE_TEAM           = 1,
+    ADD_PLAYER            = 2,
+    REMOVE_PLAYER         = 3,
+    UPDATE_PLAYER_STATS   = 4,
+    PLAY_MATCH            = 5,
+    GET_NUM_PLAYED_GAMES  = 6,
+    GET_TEAM_POINTS       = 7,
+    UNITE_TEAMS           = 8,
+    GET_TOP_SCORER        = 9,
+    GET_ALL_PLAYERS_COUNT = 10,
+    GET_ALL_PLAYERS       = 11,
+    GET_CLOSEST_PLAYER    = 12,
+    KNOCKOUT_WINNER       = 13,
+};
+
+/*
+* A single operation of a batch:
+*   The type of the operation
+*   Its integer arguments, in the order of the parameters of the matching world_cup function
+*   The goalKeeper argument of ADD_PLAYER
+*   The output array of GET_ALL_PLAYERS
+*/
+struct Command {
+    CommandType m_type;
+    int m_args[5];
+    bool m_flag;
+    int* m_output;
+};
+
+/*
+* The result of a single operation of a batch:
+*   The status the matching world_cup function returned
+*   The answer, for the functions that return output_t<int> (0 for the rest)
+*/
+struct Result {
+    StatusType m_status;
+    int m_value;
+};
+
+#endif //WORLD_CUP_SYSTEM_COMMAND_H
@@ -0,0 +1,184 @@
+#include "CommandLog.h"
+#include <cstring>
+
+static const char LOG_HEADER[] = {'W', 'C', 'L', '1'};
+static const int LOG_BUFFER = 1 << 16;
+static const unsigned char OPCODE_MASK = 0x0F;
+static const unsigned char GOALKEEPER_BIT = 0x10;
+static const unsigned char OPCODE_BAD_FORMAT = 14;
+static const unsigned char OPCODE_UNKNOWN = 15;
+
+//The number of integer arguments of every command, in the order of CommandType
+static const int NUM_ARGS[] = {2, 1, 5, 1, 4, 2, 1, 1, 3, 1, 1, 1, 2, 2};
+
+//Zigzag encoding maps small negative values to small unsigned values: 0, -1, 1, -2... become 0, 1, 2, 3...
+static unsigned int zigzag(const int value)
+{
+    return (static_cast<unsigned int>(value) << 1) ^ (value < 0 ? ~0u : 0u);
+}
+
+static int unzigzag(const unsigned int value)
+{
+    return static_cast<int>((value >> 1) ^ (0u - (value & 1)));
+}
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+CommandLogWriter::CommandLogWriter(std::ostream& out) :
+    m_out(out),
+    m_buffer(new char[LOG_BUFFER]),
+    m_length(0)
+{
+    memcpy(m_buffer, LOG_HEADER, sizeof(LOG_HEADER));
+    m_length = sizeof(LOG_HEADER);
+}
+
+
+CommandLogWriter::~CommandLogWriter()
+{
+    flush();
+    delete[] m_buffer;
+}
+
+
+CommandLogReader::CommandLogReader(const char* data, const size_t size) :
+    m_pos(reinterpret_cast<const unsigned char*>(data)),
+    m_end(reinterpret_cast<const unsigned char*>(data) + size),
+    m_last(LogRecord::COMMAND)
+{
+    if (size < sizeof(LOG_HEADER) || memcmp(data, LOG_HEADER, sizeof(LOG_HEADER)) != 0) {
+        m_last = LogRecord::CORRUPT;
+        return;
+    }
+    m_pos += sizeof(LOG_HEADER);
+}
+
+
+//---------------------------------------------------Writing--------------------------------------------------------
+
+void CommandLogWriter::write_command(const Command& command)
+{
+    int opcode = static_cast<int>(command.m_type);
+    bool goalKeeper = (command.m_type == CommandType::ADD_PLAYER && command.m_flag);
+    write_byte(opcode | (goalKeeper ? GOALKEEPER_BIT : 0));
+    for (int i = 0; i < NUM_ARGS[opcode]; i++) {
+        write_varint(zigzag(command.m_args[i]));
+    }
+}
+
+
+void CommandLogWriter::write_bad_format()
+{
+    write_byte(OPCODE_BAD_FORMAT);
+}
+
+
+void CommandLogWriter::write_unknown(const std::string& name)
+{
+    write_byte(OPCODE_UNKNOWN);
+    write_varint(name.size());
+    for (size_t i = 0; i < name.size(); i++) {
+        write_byte(name[i]);
+    }
+}
+
+
+void CommandLogWriter::flush()
+{
+    m_out.write(m_buffer, m_length);
+    m_out.flush();
+    m_length = 0;
+}
+
+
+//---------------------------------------------------Reading--------------------------------------------------------
+
+LogRecord CommandLogReader::next(Command& command, std::string& unknown)
+{
+    if (m_last != LogRecord::COMMAND) {
+        return m_last;
+    }
+    if (m_pos == m_end) {
+        m_last = LogRecord::END;
+        return m_last;
+    }
+    unsigned char first = *m_pos++;
+    int opcode = first & OPCODE_MASK;
+    int flags = first & ~OPCODE_MASK;
+    //Only ADD_PLAYER may have the goalKeeper bit, and no record uses the bits above it
+    bool addPlayer = (opcode == static_cast<int>(CommandType::ADD_PLAYER));
+    if (flags != 0 && !(addPlayer && flags == GOALKEEPER_BIT)) {
+        m_last = LogRecord::CORRUPT;
+        return m_last;
+    }
+    if (opcode == OPCODE_BAD_FORMAT) {
+        m_last = LogRecord::BAD_FORMAT;
+        return m_last;
+    }
+    if (opcode == OPCODE_UNKNOWN) {
+        unsigned int length;
+        if (!read_varint(length) || length > static_cast<size_t>(m_end - m_pos)) {
+            m_last = LogRecord::CORRUPT;
+            return m_last;
+        }
+        unknown.assign(reinterpret_cast<const char*>(m_pos), length);
+        m_pos += length;
+        m_last = LogRecord::UNKNOWN;
+        return m_last;
+    }
+    command.m_type = static_cast<CommandType>(opcode);
+    for (int i = 0; i < NUM_ARGS[opcode]; i++) {
+        unsigned int value;
+        if (!read_varint(value)) {
+            m_last = LogRecord::CORRUPT;
+            return m_last;
+        }
+        command.m_args[i] = unzigzag(value);
+    }
+    command.m_flag = (first & GOALKEEPER_BIT) != 0;
+    command.m_output = nullptr;
+    return LogRecord::COMMAND;
+}
+
+
+//------------------------------------------------Helper Functions-------------------------------------------------
+
+void CommandLogWriter::write_byte(const unsigned char byte)
+{
+    if (m_length == LOG_BUFFER) {
+        m_out.write(m_buffer, m_length);
+        m_length = 0;
+    }
+    m_buffer[m_length++] = byte;
+}
+
+
+void CommandLogWriter::write_varint(unsigned int value)
+{
+    while (value >= 0x80) {
+        write_byte((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    write_byte(value);
+}
+
+
+bool CommandLogReader::read_varint(unsigned int& value)
+{
+    value = 0;
+    //A 32 bit value takes at most 5 bytes, the last of them holding only its top 4 bits
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (m_pos == m_end) {
+            return false;
+        }
+        unsigned char byte = *m_pos++;
+        if (shift == 28 && byte > 0x0F) {
+            return false;
+        }
+        value |= static_cast<unsigned int>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,151 @@
+#ifndef WORLD_CUP_SYSTEM_COMMANDLOG_H
+#define WORLD_CUP_SYSTEM_COMMANDLOG_H
+
+#include "Command.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/*
+* The binary form of a command log, as a compact replacement for the text commands of the driver.
+* A log starts with the 4 bytes "WCL1", followed by records. Every record starts with a byte holding the opcode in its
+* low 4 bits, and the goalKeeper argument of ADD_PLAYER in bit 4.
+* Opcodes 0 - 13 are the commands of Command.h, followed by their integer arguments (as many as the matching world_cup
+* function takes), each as a zigzag varint - 7 bits per byte, least significant first, with the high bit set on every
+* byte but the last.
+* The text input may also end with a bad argument or an unknown command, so two more opcodes keep the log faithful:
+* BAD_FORMAT (14) ends the log with "Invalid input format", and UNKNOWN (15) is followed by the length of the name as
+* a varint and the name itself.
+*/
+
+/*
+* What a record of the log holds - a command, one of the records that end the log, the end of the log itself, or
+* bytes that are not a valid record
+*/
+enum struct LogRecord {
+    COMMAND,
+    BAD_FORMAT,
+    UNKNOWN,
+    END,
+    CORRUPT
+};
+
+/*
+* Class CommandLogWriter
+* This class is used to encode commands into a binary log. The records are gathered in a buffer and written to the
+* stream in large blocks.
+*/
+class CommandLogWriter {
+public:
+
+    /*
+    * Constructor of CommandLogWriter class - writes the header of the log
+    * @param - the stream the log is written to
+    * @return - A new instance of CommandLogWriter
+    */
+    explicit CommandLogWriter(std::ostream& out);
+
+    /*
+    * Copy Constructor and Assignment Operator of CommandLogWriter class
+    * A log is written by a single writer, so it cannot be copied.
+    */
+    CommandLogWriter(const CommandLogWriter& other) = delete;
+    CommandLogWriter& operator=(const CommandLogWriter& other) = delete;
+
+    /*
+    * Destructor of CommandLogWriter class - writes the records left in the buffer
+    * @param - none
+    * @return - void
+    */
+    ~CommandLogWriter();
+
+    /*
+    * Add a command to the log
+    * @param - the command
+    * @return - void
+    */
+    void write_command(const Command& command);
+
+    /*
+    * Add the record ending the log with "Invalid input format"
+    * @param - none
+    * @return - void
+    */
+    void write_bad_format();
+
+    /*
+    * Add the record ending the log with an unknown command
+    * @param - the name of the command
+    * @return - void
+    */
+    void write_unknown(const std::string& name);
+
+    /*
+    * Write the records in the buffer to the stream
+    * @param - none
+    * @return - void
+    */
+    void flush();
+
+private:
+
+    /*
+     * Helper functions for encoding:
+     * write_byte: adds a byte to the buffer, writing the buffer to the stream once it is full.
+     * write_varint: adds an unsigned value as a varint.
+     */
+    void write_byte(const unsigned char byte);
+    void write_varint(unsigned int value);
+
+    /*
+     * The internal fields of CommandLogWriter:
+     *   The stream the log is written to
+     *   The buffer, and the number of bytes in it
+     */
+    std::ostream& m_out;
+    char* m_buffer;
+    int m_length;
+
+};
+
+/*
+* Class CommandLogReader
+* This class is used to decode the records of a binary log held in memory, in order, without copying it.
+*/
+class CommandLogReader {
+public:
+
+    /*
+    * Constructor of CommandLogReader class - bytes without the header of a log are read as a single corrupt record
+    * @param - the bytes of the log, and their number
+    * @return - A new instance of CommandLogReader
+    */
+    CommandLogReader(const char* data, const size_t size);
+
+    /*
+    * Decode the next record of the log - once a record ends the log, every call returns it again
+    * @param - where a command is stored, and where the name of an unknown command is stored
+    * @return - the kind of the record
+    */
+    LogRecord next(Command& command, std::string& unknown);
+
+private:
+
+    /*
+     * Helper functions for decoding:
+     * read_varint: reads an unsigned varint of at most 32 bits - returns false if it is cut off or too long.
+     */
+    bool read_varint(unsigned int& value);
+
+    /*
+     * The internal fields of CommandLogReader:
+     *   The next byte to be read, and the end of the log
+     *   The record that ended the log, or COMMAND while the log did not end
+     */
+    const unsigned char* m_pos;
+    const unsigned char* m_end;
+    LogRecord m_last;
+
+};
+
+#endif //WORLD_CUP_SYSTEM_COMMANDLOG_H
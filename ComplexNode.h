@@ -95,6 +95,13 @@ private:
     */
     void update_height();
 
+    /*
+     * Update the number of nodes in the subtree of the current node
+     * @param - none
+     * @return - void
+    */
+    void update_size();
+
     /*
      * Helper function for get_all_players in world_cup:
      * Recursively inserts the player ID's of the data of the tree into a given array
@@ -120,13 +127,13 @@ private:
      * ComplexNode.
      * This allows ComplexNode to be a mostly private class, while allowing the system to run smoothly.
     */
-    template <class M>
+    template <class M, class B>
     friend class MultiTree;
 
     template <class K>
     friend class TreeExtraPointer;
 
-    template <class ComplexNode, class N>
+    template <class ComplexNode, class N, class B>
     friend class Tree;
     
 };
@@ -285,6 +292,21 @@ void ComplexNode<T>::update_height()
 }
 
 
+//Update the number of nodes in the subtree of the specific node
+template <class T>
+void ComplexNode<T>::update_size()
+{
+    int sizeLeft = 0, sizeRight = 0;
+    if (m_left != nullptr) {
+        sizeLeft = m_left->m_size;
+    }
+    if (m_right != nullptr) {
+        sizeRight = m_right->m_size;
+    }
+    this->m_size = sizeLeft + sizeRight + 1;
+}
+
+
 //--------------------------------------Private Helper Function for world_cup---------------------------------------
 
 template <class T>
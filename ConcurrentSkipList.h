@@ -0,0 +1,517 @@
+#ifndef WORLD_CUP_SYSTEM_CONCURRENTSKIPLIST_H
+#define WORLD_CUP_SYSTEM_CONCURRENTSKIPLIST_H
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include "Exception.h"
+
+/*
+* Class ConcurrentSkipList
+* This class is used to create a lock-free skip list sorted by the same three keys as MultiTree: the number of goals,
+* the number of cards (more cards come first) and the ID. Any number of threads may insert, remove, find the max and
+* walk the list at the same time.
+* Every node holds an array of links, one for each level it is in. A node is removed by marking its links (the lowest
+* bit of each link) from its top level down, and the marked node is then unlinked by whichever thread passes it.
+* Removed nodes are kept until reclaim is called while no other thread uses the list, or until the list is destroyed.
+*/
+template <class T>
+class ConcurrentSkipList {
+public:
+
+    /*
+    * Constructor of ConcurrentSkipList class
+    * @param - none
+    * @return - A new instance of ConcurrentSkipList
+    */
+    ConcurrentSkipList();
+
+    /*
+    * Copy Constructor and Assignment Operator of ConcurrentSkipList class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    ConcurrentSkipList(const ConcurrentSkipList& other) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList& other) = delete;
+
+    /*
+    * Destructor of ConcurrentSkipList class - must not run while other threads use the list
+    * @param - none
+    * @return - void
+    */
+    ~ConcurrentSkipList();
+
+    /*
+     * Insert new node with data, according to the keys given
+     * @param - New data to insert, and the ID, goals and cards of the new node
+     * @return - void
+     */
+    void insert(T data, const int id, const int goals, const int cards);
+
+    /*
+     * Remove the node with the keys given
+     * @param - The ID, goals and cards of the node that needs to be removed
+     * @return - none
+     */
+    void remove(const int id, const int goals, const int cards);
+
+    /*
+     * Return the data of the last node (the most goals, then the fewest cards, then the largest ID)
+     * @param - none
+     * @return - the data of the max node, or a default T (nullptr for pointers) if the list is empty
+     */
+    T search_and_return_max();
+
+    /*
+     * Add the ID's of all the nodes to the given array, in order. Nodes inserted or removed during the walk may or
+     * may not be included.
+     * @param - an array with room for all the nodes
+     * @return - the number of ID's added
+     */
+    int get_all_data(int* const array) const;
+
+    /*
+     * Return the number of nodes in the list
+     * @param - none
+     * @return - the number of nodes
+     */
+    int get_size() const;
+
+    /*
+     * Free the removed nodes - must not run while other threads use the list
+     * @param - none
+     * @return - void
+     */
+    void reclaim();
+
+private:
+
+    /*
+     * The maximum number of levels of a node, and one in LEVEL_RATIO nodes of each level is also in the next one
+     */
+    static const int MAX_LEVEL = 16;
+    static const unsigned int LEVEL_RATIO = 4;
+
+    /*
+     * A node of the list:
+     *   The data and the keys of the node
+     *   The highest level the node is in, and its link in every level up to it - the lowest bit of a link is set
+     *   once the node is removed from that level
+     *   The next removed node, while the node waits to be freed
+     *   Whether the node is the head (before all the others) or the tail (after all the others) of the list
+     */
+    struct SkipNode {
+        T m_data;
+        int m_id;
+        int m_goals;
+        int m_cards;
+        int m_topLevel;
+        std::atomic<uintptr_t>* m_next;
+        SkipNode* m_retiredNext;
+        bool m_head;
+        bool m_tail;
+    };
+
+    /*
+     * Helper functions for the links:
+     * Whether a link is marked, the node it points to, and the link to a node
+     */
+    static bool is_marked(const uintptr_t link);
+    static SkipNode* get_node(const uintptr_t link);
+    static uintptr_t make_link(SkipNode* node, const bool marked);
+
+    /*
+     * Create a node with links in the levels up to topLevel, all pointing at nullptr
+     * @param - the data and keys of the node and its top level
+     * @return - a pointer to the node
+     */
+    static SkipNode* create_node(T data, const int id, const int goals, const int cards, const int topLevel);
+
+    /*
+     * Free a node and its links
+     * @param - a pointer to the node
+     * @return - void
+     */
+    static void destroy_node(SkipNode* node);
+
+    /*
+     * Return whether a node comes before the given keys
+     * @param - a pointer to the node, and the ID, goals and cards
+     * @return - bool, true if the node comes first
+     */
+    static bool is_before(const SkipNode* node, const int id, const int goals, const int cards);
+
+    /*
+     * Choose the top level of a new node at random
+     * @param - none
+     * @return - the top level
+     */
+    static int random_level();
+
+    /*
+     * Find the last node before the given keys, and the node after it, in every level - unlinking the removed nodes
+     * passed on the way
+     * @param - the ID, goals and cards, and arrays of MAX_LEVEL nodes for the results
+     * @return - bool, true if the node after it in the lowest level has the given keys
+     */
+    bool find(const int id, const int goals, const int cards, SkipNode** preds, SkipNode** succs);
+
+    /*
+     * Add a removed node to the list of nodes waiting to be freed
+     * @param - a pointer to the node
+     * @return - void
+     */
+    void retire(SkipNode* node);
+
+    /*
+     * The internal fields of ConcurrentSkipList:
+     *   The head and tail nodes of the list, which are in every level
+     *   The number of nodes in the list
+     *   The removed nodes waiting to be freed
+     */
+    SkipNode* m_head;
+    SkipNode* m_tail;
+    std::atomic<int> m_size;
+    std::atomic<SkipNode*> m_retired;
+
+};
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+template <class T>
+ConcurrentSkipList<T>::ConcurrentSkipList() :
+    m_head(nullptr),
+    m_tail(nullptr),
+    m_size(0),
+    m_retired(nullptr)
+{
+    m_tail = create_node(T(), 0, 0, 0, MAX_LEVEL - 1);
+    m_tail->m_tail = true;
+    try {
+        m_head = create_node(T(), 0, 0, 0, MAX_LEVEL - 1);
+    }
+    catch (const std::bad_alloc& e) {
+        destroy_node(m_tail);
+        throw e;
+    }
+    m_head->m_head = true;
+    for (int level = 0; level < MAX_LEVEL; level++) {
+        m_head->m_next[level].store(make_link(m_tail, false));
+    }
+}
+
+
+template <class T>
+ConcurrentSkipList<T>::~ConcurrentSkipList()
+{
+    reclaim();
+    SkipNode* node = m_head;
+    while (node != nullptr) {
+        SkipNode* next = get_node(node->m_next[0].load());
+        destroy_node(node);
+        node = next;
+    }
+}
+
+
+//-----------------------------------------------List Functions-----------------------------------------------
+
+template <class T>
+void ConcurrentSkipList<T>::insert(T data, const int id, const int goals, const int cards)
+{
+    SkipNode* preds[MAX_LEVEL];
+    SkipNode* succs[MAX_LEVEL];
+    int topLevel = random_level();
+    SkipNode* node = nullptr;
+    while (true) {
+        if (find(id, goals, cards, preds, succs)) {
+            if (node != nullptr) {
+                destroy_node(node);
+            }
+            //A node with these keys already exists - invalid operation
+            throw InvalidID();
+        }
+        if (node == nullptr) {
+            node = create_node(data, id, goals, cards, topLevel);
+        }
+        for (int level = 0; level <= topLevel; level++) {
+            node->m_next[level].store(make_link(succs[level], false));
+        }
+        //The node is in the list once it is linked in the lowest level
+        uintptr_t expected = make_link(succs[0], false);
+        if (preds[0]->m_next[0].compare_exchange_strong(expected, make_link(node, false))) {
+            break;
+        }
+    }
+    m_size++;
+    bool linked = true;
+    for (int level = 1; level <= topLevel && linked; level++) {
+        while (true) {
+            //The link of the node may be out of date after a retry, or marked if the node is already being removed
+            uintptr_t link = node->m_next[level].load();
+            if (is_marked(link) || (get_node(link) != succs[level] &&
+                !node->m_next[level].compare_exchange_strong(link, make_link(succs[level], false)))) {
+                linked = false;
+                break;
+            }
+            uintptr_t expected = make_link(succs[level], false);
+            if (preds[level]->m_next[level].compare_exchange_strong(expected, make_link(node, false))) {
+                break;
+            }
+            if (!find(id, goals, cards, preds, succs) || succs[0] != node) {
+                linked = false;
+                break;
+            }
+        }
+    }
+    //A remove that ran while the upper levels were linked may have missed a level linked after it - unlink it here
+    if (is_marked(node->m_next[0].load())) {
+        find(id, goals, cards, preds, succs);
+    }
+}
+
+
+template <class T>
+void ConcurrentSkipList<T>::remove(const int id, const int goals, const int cards)
+{
+    SkipNode* preds[MAX_LEVEL];
+    SkipNode* succs[MAX_LEVEL];
+    if (!find(id, goals, cards, preds, succs)) {
+        throw NodeNotFound();
+    }
+    SkipNode* victim = succs[0];
+    //Mark the links of the upper levels, so no node is linked after the victim any more
+    for (int level = victim->m_topLevel; level > 0; level--) {
+        uintptr_t link = victim->m_next[level].load();
+        while (!is_marked(link)) {
+            victim->m_next[level].compare_exchange_weak(link, link | 1);
+        }
+    }
+    //The thread that marks the lowest level is the one that removes the node
+    uintptr_t link = victim->m_next[0].load();
+    while (true) {
+        if (is_marked(link)) {
+            throw NodeNotFound();
+        }
+        if (victim->m_next[0].compare_exchange_weak(link, link | 1)) {
+            break;
+        }
+    }
+    m_size--;
+    //Unlink the node from every level
+    find(id, goals, cards, preds, succs);
+    retire(victim);
+}
+
+
+template <class T>
+T ConcurrentSkipList<T>::search_and_return_max()
+{
+    SkipNode* preds[MAX_LEVEL];
+    SkipNode* succs[MAX_LEVEL];
+    while (true) {
+        SkipNode* pred = m_head;
+        for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+            SkipNode* curr = get_node(pred->m_next[level].load());
+            while (!curr->m_tail) {
+                pred = curr;
+                curr = get_node(curr->m_next[level].load());
+            }
+        }
+        if (pred->m_head) {
+            return T();
+        }
+        if (!is_marked(pred->m_next[0].load())) {
+            return pred->m_data;
+        }
+        //The last node is being removed - unlink it and look again
+        find(pred->m_id, pred->m_goals, pred->m_cards, preds, succs);
+    }
+}
+
+
+template <class T>
+int ConcurrentSkipList<T>::get_all_data(int* const array) const
+{
+    int index = 0;
+    SkipNode* node = get_node(m_head->m_next[0].load());
+    while (!node->m_tail) {
+        uintptr_t link = node->m_next[0].load();
+        if (!is_marked(link)) {
+            array[index++] = node->m_id;
+        }
+        node = get_node(link);
+    }
+    return index;
+}
+
+
+template <class T>
+int ConcurrentSkipList<T>::get_size() const
+{
+    return m_size.load();
+}
+
+
+template <class T>
+void ConcurrentSkipList<T>::reclaim()
+{
+    SkipNode* node = m_retired.exchange(nullptr);
+    while (node != nullptr) {
+        SkipNode* next = node->m_retiredNext;
+        destroy_node(node);
+        node = next;
+    }
+}
+
+
+//------------------------------------------------Helper Functions-------------------------------------------------
+
+template <class T>
+bool ConcurrentSkipList<T>::is_marked(const uintptr_t link)
+{
+    return (link & 1) != 0;
+}
+
+
+template <class T>
+typename ConcurrentSkipList<T>::SkipNode* ConcurrentSkipList<T>::get_node(const uintptr_t link)
+{
+    return reinterpret_cast<SkipNode*>(link & ~((uintptr_t) 1));
+}
+
+
+template <class T>
+uintptr_t ConcurrentSkipList<T>::make_link(SkipNode* node, const bool marked)
+{
+    return reinterpret_cast<uintptr_t>(node) | (marked ? 1 : 0);
+}
+
+
+template <class T>
+typename ConcurrentSkipList<T>::SkipNode* ConcurrentSkipList<T>::create_node(T data, const int id, const int goals,
+                                                                             const int cards, const int topLevel)
+{
+    SkipNode* node = new SkipNode();
+    try {
+        node->m_next = new std::atomic<uintptr_t>[topLevel + 1];
+    }
+    catch (const std::bad_alloc& e) {
+        delete node;
+        throw e;
+    }
+    for (int level = 0; level <= topLevel; level++) {
+        node->m_next[level].store(0);
+    }
+    node->m_data = data;
+    node->m_id = id;
+    node->m_goals = goals;
+    node->m_cards = cards;
+    node->m_topLevel = topLevel;
+    node->m_retiredNext = nullptr;
+    node->m_head = false;
+    node->m_tail = false;
+    return node;
+}
+
+
+template <class T>
+void ConcurrentSkipList<T>::destroy_node(SkipNode* node)
+{
+    delete[] node->m_next;
+    delete node;
+}
+
+
+template <class T>
+bool ConcurrentSkipList<T>::is_before(const SkipNode* node, const int id, const int goals, const int cards)
+{
+    if (node->m_head) {
+        return true;
+    }
+    if (node->m_tail) {
+        return false;
+    }
+    if (node->m_goals != goals) {
+        return node->m_goals < goals;
+    }
+    if (node->m_cards != cards) {
+        return node->m_cards > cards;
+    }
+    return node->m_id < id;
+}
+
+
+template <class T>
+int ConcurrentSkipList<T>::random_level()
+{
+    //Every thread has its own generator, so choosing a level needs no synchronization
+    static thread_local unsigned int state = 2463534242U;
+    int level = 0;
+    while (level < MAX_LEVEL - 1) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        if (state % LEVEL_RATIO != 0) {
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+
+template <class T>
+bool ConcurrentSkipList<T>::find(const int id, const int goals, const int cards, SkipNode** preds, SkipNode** succs)
+{
+    while (true) {
+        bool restart = false;
+        SkipNode* pred = m_head;
+        for (int level = MAX_LEVEL - 1; level >= 0 && !restart; level--) {
+            SkipNode* curr = get_node(pred->m_next[level].load());
+            while (true) {
+                uintptr_t link = curr->m_next[level].load();
+                //Unlink the removed nodes after pred - if pred itself changed, start over
+                while (is_marked(link)) {
+                    uintptr_t expected = make_link(curr, false);
+                    if (!pred->m_next[level].compare_exchange_strong(expected, make_link(get_node(link), false))) {
+                        restart = true;
+                        break;
+                    }
+                    curr = get_node(link);
+                    link = curr->m_next[level].load();
+                }
+                if (restart) {
+                    break;
+                }
+                if (!is_before(curr, id, goals, cards)) {
+                    break;
+                }
+                pred = curr;
+                curr = get_node(link);
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        if (restart) {
+            continue;
+        }
+        SkipNode* found = succs[0];
+        return !found->m_tail && found->m_id == id && found->m_goals == goals && found->m_cards == cards;
+    }
+}
+
+
+template <class T>
+void ConcurrentSkipList<T>::retire(SkipNode* node)
+{
+    SkipNode* head = m_retired.load();
+    do {
+        node->m_retiredNext = head;
+    } while (!m_retired.compare_exchange_weak(head, node));
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+
+#endif //WORLD_CUP_SYSTEM_CONCURRENTSKIPLIST_H
@@ -0,0 +1,108 @@
+#include "EpochManager.h"
+#include <sched.h>
+#include <thread>
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+EpochManager::EpochManager() :
+    m_epoch(1),
+    m_retired(nullptr)
+{
+    for (int i = 0; i < NUM_SLOTS; i++) {
+        m_slots[i].m_epoch.store(FREE_SLOT);
+    }
+}
+
+
+EpochManager::~EpochManager()
+{
+    while (m_retired != nullptr) {
+        Retired* next = m_retired->m_retiredNext;
+        m_retired->m_free(m_retired);
+        m_retired = next;
+    }
+}
+
+
+//-----------------------------------------------Reader Functions------------------------------------------------
+
+int EpochManager::pin()
+{
+    //Start the search at the core of the reader, so readers on different cores rarely try the same slot
+    int cpu = sched_getcpu();
+    int slot = (cpu < 0) ? 0 : cpu % NUM_SLOTS;
+    unsigned long long epoch = m_epoch.load();
+    while (true) {
+        unsigned long long expected = FREE_SLOT;
+        if (m_slots[slot].m_epoch.compare_exchange_strong(expected, epoch)) {
+            break;
+        }
+        slot = (slot + 1) % NUM_SLOTS;
+        if (slot == 0) {
+            std::this_thread::yield();
+        }
+    }
+    //The epoch may have changed before it was pinned - pin the current one, until it stays the same
+    unsigned long long current = m_epoch.load();
+    while (current != epoch) {
+        epoch = current;
+        m_slots[slot].m_epoch.store(epoch);
+        current = m_epoch.load();
+    }
+    return slot;
+}
+
+
+void EpochManager::unpin(const int slot)
+{
+    m_slots[slot].m_epoch.store(FREE_SLOT);
+}
+
+
+//-----------------------------------------------Writer Functions------------------------------------------------
+
+void EpochManager::retire(Retired* item)
+{
+    item->m_retiredEpoch = m_epoch.load();
+    item->m_retiredNext = m_retired;
+    m_retired = item;
+}
+
+
+void EpochManager::reclaim()
+{
+    m_epoch.fetch_add(1);
+    unsigned long long oldest = m_epoch.load();
+    for (int i = 0; i < NUM_SLOTS; i++) {
+        unsigned long long pinned = m_slots[i].m_epoch.load();
+        if (pinned != FREE_SLOT && pinned < oldest) {
+            oldest = pinned;
+        }
+    }
+    //Readers that pinned the oldest epoch may still use items retired in it
+    Retired** current = &m_retired;
+    while (*current != nullptr) {
+        Retired* item = *current;
+        if (item->m_retiredEpoch < oldest) {
+            *current = item->m_retiredNext;
+            item->m_free(item);
+        }
+        else {
+            current = &item->m_retiredNext;
+        }
+    }
+}
+
+
+//--------------------------------------------------Guards----------------------------------------------------
+
+EpochGuard::EpochGuard(EpochManager& epochs) :
+    m_epochs(epochs),
+    m_slot(epochs.pin())
+{}
+
+
+EpochGuard::~EpochGuard()
+{
+    m_epochs.unpin(m_slot);
+}
@@ -0,0 +1,137 @@
+#ifndef WORLD_CUP_SYSTEM_EPOCHMANAGER_H
+#define WORLD_CUP_SYSTEM_EPOCHMANAGER_H
+
+#include <atomic>
+
+/*
+* Class EpochManager
+* This class is used to free memory that readers may still be using, only once they are done with it.
+* A reader pins the current epoch before it reads, and unpins it once it is done. A writer retires the memory it
+* unlinked, tagging it with the current epoch, and the memory is freed once every pinned epoch is newer than its tag -
+* a reader that pinned a newer epoch started after the memory was unlinked, so it cannot reach it.
+* Any number of readers may pin and unpin at the same time, while retire and reclaim must be called by one writer at a
+* time.
+*/
+class EpochManager {
+public:
+
+    /*
+    * The header of memory that can be retired - the retired classes inherit it, so retiring allocates nothing:
+    *   The next retired item, and the epoch it was retired in
+    *   The function that frees the item
+    */
+    struct Retired {
+        Retired* m_retiredNext;
+        unsigned long long m_retiredEpoch;
+        void (*m_free)(Retired* item);
+    };
+
+    /*
+    * Constructor of EpochManager class
+    * @param - none
+    * @return - A new instance of EpochManager
+    */
+    EpochManager();
+
+    /*
+    * Copy Constructor and Assignment Operator of EpochManager class
+    * The readers pinned in a manager cannot be copied.
+    */
+    EpochManager(const EpochManager& other) = delete;
+    EpochManager& operator=(const EpochManager& other) = delete;
+
+    /*
+    * Destructor of EpochManager class - frees all the retired items, so no reader may be pinned
+    * @param - none
+    * @return - void
+    */
+    ~EpochManager();
+
+    /*
+    * Pin the current epoch, before reading
+    * @param - none
+    * @return - the slot of the reader, which must be given to unpin
+    */
+    int pin();
+
+    /*
+    * Unpin the epoch pinned by a reader
+    * @param - the slot returned by pin
+    * @return - void
+    */
+    void unpin(const int slot);
+
+    /*
+    * Retire an item that was unlinked, so no new reader can reach it
+    * @param - the item
+    * @return - void
+    */
+    void retire(Retired* item);
+
+    /*
+    * Start a new epoch, and free the retired items no pinned reader may still use
+    * @param - none
+    * @return - void
+    */
+    void reclaim();
+
+private:
+
+    /*
+     * The number of reader slots, and the value of a slot no reader holds
+     */
+    static const int NUM_SLOTS = 64;
+    static const unsigned long long FREE_SLOT = 0;
+
+    /*
+     * A reader slot, holding the epoch pinned by its reader - padded to the size of a cache line
+     */
+    struct ReaderSlot {
+        std::atomic<unsigned long long> m_epoch;
+        char m_padding[64 - sizeof(std::atomic<unsigned long long>)];
+    };
+
+    /*
+     * The internal fields of EpochManager:
+     *   The current epoch, starting at 1
+     *   The reader slots
+     *   The retired items that were not freed yet, the most recently retired first
+     */
+    std::atomic<unsigned long long> m_epoch;
+    ReaderSlot m_slots[NUM_SLOTS];
+    Retired* m_retired;
+
+};
+
+/*
+* Class EpochGuard
+* This class is used to pin an epoch until the scope it was created in ends.
+*/
+class EpochGuard {
+public:
+
+    /*
+    * Constructor of EpochGuard class - pins the current epoch
+    * @param - the manager
+    * @return - A new instance of EpochGuard
+    */
+    explicit EpochGuard(EpochManager& epochs);
+
+    EpochGuard(const EpochGuard& other) = delete;
+    EpochGuard& operator=(const EpochGuard& other) = delete;
+
+    /*
+    * Destructor of EpochGuard class - unpins the epoch
+    * @param - none
+    * @return - void
+    */
+    ~EpochGuard();
+
+private:
+
+    EpochManager& m_epochs;
+    int m_slot;
+
+};
+
+#endif //WORLD_CUP_SYSTEM_EPOCHMANAGER_H
@@ -0,0 +1,182 @@
+#ifndef WORLD_CUP_SYSTEM_EYTZINGERINDEX_H
+#define WORLD_CUP_SYSTEM_EYTZINGERINDEX_H
+
+#include <new>
+
+/*
+* Class EytzingerIndex
+* This class is used to hold an immutable set of ID's and their data, for fast searches by ID.
+* The ID's are kept in a single array in Eytzinger (breadth-first) order - the children of the ID at index k are at
+* indexes 2k and 2k+1 - so the first levels of every search share the same few cache lines, and each step of the
+* search is a comparison added to the index instead of a branch.
+*/
+template <class T>
+class EytzingerIndex {
+public:
+
+    /*
+    * Constructor of EytzingerIndex class - an empty index
+    * @param - none
+    * @return - A new instance of EytzingerIndex
+    */
+    EytzingerIndex();
+
+    /*
+    * Copy Constructor and Assignment Operator of EytzingerIndex class
+    * The index holds data owned by world_cup, so it cannot be copied.
+    */
+    EytzingerIndex(const EytzingerIndex& other) = delete;
+    EytzingerIndex& operator=(const EytzingerIndex& other) = delete;
+
+    /*
+    * Destructor of EytzingerIndex class
+    * @param - none
+    * @return - void
+    */
+    ~EytzingerIndex();
+
+    /*
+    * Replace the contents of the index
+    * @param - the ID's sorted in ascending order, their data, and the number of ID's
+    * @return - void
+    */
+    void build(const int* ids, const T* data, const int size);
+
+    /*
+    * Empty the index
+    * @param - none
+    * @return - void
+    */
+    void clear();
+
+    /*
+    * Search for an ID in the index
+    * @param - the ID
+    * @return - a pointer to the data of the ID, or nullptr if the ID is not in the index
+    */
+    T* find(const int id) const;
+
+    /*
+    * Return the number of ID's in the index
+    * @param - none
+    * @return - the number of ID's
+    */
+    int get_size() const;
+
+private:
+
+    /*
+     * Helper function for build:
+     * Places the sorted ID's in the subtree of index k, in order
+     * @param - the sorted ID's and data, the next sorted index to be placed, and k
+     * @return - the next sorted index to be placed after the subtree
+     */
+    int fill(const int* ids, const T* data, int next, const int k);
+
+    /*
+     * The internal fields of EytzingerIndex:
+     *   The ID's and their data in Eytzinger order, starting at index 1
+     *   The number of ID's
+     */
+    int* m_ids;
+    T* m_data;
+    int m_size;
+
+};
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+template <class T>
+EytzingerIndex<T>::EytzingerIndex() :
+    m_ids(nullptr),
+    m_data(nullptr),
+    m_size(0)
+{}
+
+
+template <class T>
+EytzingerIndex<T>::~EytzingerIndex()
+{
+    clear();
+}
+
+
+//-----------------------------------------------Index Functions----------------------------------------------
+
+template <class T>
+void EytzingerIndex<T>::build(const int* ids, const T* data, const int size)
+{
+    int* newIds = new int[size + 1];
+    T* newData;
+    try {
+        newData = new T[size + 1];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] newIds;
+        throw e;
+    }
+    clear();
+    m_ids = newIds;
+    m_data = newData;
+    m_size = size;
+    fill(ids, data, 0, 1);
+}
+
+
+template <class T>
+void EytzingerIndex<T>::clear()
+{
+    delete[] m_ids;
+    delete[] m_data;
+    m_ids = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+
+template <class T>
+T* EytzingerIndex<T>::find(const int id) const
+{
+    int k = 1;
+    while (k <= m_size) {
+        k = 2 * k + (m_ids[k] < id);
+    }
+    //The search went right after every smaller ID - dropping those steps leads back to the first ID not smaller
+    //than the requested one
+    while (k & 1) {
+        k >>= 1;
+    }
+    k >>= 1;
+    if (k == 0 || m_ids[k] != id) {
+        return nullptr;
+    }
+    return &m_data[k];
+}
+
+
+template <class T>
+int EytzingerIndex<T>::get_size() const
+{
+    return m_size;
+}
+
+
+//------------------------------------------------Helper Functions-------------------------------------------------
+
+template <class T>
+int EytzingerIndex<T>::fill(const int* ids, const T* data, int next, const int k)
+{
+    if (k > m_size) {
+        return next;
+    }
+    next = fill(ids, data, next, 2 * k);
+    m_ids[k] = ids[next];
+    m_data[k] = data[next];
+    next++;
+    return fill(ids, data, next, 2 * k + 1);
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+
+#endif //WORLD_CUP_SYSTEM_EYTZINGERINDEX_H
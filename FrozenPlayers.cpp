@@ -0,0 +1,122 @@
+#include "FrozenPlayers.h"
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+FrozenPlayers::FrozenPlayers() :
+    m_byID(),
+    m_scoreOrder(nullptr),
+    m_delta(nullptr),
+    m_maxDelta(0)
+{}
+
+
+FrozenPlayers::~FrozenPlayers()
+{
+    clear();
+}
+
+
+//----------------------------------------------Snapshot Settings---------------------------------------------
+
+void FrozenPlayers::set_limit(const int maxDelta)
+{
+    m_maxDelta = maxDelta;
+}
+
+
+bool FrozenPlayers::is_enabled() const
+{
+    return m_maxDelta > 0 && m_delta != nullptr;
+}
+
+
+bool FrozenPlayers::is_stale() const
+{
+    return is_enabled() && m_delta->get_size() > m_maxDelta;
+}
+
+
+//----------------------------------------------Snapshot Functions--------------------------------------------
+
+void FrozenPlayers::freeze(const Tree<GenericNode<Player*>, Player*>& playersByID,
+                           const MultiTree<Player*>& playersByScore)
+{
+    int size = playersByID.get_size();
+    Player** players = nullptr;
+    int* ids = nullptr;
+    int* scoreOrder = nullptr;
+    Tree<GenericNode<Player*>, Player*>* delta = nullptr;
+    try {
+        players = new Player*[size];
+        ids = new int[size];
+        scoreOrder = new int[size];
+        delta = new Tree<GenericNode<Player*>, Player*>();
+        if (size > 0) {
+            playersByID.m_node->unite_insert(players, 0);
+            playersByScore.get_all_data(scoreOrder);
+        }
+        for (int i = 0; i < size; i++) {
+            ids[i] = players[i]->get_playerId();
+        }
+        m_byID.build(ids, players, size);
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] players;
+        delete[] ids;
+        delete[] scoreOrder;
+        delete delta;
+        throw e;
+    }
+    delete[] players;
+    delete[] ids;
+    delete[] m_scoreOrder;
+    delete m_delta;
+    m_scoreOrder = scoreOrder;
+    m_delta = delta;
+}
+
+
+void FrozenPlayers::clear()
+{
+    m_byID.clear();
+    delete[] m_scoreOrder;
+    delete m_delta;
+    m_scoreOrder = nullptr;
+    m_delta = nullptr;
+}
+
+
+void FrozenPlayers::record(const int playerId, Player* player)
+{
+    Player** found = m_delta->find_data(playerId);
+    if (found != nullptr) {
+        *found = player;
+        return;
+    }
+    m_delta->insert(player, playerId);
+}
+
+
+Player* FrozenPlayers::find(const int playerId) const
+{
+    Player** found = m_delta->find_data(playerId);
+    if (found == nullptr) {
+        found = m_byID.find(playerId);
+    }
+    if (found == nullptr) {
+        return nullptr;
+    }
+    return *found;
+}
+
+
+bool FrozenPlayers::get_score_order(int* const output) const
+{
+    if (m_delta->get_size() > 0) {
+        return false;
+    }
+    for (int i = 0; i < m_byID.get_size(); i++) {
+        output[i] = m_scoreOrder[i];
+    }
+    return true;
+}
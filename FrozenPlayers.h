@@ -0,0 +1,114 @@
+#ifndef WORLD_CUP_SYSTEM_FROZENPLAYERS_H
+#define WORLD_CUP_SYSTEM_FROZENPLAYERS_H
+
+#include "Player.h"
+#include "AVLTree.h"
+#include "AVLMultiVariable.h"
+#include "GenericNode.h"
+#include "EytzingerIndex.h"
+
+/*
+* Class FrozenPlayers
+* This class is used to hold a read-only snapshot of the players of world_cup, for workloads that are almost only
+* reads. The snapshot holds the players in an EytzingerIndex by their ID, and the ID's of all the players in the order
+* of their goals, cards and ID.
+* Players that were added, removed or updated after the snapshot was taken are recorded in a small delta, which is
+* searched before the snapshot. Once the delta holds too many players, the snapshot should be taken again.
+*/
+class FrozenPlayers {
+public:
+
+    /*
+    * Constructor of FrozenPlayers class - the snapshot starts disabled
+    * @param - none
+    * @return - A new instance of FrozenPlayers
+    */
+    FrozenPlayers();
+
+    /*
+    * Copy Constructor and Assignment Operator of FrozenPlayers class
+    * The snapshot holds players owned by world_cup, so it cannot be copied.
+    */
+    FrozenPlayers(const FrozenPlayers& other) = delete;
+    FrozenPlayers& operator=(const FrozenPlayers& other) = delete;
+
+    /*
+    * Destructor of FrozenPlayers class
+    * @param - none
+    * @return - void
+    */
+    ~FrozenPlayers();
+
+    /*
+    * Set the maximum size of the delta
+    * @param - the maximum number of players changed after the snapshot was taken (0 disables the snapshot)
+    * @return - void
+    */
+    void set_limit(const int maxDelta);
+
+    /*
+    * Return whether the snapshot is used
+    * @param - none
+    * @return - bool, true if the snapshot is enabled
+    */
+    bool is_enabled() const;
+
+    /*
+    * Return whether the delta is larger than its maximum size, so the snapshot should be taken again
+    * @param - none
+    * @return - bool, true if the snapshot is out of date
+    */
+    bool is_stale() const;
+
+    /*
+    * Take a new snapshot of the players and empty the delta
+    * @param - the tree of all the players sorted by ID, and the tree of all the players sorted by their score
+    * @return - void
+    */
+    void freeze(const Tree<GenericNode<Player*>, Player*>& playersByID, const MultiTree<Player*>& playersByScore);
+
+    /*
+    * Free the snapshot and the delta
+    * @param - none
+    * @return - void
+    */
+    void clear();
+
+    /*
+    * Record that a player was added, removed or updated after the snapshot was taken
+    * @param - the ID of the player, and a pointer to the player (nullptr if the player was removed)
+    * @return - void
+    */
+    void record(const int playerId, Player* player);
+
+    /*
+    * Search for a player, first in the delta and then in the snapshot
+    * @param - the ID of the player
+    * @return - a pointer to the player, or nullptr if there is no player with this ID
+    */
+    Player* find(const int playerId) const;
+
+    /*
+    * Copy the ID's of all the players in the order of their score, if no player changed since the snapshot was taken
+    * @param - an array with room for all the players
+    * @return - bool, true if the ID's were copied
+    */
+    bool get_score_order(int* const output) const;
+
+private:
+
+    /*
+     * The internal fields of FrozenPlayers:
+     *   The players of the snapshot by their ID
+     *   The ID's of the players of the snapshot in the order of their score
+     *   Tree of the players changed after the snapshot was taken, sorted by their ID - removed players hold nullptr
+     *   The maximum number of players in the delta
+     */
+    EytzingerIndex<Player*> m_byID;
+    int* m_scoreOrder;
+    Tree<GenericNode<Player*>, Player*>* m_delta;
+    int m_maxDelta;
+
+};
+
+#endif //WORLD_CUP_SYSTEM_FROZENPLAYERS_H
@@ -66,12 +66,12 @@ public:
     void inorderWalkTeamID(Team* team);
 
     /*
-    * Helper function for unite_teams in world_cup:
-    * Inserts players into a given array, node by node
+    * Helper function for unite_teams and for the flush of the update buffer in world_cup:
+    * Inserts the data of the nodes into a given array, node by node
     * @param - an array, current index
     * @return - current index
     */
-    int unite_insert(Player** players, int index);
+    int unite_insert(T* players, int index);
 
     /*
     * Returns the height of a node
@@ -124,6 +124,13 @@ private:
     */
     void update_height();
 
+    /*
+     * Update the number of nodes in the subtree of the current node
+     * @param - none
+     * @return - void
+    */
+    void update_size();
+
     /*
      * Helper function for knockout in world_cup:
      * Finds the valid team with the lowest team ID within a given range to a given array
@@ -151,7 +158,7 @@ private:
      * The following class is a friend class in order to allow full access to private fields and functions of
      * GenericNode, allowing GenericNode to be a mostly private class, while allowing the system to run smoothly.
     */
-    template <class N, class M>
+    template <class N, class M, class B>
     friend class Tree;
 
 };
@@ -204,7 +211,7 @@ void GenericNode<T>::inorderWalkTeamID(Team* team) {
 }
 
 template<class T>
-int GenericNode<T>::unite_insert(Player** players, int index) {
+int GenericNode<T>::unite_insert(T* players, int index) {
     if (this != nullptr && this->m_data != nullptr) {
         index = m_left->unite_insert(players, index);
         *(players+(index++)) = this->m_data;
@@ -339,6 +346,21 @@ void GenericNode<T>::update_height()
 }
 
 
+//Update the number of nodes in the subtree of the specific node
+template <class T>
+void GenericNode<T>::update_size()
+{
+    int sizeLeft = 0, sizeRight = 0;
+    if (m_left != nullptr) {
+        sizeLeft = m_left->m_size;
+    }
+    if (m_right != nullptr) {
+        sizeRight = m_right->m_size;
+    }
+    this->m_size = sizeLeft + sizeRight + 1;
+}
+
+
 //---------------------------------Private Helper Functions for world_cup---------------------------------------------
 
 template<class T>
@@ -54,11 +54,13 @@ protected:
      *   The height of the subtree of the node
      *   The balance factor of the node
      *   The key by which the tree is sorted (id)
+     *   The number of nodes in the subtree of the node
      */
     T m_data;
     int m_height;
     int m_bf;
     int m_id;
+    int m_size;
 
     /*
      * The following classes are friend classes in order to allow full access to private fields and functions of
@@ -68,10 +70,10 @@ protected:
     template <class K>
     friend class TreeExtraPointer;
 
-    template <class S>
+    template <class S, class B>
     friend class MultiTree;
 
-    template <class N, class M>
+    template <class N, class M, class B>
     friend class Tree;
 };
 
@@ -81,7 +83,8 @@ Node<T>::Node() :
     m_data(nullptr),
     m_height(-1),
     m_bf(0),
-    m_id(0)
+    m_id(0),
+    m_size(0)
 {}
 
 template <class T>
@@ -89,7 +92,8 @@ Node<T>::Node(T data) :
     m_data(data),
     m_height(-1),
     m_bf(0),
-    m_id(data->get_playerId())
+    m_id(data->get_playerId()),
+    m_size(0)
 {}
 
 template <class T>
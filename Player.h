@@ -5,6 +5,7 @@ class Team;
 
 #include "Teams.h"
 #include <memory>
+#include <climits>
 
 /*
 * Class Player
@@ -168,5 +169,15 @@ private:
     Player* m_closestRight;
 };
 
+/*
+* The position of a walk over players in the order of get_all_players: the goals, cards and ID of the last player
+* passed. A new cursor starts before the first player.
+*/
+struct PlayerCursor {
+    int m_goals = INT_MIN;
+    int m_cards = INT_MAX;
+    int m_id = INT_MIN;
+};
+
 
 #endif //PLAYER_H
\ No newline at end of file
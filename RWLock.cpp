@@ -0,0 +1,131 @@
+#include "RWLock.h"
+#include <sched.h>
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+RWLock::RWLock() :
+    m_writers(),
+    m_writing(false),
+    m_owner(std::thread::id()),
+    m_depth(0)
+{
+    for (int i = 0; i < NUM_SLOTS; i++) {
+        m_slots[i].m_readers.store(0);
+    }
+}
+
+
+//-------------------------------------------------Read Lock--------------------------------------------------
+
+int RWLock::lock_shared()
+{
+    //The writer already keeps every other thread out
+    if (m_owner.load() == std::this_thread::get_id()) {
+        return WRITER_SLOT;
+    }
+    int slot = current_slot();
+    while (true) {
+        //Count the reader first and check for a writer after, while a writer announces itself first and checks the
+        //readers after - so at least one of them sees the other
+        m_slots[slot].m_readers.fetch_add(1);
+        if (!m_writing.load()) {
+            return slot;
+        }
+        m_slots[slot].m_readers.fetch_sub(1);
+        while (m_writing.load()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+void RWLock::unlock_shared(const int slot)
+{
+    if (slot != WRITER_SLOT) {
+        m_slots[slot].m_readers.fetch_sub(1);
+    }
+}
+
+
+//-------------------------------------------------Write Lock-------------------------------------------------
+
+void RWLock::lock()
+{
+    if (m_owner.load() == std::this_thread::get_id()) {
+        m_depth++;
+        return;
+    }
+    m_writers.lock();
+    m_writing.store(true);
+    for (int i = 0; i < NUM_SLOTS; i++) {
+        while (m_slots[i].m_readers.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+    m_owner.store(std::this_thread::get_id());
+    m_depth = 1;
+}
+
+
+void RWLock::unlock()
+{
+    m_depth--;
+    if (m_depth > 0) {
+        return;
+    }
+    m_owner.store(std::thread::id());
+    m_writing.store(false);
+    m_writers.unlock();
+}
+
+
+//------------------------------------------------Helper Functions-------------------------------------------------
+
+int RWLock::current_slot()
+{
+    int cpu = sched_getcpu();
+    if (cpu < 0) {
+        //The core is unknown - every thread keeps to a slot of its own instead
+        static std::atomic<int> nextSlot(0);
+        static thread_local int threadSlot = nextSlot.fetch_add(1) % NUM_SLOTS;
+        return threadSlot;
+    }
+    return cpu % NUM_SLOTS;
+}
+
+
+//--------------------------------------------------Guards----------------------------------------------------
+
+ReadGuard::ReadGuard(RWLock& lock, const int slot) :
+    m_lock(lock),
+    m_slot(slot),
+    m_locked(true)
+{}
+
+
+ReadGuard::~ReadGuard()
+{
+    release();
+}
+
+
+void ReadGuard::release()
+{
+    if (m_locked) {
+        m_lock.unlock_shared(m_slot);
+        m_locked = false;
+    }
+}
+
+
+WriteGuard::WriteGuard(RWLock& lock) :
+    m_lock(lock)
+{
+    m_lock.lock();
+}
+
+
+WriteGuard::~WriteGuard()
+{
+    m_lock.unlock();
+}
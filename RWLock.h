@@ -0,0 +1,176 @@
+#ifndef WORLD_CUP_SYSTEM_RWLOCK_H
+#define WORLD_CUP_SYSTEM_RWLOCK_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/*
+* Class RWLock
+* This class is used to let many readers, or a single writer, use world_cup at the same time.
+* Every reader counts itself in one of several reader slots, chosen by the core it runs on, so readers on different
+* cores do not write to the same cache line. A writer first announces itself, so no new reader enters, and then waits
+* for all the slots to empty.
+* The writer may lock again and read while it holds the lock, so functions of world_cup may call each other.
+*/
+class RWLock {
+public:
+
+    /*
+    * Constructor of RWLock class - the lock starts unlocked
+    * @param - none
+    * @return - A new instance of RWLock
+    */
+    RWLock();
+
+    /*
+    * Copy Constructor and Assignment Operator of RWLock class
+    * The threads waiting on a lock cannot be copied.
+    */
+    RWLock(const RWLock& other) = delete;
+    RWLock& operator=(const RWLock& other) = delete;
+
+    /*
+    * Destructor of RWLock class
+    * @param - none
+    * @return - void
+    */
+    ~RWLock() = default;
+
+    /*
+    * Lock for reading, waiting while a writer holds the lock
+    * @param - none
+    * @return - the reader slot used, which must be given to unlock_shared
+    */
+    int lock_shared();
+
+    /*
+    * Unlock for reading
+    * @param - the reader slot returned by lock_shared
+    * @return - void
+    */
+    void unlock_shared(const int slot);
+
+    /*
+    * Lock for writing, waiting until no other thread holds the lock
+    * @param - none
+    * @return - void
+    */
+    void lock();
+
+    /*
+    * Unlock for writing
+    * @param - none
+    * @return - void
+    */
+    void unlock();
+
+private:
+
+    /*
+     * The number of reader slots, and the slot used by a writer that reads while holding the lock
+     */
+    static const int NUM_SLOTS = 64;
+    static const int WRITER_SLOT = -1;
+
+    /*
+     * A reader slot - padded to the size of a cache line
+     */
+    struct ReaderSlot {
+        std::atomic<int> m_readers;
+        char m_padding[64 - sizeof(std::atomic<int>)];
+    };
+
+    /*
+     * Helper function for lock_shared:
+     * Returns the slot of the core the thread runs on
+     * @param - none
+     * @return - the slot
+     */
+    static int current_slot();
+
+    /*
+     * The internal fields of RWLock:
+     *   The number of readers in every slot
+     *   Mutex taken by the writers, so only one of them waits for the readers at a time
+     *   Whether a writer holds the lock or waits for the readers
+     *   The thread holding the lock for writing, and the number of times it locked it
+     */
+    ReaderSlot m_slots[NUM_SLOTS];
+    std::mutex m_writers;
+    std::atomic<bool> m_writing;
+    std::atomic<std::thread::id> m_owner;
+    int m_depth;
+
+};
+
+/*
+* Class ReadGuard
+* This class is used to unlock an RWLock for reading once the scope it was locked in ends.
+*/
+class ReadGuard {
+public:
+
+    /*
+    * Constructor of ReadGuard class
+    * @param - the lock, and the reader slot it was locked with
+    * @return - A new instance of ReadGuard
+    */
+    ReadGuard(RWLock& lock, const int slot);
+
+    ReadGuard(const ReadGuard& other) = delete;
+    ReadGuard& operator=(const ReadGuard& other) = delete;
+
+    /*
+    * Destructor of ReadGuard class - unlocks the lock
+    * @param - none
+    * @return - void
+    */
+    ~ReadGuard();
+
+    /*
+    * Unlock the lock before the scope ends
+    * @param - none
+    * @return - void
+    */
+    void release();
+
+private:
+
+    RWLock& m_lock;
+    int m_slot;
+    bool m_locked;
+
+};
+
+/*
+* Class WriteGuard
+* This class is used to lock an RWLock for writing until the scope it was created in ends.
+*/
+class WriteGuard {
+public:
+
+    /*
+    * Constructor of WriteGuard class - locks the lock
+    * @param - the lock
+    * @return - A new instance of WriteGuard
+    */
+    explicit WriteGuard(RWLock& lock);
+
+    WriteGuard(const WriteGuard& other) = delete;
+    WriteGuard& operator=(const WriteGuard& other) = delete;
+
+    /*
+    * Destructor of WriteGuard class - unlocks the lock
+    * @param - none
+    * @return - void
+    */
+    ~WriteGuard();
+
+private:
+
+    RWLock& m_lock;
+
+};
+
+#endif //WORLD_CUP_SYSTEM_RWLOCK_H
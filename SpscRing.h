@@ -0,0 +1,134 @@
+#ifndef WORLD_CUP_SYSTEM_SPSCRING_H
+#define WORLD_CUP_SYSTEM_SPSCRING_H
+
+#include <atomic>
+#include <thread>
+
+/*
+* Class SpscRing
+* This class is used to pass items from one thread to another, in order, without locks.
+* The items are kept in a ring whose size is a power of two. The producer only writes the tail and the consumer only
+* writes the head, and each of them keeps its own copy of the other index, which it reads again only once the ring
+* looks full (or empty) - so the two threads rarely touch the same cache line.
+* Exactly one thread may push and exactly one thread may pop.
+*/
+template <class T>
+class SpscRing {
+public:
+
+    /*
+    * Constructor of SpscRing class
+    * @param - the minimal number of items the ring holds, rounded up to a power of two
+    * @return - A new instance of SpscRing
+    */
+    explicit SpscRing(const int capacity);
+
+    /*
+    * Copy Constructor and Assignment Operator of SpscRing class
+    * The threads using a ring cannot be copied.
+    */
+    SpscRing(const SpscRing& other) = delete;
+    SpscRing& operator=(const SpscRing& other) = delete;
+
+    /*
+    * Destructor of SpscRing class
+    * @param - none
+    * @return - void
+    */
+    ~SpscRing();
+
+    /*
+    * Add an item at the tail of the ring, waiting while the ring is full - called by the producer only
+    * @param - the item
+    * @return - void
+    */
+    void push(const T& item);
+
+    /*
+    * Remove the item at the head of the ring, waiting while the ring is empty - called by the consumer only
+    * @param - where the item is stored
+    * @return - void
+    */
+    void pop(T& item);
+
+private:
+
+    /*
+     * The internal fields of SpscRing:
+     *   The items, and the mask of an index into them (the size of the ring - 1)
+     *   The tail, written by the producer, and the head as the producer last read it
+     *   The head, written by the consumer, and the tail as the consumer last read it
+     * The fields of the producer and of the consumer are padded to separate cache lines.
+     */
+    T* m_items;
+    unsigned int m_mask;
+    char m_padding1[64];
+    std::atomic<unsigned int> m_tail;
+    unsigned int m_cachedHead;
+    char m_padding2[64];
+    std::atomic<unsigned int> m_head;
+    unsigned int m_cachedTail;
+    char m_padding3[64];
+
+};
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+template <class T>
+SpscRing<T>::SpscRing(const int capacity) :
+    m_items(nullptr),
+    m_mask(0),
+    m_tail(0),
+    m_cachedHead(0),
+    m_head(0),
+    m_cachedTail(0)
+{
+    unsigned int size = 1;
+    while (size < static_cast<unsigned int>(capacity)) {
+        size *= 2;
+    }
+    m_items = new T[size];
+    m_mask = size - 1;
+}
+
+
+template <class T>
+SpscRing<T>::~SpscRing()
+{
+    delete[] m_items;
+}
+
+
+//---------------------------------------------------Push and Pop---------------------------------------------------
+
+template <class T>
+void SpscRing<T>::push(const T& item)
+{
+    unsigned int tail = m_tail.load(std::memory_order_relaxed);
+    //The indexes only grow, so the ring is full once the tail is a whole ring ahead of the head
+    while (tail - m_cachedHead > m_mask) {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if (tail - m_cachedHead > m_mask) {
+            std::this_thread::yield();
+        }
+    }
+    m_items[tail & m_mask] = item;
+    m_tail.store(tail + 1, std::memory_order_release);
+}
+
+
+template <class T>
+void SpscRing<T>::pop(T& item)
+{
+    unsigned int head = m_head.load(std::memory_order_relaxed);
+    while (head == m_cachedTail) {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cachedTail) {
+            std::this_thread::yield();
+        }
+    }
+    item = m_items[head & m_mask];
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+#endif //WORLD_CUP_SYSTEM_SPSCRING_H
@@ -0,0 +1,64 @@
+#include "TeamSummary.h"
+#include "Teams.h"
+#include <climits>
+
+//--------------------------------------------Constructors---------------------------------------------------
+
+TeamSummary::TeamSummary() :
+    m_count(0)
+{
+    for (int i = 0; i < NUM_STATS; i++) {
+        m_sum[i] = 0;
+        m_min[i] = INT_MAX;
+        m_max[i] = INT_MIN;
+    }
+}
+
+
+TeamSummary::TeamSummary(const Team* team) :
+    m_count(1)
+{
+    m_sum[(int) TeamStat::POINTS] = team->get_points();
+    m_sum[(int) TeamStat::GOALS] = team->get_goals();
+    m_sum[(int) TeamStat::CARDS] = team->get_cards();
+    m_sum[(int) TeamStat::PLAYERS] = team->get_num_players();
+    for (int i = 0; i < NUM_STATS; i++) {
+        m_min[i] = m_sum[i];
+        m_max[i] = m_sum[i];
+    }
+}
+
+
+//-----------------------------------------------Summary Functions---------------------------------------------
+
+void TeamSummary::combine(const TeamSummary& other)
+{
+    m_count += other.m_count;
+    for (int i = 0; i < NUM_STATS; i++) {
+        m_sum[i] += other.m_sum[i];
+        if (other.m_min[i] < m_min[i]) {
+            m_min[i] = other.m_min[i];
+        }
+        if (other.m_max[i] > m_max[i]) {
+            m_max[i] = other.m_max[i];
+        }
+    }
+}
+
+
+int TeamSummary::get_count() const
+{
+    return m_count;
+}
+
+
+int TeamSummary::get(const TeamStat stat, const SummaryType type) const
+{
+    if (type == SummaryType::MIN) {
+        return m_min[(int) stat];
+    }
+    if (type == SummaryType::MAX) {
+        return m_max[(int) stat];
+    }
+    return m_sum[(int) stat];
+}
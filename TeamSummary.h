@@ -0,0 +1,96 @@
+#ifndef WORLD_CUP_SYSTEM_TEAMSUMMARY_H
+#define WORLD_CUP_SYSTEM_TEAMSUMMARY_H
+
+class Team;
+
+/*
+* The stats of a team that can be summarized over a range of teams
+*/
+enum struct TeamStat {
+    POINTS  = 0,
+    GOALS   = 1,
+    CARDS   = 2,
+    PLAYERS = 3,
+};
+
+/*
+* The ways a stat can be summarized over a range of teams
+*/
+enum struct SummaryType {
+    SUM = 0,
+    MIN = 1,
+    MAX = 2,
+};
+
+/*
+* Class TeamSummary
+* This class is used to hold the sum, minimum and maximum of each team stat over a group of teams.
+* Summaries of two disjoint groups can be combined into the summary of their union, which allows every node of the
+* teams tree to hold the summary of its subtree.
+*/
+class TeamSummary {
+public:
+
+    /*
+    * Constructor of TeamSummary class - the summary of an empty group of teams
+    * @param - none
+    * @return - A new instance of TeamSummary
+    */
+    TeamSummary();
+
+    /*
+    * Constructor of TeamSummary class - the summary of a single team
+    * @param - a pointer to the team
+    * @return - A new instance of TeamSummary
+    */
+    explicit TeamSummary(const Team* team);
+
+    /*
+    * Copy Constructor, Assignment Operator and Destructor of TeamSummary class
+    * TeamSummary only holds numerical fields, so the default ones are used.
+    */
+    TeamSummary(const TeamSummary& other) = default;
+    TeamSummary& operator=(const TeamSummary& other) = default;
+    ~TeamSummary() = default;
+
+    /*
+    * Add the teams of another summary to this summary
+    * @param - the summary of a group of teams disjoint from this one
+    * @return - void
+    */
+    void combine(const TeamSummary& other);
+
+    /*
+    * Return the number of teams in the summary
+    * @param - none
+    * @return - the number of teams
+    */
+    int get_count() const;
+
+    /*
+    * Return the sum, minimum or maximum of a stat over the teams in the summary
+    * @param - the requested stat and the way it is summarized
+    * @return - the requested value
+    */
+    int get(const TeamStat stat, const SummaryType type) const;
+
+private:
+
+    /*
+     * The number of different stats held by the summary
+     */
+    static const int NUM_STATS = 4;
+
+    /*
+     * The internal fields of TeamSummary:
+     *   The number of teams in the summary
+     *   The sum, minimum and maximum of each stat, indexed by TeamStat
+     */
+    int m_count;
+    int m_sum[NUM_STATS];
+    int m_min[NUM_STATS];
+    int m_max[NUM_STATS];
+
+};
+
+#endif //WORLD_CUP_SYSTEM_TEAMSUMMARY_H
@@ -14,7 +14,9 @@ Team::Team(const int teamID, const int points) :
         m_playersByScore(),
         m_topScorer(nullptr),
         m_closestTeamRight(nullptr),
-        m_closestTeamLeft(nullptr)
+        m_closestTeamLeft(nullptr),
+        m_lock(),
+        m_sequence(0)
 {}
 
 
@@ -30,18 +32,20 @@ Team::Team() :
         m_playersByScore(),
         m_topScorer(nullptr),
         m_closestTeamRight(nullptr),
-        m_closestTeamLeft(nullptr)
+        m_closestTeamLeft(nullptr),
+        m_lock(),
+        m_sequence(0)
 {}
 
 
 Team& Team::operator=(const Team& other) {
     m_id = other.m_id;
     m_numCards = other.m_numCards;
-    m_numGames = other.m_numGames;
+    m_numGames = other.m_numGames.load();
     m_numGoalkeepers = other.m_numGoalkeepers;
     m_numGoals = other.m_numGoals;
-    m_numPlayers = other.m_numPlayers;
-    m_points = other.m_points;
+    m_numPlayers = other.m_numPlayers.load();
+    m_points = other.m_points.load();
     m_closestTeamRight = nullptr;
     m_closestTeamLeft = nullptr;
     m_topScorer = nullptr;
@@ -78,6 +82,10 @@ int Team::get_games() const {
     return m_numGames;
 }
 
+int Team::get_strength() const {
+    return m_points + m_numGoals - m_numCards;
+}
+
 const Player* Team::get_top_scorer() const {
     return m_topScorer;
 }
@@ -94,6 +102,36 @@ Team* Team::get_closest_right() {
     return m_closestTeamRight;
 }
 
+std::mutex& Team::get_lock() {
+    return m_lock;
+}
+
+void Team::begin_update() {
+    m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    //The counters may not be changed before the readers can see the sequence is odd
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void Team::end_update() {
+    m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+TeamCounters Team::get_counters() const {
+    TeamCounters counters;
+    unsigned int before;
+    unsigned int after;
+    do {
+        before = m_sequence.load(std::memory_order_acquire);
+        counters.m_points = m_points.load(std::memory_order_relaxed);
+        counters.m_games = m_numGames.load(std::memory_order_relaxed);
+        counters.m_players = m_numPlayers.load(std::memory_order_relaxed);
+        //The counters must be read before the sequence is checked again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = m_sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+    return counters;
+}
+
 
 //-------------------------------------Update Stats Functions----------------------------
 
@@ -120,6 +158,10 @@ void Team::update_points_tie() {
     m_points += 1;
 }
 
+void Team::add_points(const int points) {
+    m_points += points;
+}
+
 void Team::update_num_goals(const int goals) {
     m_numGoals += goals;
 }
@@ -142,7 +184,7 @@ void Team::update_closest_left(Team* team1) {
 
 //-------------------------------------Helper Functions for WorldCup----------------------------
 
-StatusType Team::add_player(Player* player, const int id, const int goals, const int cards, const bool goalkeeper){
+StatusType Team::insert_player(Player* player, const int id, const int goals, const int cards){
     try {
         m_playersByID.insert(player, id);
         m_playersByScore.insert(player, id, goals, cards);
@@ -150,14 +192,18 @@ StatusType Team::add_player(Player* player, const int id, const int goals, const
     catch (const InvalidID& e) {
         return StatusType::FAILURE;
     }
+    update_top_player();
+    return StatusType::SUCCESS;
+}
+
+
+void Team::add_player_stats(const int goals, const int cards, const bool goalkeeper){
     update_num_goals(goals);
     update_num_cards(cards);
     m_numPlayers++;
     if (goalkeeper) {
         m_numGoalkeepers++;
     }
-    update_top_player();
-    return StatusType::SUCCESS;
 }
 
 
@@ -173,58 +219,60 @@ void Team::remove_player(const int playerID, const int goals, const int cards, c
 }
 
 
-void Team::remove_player_by_score(const int id, const int goals, const int cards) {
-    m_playersByScore.remove(id, goals, cards);
-}
-
-
-void Team::insert_player_by_score(Player* player, const int id, const int goals, const int cards) {
-    m_playersByScore.insert(player, id, goals, cards);
+void Team::reposition_player_by_score(Player* player, const int goals, const int cards) {
+    if (m_playersByScore.reposition(player->get_playerId(), goals, cards, player->get_goals(), player->get_cards())) {
+        update_top_player();
+    }
 }
 
 
 void Team::update_team_stats(const int goals, const int cards){
     update_num_goals(goals);
     update_num_cards(cards);
-    update_top_player();
 }
 
 
 //--------------------------------unite_teams----------------------------
 
-void Team::unite_teams(Team* team1, Team* team2) {
+void Team::unite_teams(Team* team1, Team* team2, ThreadPool& pool) {
     m_numCards = team1->m_numCards + team2->m_numCards;
     m_numGames = 0;
     m_numGoalkeepers = team1->m_numGoalkeepers + team2->m_numGoalkeepers;
     m_numGoals = team1->m_numGoals + team2->m_numGoals;
     m_numPlayers = team1->m_numPlayers + team2->m_numPlayers;
-    //Create an array of pointers to the players in each team
-    Player** playersID1 = new Player*[team1->m_numPlayers*sizeof(Player*)];
-    Player** playersID2 = new Player*[team2->m_numPlayers*sizeof(Player*)];
-    Player** playersScore1 = new Player*[team1->m_numPlayers*sizeof(Player*)];
-    Player** playersScore2 = new Player*[team2->m_numPlayers*sizeof(Player*)];
-    //Insert the players into the array by inorder walk
-    team1->m_playersByID.m_node->unite_insert(playersID1, 0);
-    team2->m_playersByID.m_node->unite_insert(playersID2, 0);
-    team1->m_playersByScore.m_node->unite_insert(playersScore1, 0);
-    team2->m_playersByScore.m_node->unite_insert(playersScore2, 0);
-    //Create an array of pointers that holds the united teams
-    Player** nPlayersID = new Player*[m_numPlayers*sizeof(Player*)];
-    Player** nPlayersScore = new Player*[m_numPlayers*sizeof(Player*)];
-    //Merge the teams from their separate arrays into the united array
-    mergeByID(nPlayersID, playersID1, playersID2, team1->m_numPlayers, team2->m_numPlayers);
-    delete[] playersID1;
-    delete[] playersID2;
-    mergeByScore(nPlayersScore, playersScore1, playersScore2, team1->m_numPlayers, team2->m_numPlayers);
-    delete[] playersScore1;
-    delete[] playersScore2;
-    //Create a tree from the united array
-    if (m_numPlayers > 0) {
-        m_playersByID.insertInorder(nPlayersID, m_numPlayers-1);
-        m_playersByScore.insertInorder(nPlayersScore, m_numPlayers-1);
-    }
-    delete[] nPlayersID;
-    delete[] nPlayersScore;
+    //The trees by ID and by score share no nodes, so they are merged at the same time
+    pool.parallel_invoke([&]() {
+        //Create an array of pointers to the players in each team
+        Player** playersID1 = new Player*[team1->m_numPlayers];
+        Player** playersID2 = new Player*[team2->m_numPlayers];
+        //Insert the players into the array by inorder walk
+        team1->m_playersByID.m_node->unite_insert(playersID1, 0);
+        team2->m_playersByID.m_node->unite_insert(playersID2, 0);
+        //Create an array of pointers that holds the united teams
+        Player** nPlayersID = new Player*[m_numPlayers];
+        //Merge the teams from their separate arrays into the united array
+        mergeByID(nPlayersID, playersID1, playersID2, team1->m_numPlayers, team2->m_numPlayers);
+        delete[] playersID1;
+        delete[] playersID2;
+        //Create a tree from the united array
+        if (m_numPlayers > 0) {
+            m_playersByID.insertInorder(nPlayersID, m_numPlayers-1, &pool);
+        }
+        delete[] nPlayersID;
+    }, [&]() {
+        Player** playersScore1 = new Player*[team1->m_numPlayers];
+        Player** playersScore2 = new Player*[team2->m_numPlayers];
+        team1->m_playersByScore.m_node->unite_insert(playersScore1, 0);
+        team2->m_playersByScore.m_node->unite_insert(playersScore2, 0);
+        Player** nPlayersScore = new Player*[m_numPlayers];
+        mergeByScore(nPlayersScore, playersScore1, playersScore2, team1->m_numPlayers, team2->m_numPlayers);
+        delete[] playersScore1;
+        delete[] playersScore2;
+        if (m_numPlayers > 0) {
+            m_playersByScore.insertInorder(nPlayersScore, m_numPlayers-1, &pool);
+        }
+        delete[] nPlayersScore;
+    });
     //Update each player's num_games
     team1->m_playersByID.unite_update_games(team1->get_games());
     team2->m_playersByID.unite_update_games(team2->get_games());
@@ -262,7 +310,7 @@ void Team::mergeByScore(Player** nPlayers, Player** players1, Player** players2,
             nPlayers[indexMerged++] = players1[index1++];
         }
         else if (players1[index1]->get_goals() == players2[index2]->get_goals() && players1[index1]->get_cards() ==
-                 players2[index2]->get_cards() && players1[index1]->get_playerId() > players2[index2]->get_playerId()) {
+                 players2[index2]->get_cards() && players1[index1]->get_playerId() < players2[index2]->get_playerId()) {
             nPlayers[indexMerged++] = players1[index1++];
                 }
         else {
@@ -280,8 +328,50 @@ void Team::mergeByScore(Player** nPlayers, Player** players1, Player** players2,
 
 //--------------------------------world_cup Players Functions----------------------------
 
-void Team::get_all_team_players(int* const output) {
-    m_playersByScore.get_all_data(output);
+void Team::get_all_team_players(int* const output, ThreadPool* pool) {
+    m_playersByScore.get_all_data(output, pool);
+}
+
+
+int Team::get_top_team_scorers(int* const output, const int amount) {
+    return m_playersByScore.get_top_data(output, amount);
+}
+
+
+int Team::count_players_by_goals(const int minGoals, const int maxGoals) {
+    return m_playersByScore.count_goals_range(minGoals, maxGoals);
+}
+
+
+int Team::get_players_by_goals(int* const output, const int minGoals, const int maxGoals) {
+    return m_playersByScore.get_goals_range(output, minGoals, maxGoals);
+}
+
+
+int Team::count_players_by_cards(const int cards) {
+    return m_playersByScore.count_above_cards(cards);
+}
+
+
+int Team::get_players_by_cards(int* const output, const int cards) {
+    return m_playersByScore.get_above_cards(output, cards);
+}
+
+
+int Team::get_players_after(int* const output, const int amount, int& goals, int& cards, int& id) {
+    return m_playersByScore.get_data_after(output, amount, goals, cards, id);
+}
+
+
+int Team::get_closest_team_players(int* const output, const int amount, const int playerId) {
+    Player* tmpPlayer = m_playersByID.search_and_return_data(playerId);
+    return m_playersByScore.get_closest_data(output, amount, tmpPlayer->get_goals(), tmpPlayer->get_cards(),
+                                             playerId);
+}
+
+
+int Team::get_closest_team_players(int* const output, const int amount, const int goals, const int cards) {
+    return m_playersByScore.get_closest_data(output, amount, goals, cards, 0);
 }
 
 
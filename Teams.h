@@ -6,9 +6,22 @@ class Player;
 #include "Player.h"
 #include "AVLTree.h"
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include "wet1util.h"
 #include "AVLMultiVariable.h"
 #include "GenericNode.h"
+#include "ThreadPool.h"
+
+/*
+* The counters of a team read together by get_counters: its points, the number of games it played and the number of
+* players it has
+*/
+struct TeamCounters {
+    int m_points;
+    int m_games;
+    int m_players;
+};
 
 /*
 * Class Team
@@ -87,6 +100,13 @@ public:
     */
     int get_games() const;
 
+    /*
+    * Return the team's match strength (points + goals - cards), used to decide the winner of a match
+    * @param - none
+    * @return - the team's match strength
+    */
+    int get_strength() const;
+
     /*
     * Return the team's top player (top scorer)
     * @param - none
@@ -115,6 +135,29 @@ public:
     */
     Team* get_closest_right();
 
+    /*
+    * Return the lock of the team, held while the players of the team or its stats change
+    * @param - none
+    * @return - the lock of the team
+    */
+    std::mutex& get_lock();
+
+    /*
+    * Mark the start and the end of a change of the counters of the team, made while readers may read them - the
+    * changes of a team are made one at a time, while holding the lock of the team
+    * @param - none
+    * @return - void
+    */
+    void begin_update();
+    void end_update();
+
+    /*
+    * Read the counters of the team without any lock, reading them again if they changed while they were read
+    * @param - none
+    * @return - the counters
+    */
+    TeamCounters get_counters() const;
+
     /*
     * Update the team ID of the players in the team
     * @param - a pointer to the team the players now belong to
@@ -150,6 +193,13 @@ public:
     */
     void update_points_tie();
 
+    /*
+    * Adds the points a team was awarded for a match (3 for a win, 1 for a tie, 0 for a loss)
+    * @param - the number of points to be added
+    * @return - void
+    */
+    void add_points(const int points);
+
     /*
     * Increases the number of goals the team has
     * @param - the number of goals to be added
@@ -186,12 +236,14 @@ public:
     void update_closest_left(Team* team1);
 
     /*
-    * Helper function for add_player in world_cup:
-    * Adds the player to the team and updates the team's stats accordingly
+    * Helper functions for add_player in world_cup:
+    * insert_player adds the player to the trees of the team and updates the team's top scorer, and add_player_stats
+    * updates the team's stats accordingly - so the stats may change separately from the trees of the team
     * @param - a pointer to the player to be added, its ID, goals, cards, and whether it is a goalkeeper
-    * @return - StatusType
+    * @return - StatusType / void
     */
-    StatusType add_player(Player* player, const int id, const int goals, const int cards, const bool goalkeeper);
+    StatusType insert_player(Player* player, const int id, const int goals, const int cards);
+    void add_player_stats(const int goals, const int cards, const bool goalkeeper);
 
     /*
     * Helper function for remove_player in world_cup:
@@ -203,19 +255,12 @@ public:
 
     /*
     * Helper function for update_player_stats in world_cup:
-    * Removes a player from the playersByScore tree of its team 
-    * @param - the player's ID, number of goals, and number of cards
+    * Moves an updated player to its new place in the playersByScore tree of its team, and updates the top scorer
+    * of the team if the order of the players changed
+    * @param - a pointer to the updated player, and the player's previous number of goals and cards
     * @return - void
     */
-    void remove_player_by_score(const int id, const int goals, const int cards);
-
-    /*
-    * Helper function for update_player_stats in world_cup:
-    * Inserts a player to the playersByScore tree of its team 
-    * @param - a pointer to the updated player, the player's ID, number of goals, and number of cards
-    * @return - void
-    */
-    void insert_player_by_score(Player* player, const int id, const int goals, const int cards);
+    void reposition_player_by_score(Player* player, const int goals, const int cards);
 
     /*
     * Helper function for update_player_stats in world_cup:
@@ -227,11 +272,12 @@ public:
 
     /*
     * Helper function for unite_teams in world_cup:
-    * Updates the new team's total numerical fields and merges the trees of the players in the previous teams
-    * @param - pointers to the previous teams
+    * Updates the new team's total numerical fields and merges the trees of the players in the previous teams - the
+    * trees by ID and by score are merged at the same time by the pool
+    * @param - pointers to the previous teams, the pool
     * @return - void
     */
-    void unite_teams(Team* team1, Team* team2);
+    void unite_teams(Team* team1, Team* team2, ThreadPool& pool);
 
     /*
     * Helper function for unite_teams in world_cup:
@@ -251,11 +297,53 @@ public:
 
     /*
     * Helper function for get_all_players in world_cup:
-    * Inserts all of the players into a given array
-    * @param - a pointer to the first term in an array
+    * Inserts all of the players into a given array, filling the ranges of large subtrees in parallel
+    * @param - a pointer to the first term in an array, and the pool
     * @return - void
     */
-    void get_all_team_players(int* const output);
+    void get_all_team_players(int* const output, ThreadPool* pool);
+
+    /*
+    * Helper function for get_top_scorers in world_cup:
+    * Inserts the ID's of the team's top scorers into a given array, starting with the top scorer
+    * @param - a pointer to the first term in an array, the maximum number of players to insert
+    * @return - the number of players inserted
+    */
+    int get_top_team_scorers(int* const output, const int amount);
+
+    /*
+    * Helper functions for the player range queries in world_cup:
+    * Count the team's players with a number of goals in a given range / with more than a given number of cards,
+    * or insert their ID's into a given array, sorted by goals, cards, and ID
+    * @param - the range of goals / the number of cards, and the array for the get functions
+    * @return - the number of players found
+    */
+    int count_players_by_goals(const int minGoals, const int maxGoals);
+    int get_players_by_goals(int* const output, const int minGoals, const int maxGoals);
+    int count_players_by_cards(const int cards);
+    int get_players_by_cards(int* const output, const int cards);
+
+    /*
+    * Helper function for get_players_chunk in world_cup:
+    * Inserts the ID's of the team's players that come after the given goals, cards, and ID into a given array,
+    * sorted by goals, cards, and ID
+    * @param - the array, the maximum number of players to insert, and the goals, cards, and ID to start after, which
+    *       are set to those of the last player inserted
+    * @return - the number of players inserted
+    */
+    int get_players_after(int* const output, const int amount, int& goals, int& cards, int& id);
+
+    /*
+    * Helper functions for get_closest_players in world_cup:
+    * Insert the ID's of the team's players closest to one of its players / to given goals and cards into a given
+    * array, starting with the closest
+    * @param - a pointer to the first term in an array, the maximum number of players to insert, and the player's ID /
+    *       the goals and cards
+    * @return - the number of players inserted
+    * @throw - NodeNotFound if the player is not in the team
+    */
+    int get_closest_team_players(int* const output, const int amount, const int playerId);
+    int get_closest_team_players(int* const output, const int amount, const int goals, const int cards);
 
     /*
     * Helper function for get_closest_player in world_cup:
@@ -306,19 +394,23 @@ private:
      *   An AVL tree of the team's players organized by their scores, cards, and ID numbers
      *   A pointer to the team's top scorer
      *   A pointer to the closest left and closest right teams, according to their ID's
+     *   The lock of the team
+     *   The sequence of the changes of the counters - odd while a change is in progress
      */
     int m_id;
-    int m_points;
-    int m_numPlayers;
+    std::atomic<int> m_points;
+    std::atomic<int> m_numPlayers;
     int m_numGoalkeepers;
     int m_numGoals;
     int m_numCards;
-    int m_numGames;
+    std::atomic<int> m_numGames;
     Tree<GenericNode<Player*>, Player*> m_playersByID;
     MultiTree<Player*> m_playersByScore;
     Player* m_topScorer;
     Team* m_closestTeamRight;
     Team* m_closestTeamLeft;
+    std::mutex m_lock;
+    std::atomic<unsigned int> m_sequence;
 
 };
 
@@ -0,0 +1,305 @@
+#include "ThreadPool.h"
+
+//The pool the current thread belongs to (or is a guest of), and the index of its deque
+static thread_local const ThreadPool* t_pool = nullptr;
+static thread_local int t_worker = 0;
+
+//The number of threads outside the pool that may fork work into it at the same time
+static const int NUM_GUESTS = 8;
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+ThreadPool::ThreadPool(const int numThreads) :
+    m_numThreads(1),
+    m_threads(nullptr),
+    m_workers(nullptr),
+    m_numWorkers(0),
+    m_pending(0),
+    m_stopping(false),
+    m_sleepLock(),
+    m_wake()
+{
+    start(numThreads);
+}
+
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+
+//------------------------------------------------------Size--------------------------------------------------------
+
+void ThreadPool::resize(const int numThreads)
+{
+    stop();
+    start(numThreads);
+}
+
+
+int ThreadPool::get_num_threads() const
+{
+    return m_numThreads;
+}
+
+
+//---------------------------------------------------Fork and Join--------------------------------------------------
+
+void ThreadPool::parallel_invoke(const std::function<void()>& first, const std::function<void()>& second)
+{
+    if (m_numThreads == 1) {
+        run_inline(first, second);
+        return;
+    }
+    if (t_pool == this) {
+        fork_join(first, second);
+        return;
+    }
+    int guest = claim_guest();
+    if (guest == -1) {
+        run_inline(first, second);
+        return;
+    }
+    //The thread may belong to another pool, which it goes back to once the work is done
+    const ThreadPool* previousPool = t_pool;
+    int previousWorker = t_worker;
+    t_pool = this;
+    t_worker = guest;
+    try {
+        fork_join(first, second);
+    }
+    catch (...) {
+        t_pool = previousPool;
+        t_worker = previousWorker;
+        release_guest(guest);
+        throw;
+    }
+    t_pool = previousPool;
+    t_worker = previousWorker;
+    release_guest(guest);
+}
+
+
+//------------------------------------------------Helper Functions-------------------------------------------------
+
+void ThreadPool::fork_join(const std::function<void()>& first, const std::function<void()>& second)
+{
+    Task task;
+    task.m_work = &second;
+    task.m_done.store(false);
+    push(&task);
+    std::exception_ptr error;
+    try {
+        first();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    if (take_back(&task)) {
+        execute(&task);
+    }
+    else {
+        //Another thread took the task - help with the rest of the work until it is done. A guest only runs its own
+        //tasks, so it never waits for the work of another caller
+        int index = current_worker();
+        bool steal = !is_guest(index);
+        while (!task.m_done.load(std::memory_order_acquire)) {
+            if (!run_one(index, steal)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (task.m_error) {
+        std::rethrow_exception(task.m_error);
+    }
+}
+
+
+void ThreadPool::run_inline(const std::function<void()>& first, const std::function<void()>& second)
+{
+    std::exception_ptr error;
+    try {
+        first();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    //As in fork_join, the exception of the first function is the one thrown if both of them throw
+    try {
+        second();
+    }
+    catch (...) {
+        if (!error) {
+            throw;
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+int ThreadPool::claim_guest()
+{
+    for (int i = m_numThreads - 1; i < m_numWorkers; i++) {
+        bool expected = false;
+        if (m_workers[i].m_claimed.compare_exchange_strong(expected, true)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+void ThreadPool::release_guest(const int index)
+{
+    m_workers[index].m_claimed.store(false);
+}
+
+void ThreadPool::start(const int numThreads)
+{
+    m_numThreads = (numThreads < 1) ? 1 : numThreads;
+    m_stopping = false;
+    if (m_numThreads == 1) {
+        return;
+    }
+    try {
+        m_numWorkers = m_numThreads - 1 + NUM_GUESTS;
+        m_workers = new Worker[m_numWorkers];
+        m_threads = new std::thread[m_numThreads - 1];
+        for (int i = 0; i < m_numThreads - 1; i++) {
+            m_threads[i] = std::thread(&ThreadPool::run, this, i);
+        }
+    }
+    catch (...) {
+        //Stop the threads that did start, leaving a pool of a single thread
+        stop();
+        throw;
+    }
+}
+
+
+void ThreadPool::stop()
+{
+    if (m_numThreads > 1) {
+        {
+            std::lock_guard<std::mutex> guard(m_sleepLock);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (int i = 0; m_threads != nullptr && i < m_numThreads - 1; i++) {
+            if (m_threads[i].joinable()) {
+                m_threads[i].join();
+            }
+        }
+    }
+    delete[] m_threads;
+    delete[] m_workers;
+    m_threads = nullptr;
+    m_workers = nullptr;
+    m_numWorkers = 0;
+    m_numThreads = 1;
+}
+
+
+void ThreadPool::run(const int index)
+{
+    t_pool = this;
+    t_worker = index;
+    while (true) {
+        if (run_one(index, true)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepLock);
+        m_wake.wait(lock, [this]() { return m_stopping || m_pending.load() > 0; });
+        if (m_stopping && m_pending.load() == 0) {
+            return;
+        }
+    }
+}
+
+
+bool ThreadPool::run_one(const int index, const bool steal)
+{
+    Task* task = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(m_workers[index].m_lock);
+        if (!m_workers[index].m_tasks.empty()) {
+            task = m_workers[index].m_tasks.back();
+            m_workers[index].m_tasks.pop_back();
+        }
+    }
+    for (int i = 1; steal && task == nullptr && i < m_numWorkers; i++) {
+        Worker& victim = m_workers[(index + i) % m_numWorkers];
+        std::lock_guard<std::mutex> guard(victim.m_lock);
+        if (!victim.m_tasks.empty()) {
+            task = victim.m_tasks.front();
+            victim.m_tasks.pop_front();
+        }
+    }
+    if (task == nullptr) {
+        return false;
+    }
+    m_pending.fetch_sub(1);
+    execute(task);
+    return true;
+}
+
+
+void ThreadPool::push(Task* task)
+{
+    Worker& worker = m_workers[current_worker()];
+    {
+        std::lock_guard<std::mutex> guard(worker.m_lock);
+        worker.m_tasks.push_back(task);
+    }
+    //Counted while holding the lock the idle threads sleep on, so none of them misses the task
+    {
+        std::lock_guard<std::mutex> guard(m_sleepLock);
+        m_pending.fetch_add(1);
+    }
+    m_wake.notify_one();
+}
+
+
+bool ThreadPool::take_back(Task* task)
+{
+    Worker& worker = m_workers[current_worker()];
+    std::lock_guard<std::mutex> guard(worker.m_lock);
+    //The task is the newest of the deque, unless it was stolen
+    if (worker.m_tasks.empty() || worker.m_tasks.back() != task) {
+        return false;
+    }
+    worker.m_tasks.pop_back();
+    m_pending.fetch_sub(1);
+    return true;
+}
+
+
+void ThreadPool::execute(Task* task)
+{
+    try {
+        (*task->m_work)();
+    }
+    catch (...) {
+        task->m_error = std::current_exception();
+    }
+    //The task may be freed by its owner as soon as it is marked as done
+    task->m_done.store(true, std::memory_order_release);
+}
+
+
+int ThreadPool::current_worker() const
+{
+    return t_worker;
+}
+
+
+bool ThreadPool::is_guest(const int index) const
+{
+    return index >= m_numThreads - 1;
+}
@@ -0,0 +1,166 @@
+#ifndef WORLD_CUP_SYSTEM_THREADPOOL_H
+#define WORLD_CUP_SYSTEM_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/*
+* Class ThreadPool
+* This class is used to run independent parts of a heavy operation of world_cup on several threads.
+* Work is split by fork and join: parallel_invoke runs two functions, possibly at the same time, and returns once both
+* are done. Every thread of the pool keeps a deque of the tasks it forked - it takes back its newest task, while idle
+* threads steal the oldest task of another thread, which is usually the largest part of the work left.
+* A thread waiting for a task to be done runs other tasks in the meantime, so forks may be nested freely.
+* A thread outside the pool claims a guest deque of its own for the duration of its fork, so callers never wait for
+* the work of one another - while waiting, a guest only runs the tasks of its own deque. If all of the guest deques
+* are taken, the caller runs both functions inline. A pool of a single thread starts no threads, and runs everything
+* inline, in order.
+*/
+class ThreadPool {
+public:
+
+    /*
+    * Constructor of ThreadPool class
+    * @param - the number of threads, including the thread that forks the work
+    * @return - A new instance of ThreadPool
+    */
+    explicit ThreadPool(const int numThreads = 1);
+
+    /*
+    * Copy Constructor and Assignment Operator of ThreadPool class
+    * The threads of a pool cannot be copied.
+    */
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    /*
+    * Destructor of ThreadPool class - stops the threads of the pool
+    * @param - none
+    * @return - void
+    */
+    ~ThreadPool();
+
+    /*
+    * Change the number of threads - no work may be running in the pool. If the threads cannot be started, the pool
+    * is left with a single thread and the exception is thrown.
+    * @param - the number of threads, including the thread that forks the work
+    * @return - void
+    */
+    void resize(const int numThreads);
+
+    /*
+    * Return the number of threads of the pool
+    * @param - none
+    * @return - the number of threads
+    */
+    int get_num_threads() const;
+
+    /*
+    * Run two functions, possibly at the same time, and wait until both are done. If either of them throws, the
+    * exception is thrown once both are done.
+    * @param - the functions
+    * @return - void
+    */
+    void parallel_invoke(const std::function<void()>& first, const std::function<void()>& second);
+
+    /*
+    * Run body(i) for every i in [first, last), splitting the range in halves until the parts are at most grain long
+    * @param - the range, the length of the parts run by a single task, and the function
+    * @return - void
+    */
+    template <class F>
+    void parallel_for(const int first, const int last, const int grain, const F& body);
+
+private:
+
+    /*
+     * A forked function, whether it is done, and the exception it threw
+     */
+    struct Task {
+        const std::function<void()>* m_work;
+        std::atomic<bool> m_done;
+        std::exception_ptr m_error;
+    };
+
+    /*
+     * The deque of a thread of the pool or of a guest, the lock guarding it, and whether a guest claimed it
+     */
+    struct Worker {
+        Worker() : m_lock(), m_tasks(), m_claimed(false) {}
+        std::mutex m_lock;
+        std::deque<Task*> m_tasks;
+        std::atomic<bool> m_claimed;
+    };
+
+    /*
+     * Helper functions for the threads of the pool:
+     * start / stop: start the threads of the pool, and stop them once no work is left.
+     * run: the loop of a thread of the pool - runs tasks, and sleeps while there are none.
+     * run_one: runs a single task - the newest task of the given deque, or else (if steal is true) the oldest task
+     *      of another deque. Returns false if there were no tasks.
+     * fork_join: runs the two functions of parallel_invoke, forking the second one into the deque of the current
+     *      thread.
+     * run_inline: runs the two functions of parallel_invoke one after the other on the current thread - the second
+     *      one runs even if the first one throws.
+     * claim_guest / release_guest: claims a free guest deque for a thread outside the pool, and frees it again -
+     *      claim_guest returns -1 if all of them are taken.
+     * push: forks a task into the deque of the current thread.
+     * take_back: removes a task from the deque of the current thread if no other thread took it yet.
+     * execute: runs a task, recording the exception it threw, and marks it as done.
+     * current_worker: returns the deque of the current thread, which is either a thread of the pool or a guest.
+     * is_guest: checks whether a deque is a guest deque.
+     */
+    void start(const int numThreads);
+    void stop();
+    void run(const int index);
+    bool run_one(const int index, const bool steal);
+    void fork_join(const std::function<void()>& first, const std::function<void()>& second);
+    void run_inline(const std::function<void()>& first, const std::function<void()>& second);
+    int claim_guest();
+    void release_guest(const int index);
+    void push(Task* task);
+    bool take_back(Task* task);
+    static void execute(Task* task);
+    int current_worker() const;
+    bool is_guest(const int index) const;
+
+    /*
+     * The internal fields of ThreadPool:
+     *   The number of threads, and the threads started by the pool (all but the one that forks the work)
+     *   The deques - one for every thread started by the pool, followed by the guest deques - and their number
+     *   The number of tasks in the deques
+     *   Whether the threads should stop, and the lock and condition the idle threads sleep on
+     */
+    int m_numThreads;
+    std::thread* m_threads;
+    Worker* m_workers;
+    int m_numWorkers;
+    std::atomic<int> m_pending;
+    bool m_stopping;
+    std::mutex m_sleepLock;
+    std::condition_variable m_wake;
+
+};
+
+//-------------------------------------------------Template Functions----------------------------------------------
+
+template <class F>
+void ThreadPool::parallel_for(const int first, const int last, const int grain, const F& body)
+{
+    if (m_numThreads == 1 || last - first <= grain) {
+        for (int i = first; i < last; i++) {
+            body(i);
+        }
+        return;
+    }
+    int middle = first + (last - first) / 2;
+    parallel_invoke([&]() { parallel_for(first, middle, grain, body); },
+                    [&]() { parallel_for(middle, last, grain, body); });
+}
+
+#endif //WORLD_CUP_SYSTEM_THREADPOOL_H
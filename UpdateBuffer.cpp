@@ -0,0 +1,110 @@
+#include "UpdateBuffer.h"
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+UpdateBuffer::UpdateBuffer() :
+    m_deltas(new Tree<GenericNode<PlayerDelta*>, PlayerDelta*>()),
+    m_maxPending(0),
+    m_maxDelayMs(0),
+    m_oldest()
+{}
+
+
+UpdateBuffer::~UpdateBuffer()
+{
+    if (m_deltas->get_size() > 0) {
+        m_deltas->erase_data(m_deltas->m_node);
+    }
+    delete m_deltas;
+}
+
+
+//-----------------------------------------------Buffer Settings----------------------------------------------
+
+void UpdateBuffer::set_limits(const int maxPending, const int maxDelayMs)
+{
+    m_maxPending = maxPending;
+    m_maxDelayMs = maxDelayMs;
+}
+
+
+bool UpdateBuffer::is_enabled() const
+{
+    return m_maxPending > 0;
+}
+
+
+int UpdateBuffer::get_size() const
+{
+    return m_deltas->get_size();
+}
+
+
+//-----------------------------------------------Buffer Functions---------------------------------------------
+
+void UpdateBuffer::add(Player* player, const int gamesPlayed, const int goals, const int cards)
+{
+    PlayerDelta** found = m_deltas->find_data(player->get_playerId());
+    PlayerDelta* delta;
+    if (found != nullptr) {
+        delta = *found;
+    }
+    else {
+        delta = new PlayerDelta();
+        delta->m_player = player;
+        delta->m_gamesPlayed = 0;
+        delta->m_goals = 0;
+        delta->m_cards = 0;
+        try {
+            m_deltas->insert(delta, player->get_playerId());
+        }
+        catch (const std::bad_alloc& e) {
+            delete delta;
+            throw e;
+        }
+        if (m_deltas->get_size() == 1) {
+            m_oldest = std::chrono::steady_clock::now();
+        }
+    }
+    delta->m_gamesPlayed += gamesPlayed;
+    delta->m_goals += goals;
+    delta->m_cards += cards;
+}
+
+
+bool UpdateBuffer::is_full() const
+{
+    if (m_deltas->get_size() == 0) {
+        return false;
+    }
+    if (m_deltas->get_size() >= m_maxPending) {
+        return true;
+    }
+    return m_maxDelayMs > 0 && std::chrono::steady_clock::now() - m_oldest >= std::chrono::milliseconds(m_maxDelayMs);
+}
+
+
+int UpdateBuffer::release(PlayerDelta* output)
+{
+    int size = m_deltas->get_size();
+    if (size == 0) {
+        return 0;
+    }
+    PlayerDelta** deltas = new PlayerDelta*[size];
+    m_deltas->m_node->unite_insert(deltas, 0);
+    for (int i = 0; i < size; i++) {
+        output[i] = *deltas[i];
+    }
+    delete[] deltas;
+    clear();
+    return size;
+}
+
+
+void UpdateBuffer::clear()
+{
+    Tree<GenericNode<PlayerDelta*>, PlayerDelta*>* empty = new Tree<GenericNode<PlayerDelta*>, PlayerDelta*>();
+    m_deltas->erase_data(m_deltas->m_node);
+    delete m_deltas;
+    m_deltas = empty;
+}
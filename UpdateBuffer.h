@@ -0,0 +1,115 @@
+#ifndef WORLD_CUP_SYSTEM_UPDATEBUFFER_H
+#define WORLD_CUP_SYSTEM_UPDATEBUFFER_H
+
+#include "Player.h"
+#include "AVLTree.h"
+#include "GenericNode.h"
+#include <chrono>
+
+/*
+* The changes to the stats of a single player that were not applied to the system yet
+*/
+struct PlayerDelta {
+    Player* m_player;
+    int m_gamesPlayed;
+    int m_goals;
+    int m_cards;
+};
+
+/*
+* Class UpdateBuffer
+* This class is used to hold the player stat updates of world_cup that were not applied yet.
+* Updates of the same player are coalesced into a single delta, and the buffer reports when it needs to be flushed -
+* once it holds too many players, or once its oldest update waited longer than the time budget.
+* The time budget is checked whenever the buffer is used, as the system does not run a timer of its own.
+*/
+class UpdateBuffer {
+public:
+
+    /*
+    * Constructor of UpdateBuffer class - the buffer starts disabled
+    * @param - none
+    * @return - A new instance of UpdateBuffer
+    */
+    UpdateBuffer();
+
+    /*
+    * Copy Constructor and Assignment Operator of UpdateBuffer class
+    * The buffer holds updates of players owned by world_cup, so it cannot be copied.
+    */
+    UpdateBuffer(const UpdateBuffer& other) = delete;
+    UpdateBuffer& operator=(const UpdateBuffer& other) = delete;
+
+    /*
+    * Destructor of UpdateBuffer class
+    * @param - none
+    * @return - void
+    */
+    ~UpdateBuffer();
+
+    /*
+    * Set the limits of the buffer
+    * @param - the maximum number of players held (0 disables the buffer), and the maximum number of milliseconds
+    *       an update may wait (0 for no time budget)
+    * @return - void
+    */
+    void set_limits(const int maxPending, const int maxDelayMs);
+
+    /*
+    * Return whether updates should be held in the buffer
+    * @param - none
+    * @return - bool, true if the buffer is enabled
+    */
+    bool is_enabled() const;
+
+    /*
+    * Return the number of players with updates in the buffer
+    * @param - none
+    * @return - the number of players
+    */
+    int get_size() const;
+
+    /*
+    * Add an update of a player to the buffer, coalescing it with the previous updates of the player
+    * @param - a pointer to the player, the number of games, goals and cards to be added
+    * @return - void
+    */
+    void add(Player* player, const int gamesPlayed, const int goals, const int cards);
+
+    /*
+    * Return whether the buffer reached its maximum size or its time budget
+    * @param - none
+    * @return - bool, true if the buffer needs to be flushed
+    */
+    bool is_full() const;
+
+    /*
+    * Move all the updates in the buffer into a given array, sorted by the player ID, and empty the buffer
+    * @param - an array with room for get_size() deltas
+    * @return - the number of deltas inserted
+    */
+    int release(PlayerDelta* output);
+
+private:
+
+    /*
+     * Free all the deltas held by the buffer and start a new empty tree
+     * @param - none
+     * @return - void
+     */
+    void clear();
+
+    /*
+     * The internal fields of UpdateBuffer:
+     *   Tree of the pending deltas, sorted by the player ID
+     *   The maximum number of players held, and the maximum number of milliseconds an update may wait
+     *   The time of the oldest update in the buffer
+     */
+    Tree<GenericNode<PlayerDelta*>, PlayerDelta*>* m_deltas;
+    int m_maxPending;
+    int m_maxDelayMs;
+    std::chrono::steady_clock::time_point m_oldest;
+
+};
+
+#endif //WORLD_CUP_SYSTEM_UPDATEBUFFER_H
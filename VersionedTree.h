@@ -0,0 +1,639 @@
+#ifndef WORLD_CUP_SYSTEM_VERSIONEDTREE_H
+#define WORLD_CUP_SYSTEM_VERSIONEDTREE_H
+
+#include <atomic>
+#include "Exception.h"
+#include "EpochManager.h"
+
+/*
+* Class VersionedTree
+* This class is used to let readers walk a stable version of a tree while writers keep changing it.
+* The tree is an AVL tree sorted by the same keys as MultiTree: a primary key, a secondary key (larger first) and an
+* ID. Writers change a working version of the tree, and publish it once their changes are complete. The nodes of a
+* published version are never changed - a writer copies a published node before changing it, so a change copies only
+* the path from the root to the changed node, and the nodes copied or removed are retired once the next version is
+* published. A reader pins an epoch, takes the published root, and walks it without any lock.
+* The writers must change and publish the tree one at a time.
+*/
+template <class T>
+class VersionedTree {
+public:
+
+    /*
+    * A node of the tree - its data, keys, height, the size of its subtree, its children, and the generation of the
+    * working version that created it
+    */
+    struct VersionNode : public EpochManager::Retired {
+        T m_data;
+        int m_id;
+        int m_primary;
+        int m_secondary;
+        int m_height;
+        int m_size;
+        VersionNode* m_left;
+        VersionNode* m_right;
+        unsigned long long m_generation;
+    };
+
+    /*
+    * Constructor of VersionedTree class - an empty tree
+    * @param - the manager of the epochs the nodes are retired in
+    * @return - A new instance of VersionedTree
+    */
+    explicit VersionedTree(EpochManager& epochs);
+
+    /*
+    * Copy Constructor and Assignment Operator of VersionedTree class
+    * Readers may hold the versions of a tree, so it cannot be copied.
+    */
+    VersionedTree(const VersionedTree& other) = delete;
+    VersionedTree& operator=(const VersionedTree& other) = delete;
+
+    /*
+    * Destructor of VersionedTree class - no reader may hold a version of the tree
+    * @param - none
+    * @return - void
+    */
+    ~VersionedTree();
+
+    /*
+    * Replace the working version with the given nodes
+    * @param - the data and the keys of the nodes, sorted by their keys, and the number of nodes
+    * @return - void
+    */
+    void build(const T* data, const int* ids, const int* primary, const int* secondary, const int size);
+
+    /*
+    * Empty the working version
+    * @param - none
+    * @return - void
+    */
+    void clear();
+
+    /*
+    * Insert a new node into the working version - throws InvalidID if a node with the same keys exists
+    * @param - the data and the keys of the node
+    * @return - void
+    */
+    void insert(T data, const int id, const int primary, const int secondary);
+
+    /*
+    * Remove a node from the working version - throws NodeNotFound if there is no node with these keys
+    * @param - the keys of the node
+    * @return - void
+    */
+    void remove(const int id, const int primary, const int secondary);
+
+    /*
+    * Publish the working version, and retire the nodes of the previous version it no longer uses
+    * @param - none
+    * @return - void
+    */
+    void publish();
+
+    /*
+    * Return the root of the published version - the reader must pin an epoch first
+    * @param - none
+    * @return - the root, or nullptr if the published version is empty
+    */
+    const VersionNode* get_published() const;
+
+    /*
+    * Helper functions for the readers of a published version:
+    * get_size: returns the number of nodes in the version.
+    * get_all_ids: inserts the ID's of all the nodes into output, in order, and returns their number.
+    * count_range / get_range: for versions sorted only by ID (both other keys equal), the number of nodes with an ID
+    *       in [minId, maxId], and their ID's and data, in order.
+    */
+    static int get_size(const VersionNode* root);
+    static int get_all_ids(const VersionNode* root, int* const output);
+    static int count_range(const VersionNode* root, const int minId, const int maxId);
+    static int get_range(const VersionNode* root, const int minId, const int maxId, int* const ids, T* const output);
+
+private:
+
+    /*
+     * The maximum height of a tree - enough for any number of nodes an int can count
+     */
+    static const int MAX_HEIGHT = 64;
+
+    /*
+     * Helper functions for the nodes:
+     * reserve: allocates spare nodes until there are enough for any insert or remove, so an insert or remove that
+     *      started never runs out of memory halfway through the path it copies.
+     * create_node: returns a new node of the working version, taken from the spare nodes if there are any.
+     * own: returns a node of the working version that can be changed in place of the given node, copying it into a
+     *      spare node if it belongs to a published version.
+     * discard: frees a node removed from the working version, once no published version uses it.
+     * free_node: frees a retired node.
+     */
+    void reserve();
+    VersionNode* create_node(T data, const int id, const int primary, const int secondary);
+    VersionNode* own(VersionNode* node);
+    void discard(VersionNode* node);
+    static void free_node(EpochManager::Retired* item);
+
+    /*
+     * Helper functions for the shape of the tree:
+     * Return the height and size of a subtree, update those of a node of the working version, and rotate or
+     * rebalance a subtree of the working version, returning its new root
+     */
+    static int height(const VersionNode* node);
+    static void update(VersionNode* node);
+    VersionNode* rotate_left(VersionNode* node);
+    VersionNode* rotate_right(VersionNode* node);
+    VersionNode* rebalance(VersionNode* node);
+
+    /*
+     * Recursive helper functions for build, clear, insert and remove - each returns the new root of the subtree
+     */
+    VersionNode* build_subtree(const T* data, const int* ids, const int* primary, const int* secondary,
+                               const int first, const int last);
+    void clear_subtree(VersionNode* node);
+    VersionNode* insert_node(VersionNode* node, VersionNode* newNode);
+    VersionNode* remove_node(VersionNode* node, const int id, const int primary, const int secondary);
+    VersionNode* remove_min(VersionNode* node, VersionNode** min);
+
+    /*
+     * Return whether the given keys come before the keys of a node, and whether the working version has a node with
+     * the given keys
+     */
+    static bool is_before(const int id, const int primary, const int secondary, const VersionNode* node);
+    bool contains(const int id, const int primary, const int secondary) const;
+
+    /*
+     * Recursive helper functions for the readers
+     */
+    static int count_below(const VersionNode* node, const int id);
+    static int fill_range(const VersionNode* node, const int minId, const int maxId, int* const ids,
+                          T* const output, int index);
+
+    /*
+     * The internal fields of VersionedTree:
+     *   The manager of the epochs the nodes are retired in
+     *   The root of the working version, and of the published version
+     *   The nodes of the published version that the working version no longer uses, waiting to be retired
+     *   The generation of the working version - nodes of older generations belong to a published version
+     *   The spare nodes, linked through their right child, and their number
+     */
+    EpochManager& m_epochs;
+    VersionNode* m_root;
+    std::atomic<VersionNode*> m_published;
+    EpochManager::Retired* m_pending;
+    unsigned long long m_generation;
+    VersionNode* m_spare;
+    int m_numSpare;
+
+};
+
+//--------------------------------------------Constructor and Destructor-------------------------------------------
+
+template <class T>
+VersionedTree<T>::VersionedTree(EpochManager& epochs) :
+    m_epochs(epochs),
+    m_root(nullptr),
+    m_published(nullptr),
+    m_pending(nullptr),
+    m_generation(1),
+    m_spare(nullptr),
+    m_numSpare(0)
+{}
+
+
+template <class T>
+VersionedTree<T>::~VersionedTree()
+{
+    //Every node of the published version is either still in the working version or waiting to be retired
+    clear();
+    while (m_pending != nullptr) {
+        EpochManager::Retired* next = m_pending->m_retiredNext;
+        free_node(m_pending);
+        m_pending = next;
+    }
+    while (m_spare != nullptr) {
+        VersionNode* next = m_spare->m_right;
+        delete m_spare;
+        m_spare = next;
+    }
+}
+
+
+//-------------------------------------------------Writer Functions------------------------------------------------
+
+template <class T>
+void VersionedTree<T>::build(const T* data, const int* ids, const int* primary, const int* secondary,
+                             const int size)
+{
+    VersionNode* root = build_subtree(data, ids, primary, secondary, 0, size - 1);
+    clear();
+    m_root = root;
+}
+
+
+template <class T>
+void VersionedTree<T>::clear()
+{
+    clear_subtree(m_root);
+    m_root = nullptr;
+}
+
+
+template <class T>
+void VersionedTree<T>::insert(T data, const int id, const int primary, const int secondary)
+{
+    if (contains(id, primary, secondary)) {
+        throw InvalidID();
+    }
+    reserve();
+    VersionNode* newNode = create_node(data, id, primary, secondary);
+    m_root = insert_node(m_root, newNode);
+}
+
+
+template <class T>
+void VersionedTree<T>::remove(const int id, const int primary, const int secondary)
+{
+    if (!contains(id, primary, secondary)) {
+        throw NodeNotFound();
+    }
+    reserve();
+    m_root = remove_node(m_root, id, primary, secondary);
+}
+
+
+template <class T>
+void VersionedTree<T>::publish()
+{
+    m_published.store(m_root);
+    //No new reader can reach the nodes the published version stopped using
+    while (m_pending != nullptr) {
+        EpochManager::Retired* next = m_pending->m_retiredNext;
+        m_epochs.retire(m_pending);
+        m_pending = next;
+    }
+    m_generation++;
+}
+
+
+//-------------------------------------------------Reader Functions------------------------------------------------
+
+template <class T>
+const typename VersionedTree<T>::VersionNode* VersionedTree<T>::get_published() const
+{
+    return m_published.load();
+}
+
+
+template <class T>
+int VersionedTree<T>::get_size(const VersionNode* root)
+{
+    return (root == nullptr) ? 0 : root->m_size;
+}
+
+
+template <class T>
+int VersionedTree<T>::get_all_ids(const VersionNode* root, int* const output)
+{
+    //Inorder walk with an explicit stack, as the tree may hold millions of nodes
+    const VersionNode* stack[MAX_HEIGHT];
+    int depth = 0;
+    int index = 0;
+    const VersionNode* node = root;
+    while (node != nullptr || depth > 0) {
+        while (node != nullptr) {
+            stack[depth++] = node;
+            node = node->m_left;
+        }
+        node = stack[--depth];
+        output[index++] = node->m_id;
+        node = node->m_right;
+    }
+    return index;
+}
+
+
+template <class T>
+int VersionedTree<T>::count_range(const VersionNode* root, const int minId, const int maxId)
+{
+    return count_below(root, maxId + 1) - count_below(root, minId);
+}
+
+
+template <class T>
+int VersionedTree<T>::get_range(const VersionNode* root, const int minId, const int maxId, int* const ids,
+                                T* const output)
+{
+    return fill_range(root, minId, maxId, ids, output, 0);
+}
+
+
+//------------------------------------------------Helper Functions-------------------------------------------------
+
+template <class T>
+void VersionedTree<T>::reserve()
+{
+    //Every node on the path may be copied, and every rotation along it may copy two more
+    const int needed = 3 * height(m_root) + 2;
+    while (m_numSpare < needed) {
+        VersionNode* node = new VersionNode();
+        node->m_right = m_spare;
+        m_spare = node;
+        m_numSpare++;
+    }
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::create_node(T data, const int id, const int primary,
+                                                                     const int secondary)
+{
+    VersionNode* node;
+    if (m_spare != nullptr) {
+        node = m_spare;
+        m_spare = m_spare->m_right;
+        m_numSpare--;
+    }
+    else {
+        node = new VersionNode();
+    }
+    node->m_retiredNext = nullptr;
+    node->m_retiredEpoch = 0;
+    node->m_free = free_node;
+    node->m_data = data;
+    node->m_id = id;
+    node->m_primary = primary;
+    node->m_secondary = secondary;
+    node->m_height = 1;
+    node->m_size = 1;
+    node->m_left = nullptr;
+    node->m_right = nullptr;
+    node->m_generation = m_generation;
+    return node;
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::own(VersionNode* node)
+{
+    if (node->m_generation == m_generation) {
+        return node;
+    }
+    VersionNode* copy = create_node(node->m_data, node->m_id, node->m_primary, node->m_secondary);
+    copy->m_height = node->m_height;
+    copy->m_size = node->m_size;
+    copy->m_left = node->m_left;
+    copy->m_right = node->m_right;
+    //The published version still uses the original node
+    node->m_retiredNext = m_pending;
+    m_pending = node;
+    return copy;
+}
+
+
+template <class T>
+void VersionedTree<T>::discard(VersionNode* node)
+{
+    if (node->m_generation == m_generation) {
+        delete node;
+        return;
+    }
+    node->m_retiredNext = m_pending;
+    m_pending = node;
+}
+
+
+template <class T>
+void VersionedTree<T>::free_node(EpochManager::Retired* item)
+{
+    delete static_cast<VersionNode*>(item);
+}
+
+
+template <class T>
+int VersionedTree<T>::height(const VersionNode* node)
+{
+    return (node == nullptr) ? 0 : node->m_height;
+}
+
+
+template <class T>
+void VersionedTree<T>::update(VersionNode* node)
+{
+    int leftHeight = height(node->m_left);
+    int rightHeight = height(node->m_right);
+    node->m_height = ((leftHeight > rightHeight) ? leftHeight : rightHeight) + 1;
+    node->m_size = get_size(node->m_left) + get_size(node->m_right) + 1;
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::rotate_left(VersionNode* node)
+{
+    VersionNode* pivot = own(node->m_right);
+    node->m_right = pivot->m_left;
+    update(node);
+    pivot->m_left = node;
+    update(pivot);
+    return pivot;
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::rotate_right(VersionNode* node)
+{
+    VersionNode* pivot = own(node->m_left);
+    node->m_left = pivot->m_right;
+    update(node);
+    pivot->m_right = node;
+    update(pivot);
+    return pivot;
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::rebalance(VersionNode* node)
+{
+    update(node);
+    int bf = height(node->m_left) - height(node->m_right);
+    if (bf > 1) {
+        if (height(node->m_left->m_left) < height(node->m_left->m_right)) {
+            node->m_left = rotate_left(own(node->m_left));
+        }
+        return rotate_right(node);
+    }
+    if (bf < -1) {
+        if (height(node->m_right->m_right) < height(node->m_right->m_left)) {
+            node->m_right = rotate_right(own(node->m_right));
+        }
+        return rotate_left(node);
+    }
+    return node;
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::build_subtree(const T* data, const int* ids,
+                                                                       const int* primary, const int* secondary,
+                                                                       const int first, const int last)
+{
+    if (first > last) {
+        return nullptr;
+    }
+    int middle = first + (last - first) / 2;
+    VersionNode* node = create_node(data[middle], ids[middle], primary[middle], secondary[middle]);
+    try {
+        node->m_left = build_subtree(data, ids, primary, secondary, first, middle - 1);
+        node->m_right = build_subtree(data, ids, primary, secondary, middle + 1, last);
+    }
+    catch (const std::bad_alloc& e) {
+        clear_subtree(node);
+        throw e;
+    }
+    update(node);
+    return node;
+}
+
+
+template <class T>
+void VersionedTree<T>::clear_subtree(VersionNode* node)
+{
+    if (node == nullptr) {
+        return;
+    }
+    clear_subtree(node->m_left);
+    clear_subtree(node->m_right);
+    discard(node);
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::insert_node(VersionNode* node, VersionNode* newNode)
+{
+    if (node == nullptr) {
+        return newNode;
+    }
+    node = own(node);
+    if (is_before(newNode->m_id, newNode->m_primary, newNode->m_secondary, node)) {
+        node->m_left = insert_node(node->m_left, newNode);
+    }
+    else {
+        node->m_right = insert_node(node->m_right, newNode);
+    }
+    return rebalance(node);
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::remove_node(VersionNode* node, const int id,
+                                                                     const int primary, const int secondary)
+{
+    if (is_before(id, primary, secondary, node)) {
+        node = own(node);
+        node->m_left = remove_node(node->m_left, id, primary, secondary);
+        return rebalance(node);
+    }
+    if (node->m_id != id || node->m_primary != primary || node->m_secondary != secondary) {
+        node = own(node);
+        node->m_right = remove_node(node->m_right, id, primary, secondary);
+        return rebalance(node);
+    }
+    VersionNode* left = node->m_left;
+    VersionNode* right = node->m_right;
+    discard(node);
+    if (left == nullptr) {
+        return right;
+    }
+    if (right == nullptr) {
+        return left;
+    }
+    //The smallest node of the right subtree takes the place of the removed node
+    VersionNode* successor = nullptr;
+    right = remove_min(right, &successor);
+    successor->m_left = left;
+    successor->m_right = right;
+    return rebalance(successor);
+}
+
+
+template <class T>
+typename VersionedTree<T>::VersionNode* VersionedTree<T>::remove_min(VersionNode* node, VersionNode** min)
+{
+    node = own(node);
+    if (node->m_left == nullptr) {
+        *min = node;
+        return node->m_right;
+    }
+    node->m_left = remove_min(node->m_left, min);
+    return rebalance(node);
+}
+
+
+template <class T>
+bool VersionedTree<T>::is_before(const int id, const int primary, const int secondary, const VersionNode* node)
+{
+    if (primary != node->m_primary) {
+        return primary < node->m_primary;
+    }
+    if (secondary != node->m_secondary) {
+        return secondary > node->m_secondary;
+    }
+    return id < node->m_id;
+}
+
+
+template <class T>
+bool VersionedTree<T>::contains(const int id, const int primary, const int secondary) const
+{
+    const VersionNode* node = m_root;
+    while (node != nullptr) {
+        if (node->m_id == id && node->m_primary == primary && node->m_secondary == secondary) {
+            return true;
+        }
+        node = is_before(id, primary, secondary, node) ? node->m_left : node->m_right;
+    }
+    return false;
+}
+
+
+template <class T>
+int VersionedTree<T>::count_below(const VersionNode* node, const int id)
+{
+    int count = 0;
+    while (node != nullptr) {
+        if (node->m_id < id) {
+            count += get_size(node->m_left) + 1;
+            node = node->m_right;
+        }
+        else {
+            node = node->m_left;
+        }
+    }
+    return count;
+}
+
+
+template <class T>
+int VersionedTree<T>::fill_range(const VersionNode* node, const int minId, const int maxId, int* const ids,
+                                 T* const output, int index)
+{
+    if (node == nullptr) {
+        return index;
+    }
+    if (node->m_id > minId) {
+        index = fill_range(node->m_left, minId, maxId, ids, output, index);
+    }
+    if (node->m_id >= minId && node->m_id <= maxId) {
+        ids[index] = node->m_id;
+        output[index] = node->m_data;
+        index++;
+    }
+    if (node->m_id < maxId) {
+        index = fill_range(node->m_right, minId, maxId, ids, output, index);
+    }
+    return index;
+}
+
+
+//-----------------------------------------------------------------------------------------------------------
+
+#endif //WORLD_CUP_SYSTEM_VERSIONEDTREE_H
@@ -0,0 +1,122 @@
+//apply_batch.cpp - runs the same stream of commands through the single functions and through apply_batch
+
+#include "../worldcup23a1.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static const int NUM_TEAMS = 500;
+static const int NUM_PLAYERS = 100000;
+static const int BATCH_SIZE = 4096;
+
+//Matches, new players and points queries name teams, while updates of players only name players
+static void make_commands(Command* commands, int numCommands)
+{
+    std::mt19937 rng(1);
+    for (int i = 0; i < numCommands; i++) {
+        Command& command = commands[i];
+        command.m_flag = false;
+        command.m_output = nullptr;
+        int* args = command.m_args;
+        int kind = rng() % 100;
+        if (kind < 40) {
+            command.m_type = CommandType::ADD_PLAYER;
+            args[0] = 1 + rng() % NUM_PLAYERS;
+            args[1] = 1 + rng() % NUM_TEAMS;
+            args[2] = 1;
+            args[3] = rng() % 10;
+            args[4] = rng() % 3;
+            command.m_flag = (rng() % 8 == 0);
+        }
+        else if (kind < 70) {
+            command.m_type = CommandType::PLAY_MATCH;
+            args[0] = 1 + rng() % NUM_TEAMS;
+            args[1] = 1 + (args[0] + rng() % (NUM_TEAMS - 1)) % NUM_TEAMS;
+        }
+        else if (kind < 85) {
+            command.m_type = CommandType::GET_TEAM_POINTS;
+            args[0] = 1 + rng() % NUM_TEAMS;
+        }
+        else {
+            command.m_type = CommandType::UPDATE_PLAYER_STATS;
+            args[0] = 1 + rng() % NUM_PLAYERS;
+            args[1] = 1;
+            args[2] = rng() % 3;
+            args[3] = rng() % 2;
+        }
+    }
+}
+
+static long long run_single(const Command* commands, int numCommands)
+{
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= NUM_TEAMS; i++) {
+        obj->add_team(i, 0);
+    }
+    long long checksum = 0;
+    for (int i = 0; i < numCommands; i++) {
+        const int* args = commands[i].m_args;
+        switch (commands[i].m_type) {
+            case CommandType::ADD_PLAYER:
+                checksum += static_cast<int>(obj->add_player(args[0], args[1], args[2], args[3], args[4],
+                                                             commands[i].m_flag));
+                break;
+            case CommandType::PLAY_MATCH:
+                checksum += static_cast<int>(obj->play_match(args[0], args[1]));
+                break;
+            case CommandType::GET_TEAM_POINTS: {
+                output_t<int> points = obj->get_team_points(args[0]);
+                checksum += static_cast<int>(points.status()) + points.ans();
+                break;
+            }
+            default:
+                checksum += static_cast<int>(obj->update_player_stats(args[0], args[1], args[2], args[3]));
+                break;
+        }
+    }
+    delete obj;
+    return checksum;
+}
+
+static long long run_batch(const Command* commands, int numCommands, Result* results)
+{
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= NUM_TEAMS; i++) {
+        obj->add_team(i, 0);
+    }
+    for (int i = 0; i < numCommands; i += BATCH_SIZE) {
+        int size = (numCommands - i < BATCH_SIZE) ? numCommands - i : BATCH_SIZE;
+        obj->apply_batch(commands + i, size, results + i);
+    }
+    long long checksum = 0;
+    for (int i = 0; i < numCommands; i++) {
+        checksum += static_cast<int>(results[i].m_status);
+        if (commands[i].m_type == CommandType::GET_TEAM_POINTS) {
+            checksum += results[i].m_value;
+        }
+    }
+    delete obj;
+    return checksum;
+}
+
+int main(int argc, char** argv)
+{
+    int numCommands = (argc > 1) ? atoi(argv[1]) : 1000000;
+    Command* commands = new Command[numCommands];
+    Result* results = new Result[numCommands];
+    make_commands(commands, numCommands);
+
+    auto start = std::chrono::steady_clock::now();
+    long long single = run_single(commands, numCommands);
+    auto middle = std::chrono::steady_clock::now();
+    long long batch = run_batch(commands, numCommands, results);
+    auto end = std::chrono::steady_clock::now();
+
+    printf("single calls: %.0f ms\n", std::chrono::duration<double, std::milli>(middle - start).count());
+    printf("apply_batch:  %.0f ms\n", std::chrono::duration<double, std::milli>(end - middle).count());
+    printf("results %s\n", (single == batch) ? "match" : "DIFFER");
+    delete[] commands;
+    delete[] results;
+    return (single == batch) ? 0 : 1;
+}
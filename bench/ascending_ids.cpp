@@ -0,0 +1,61 @@
+//ascending_ids.cpp - inserts of ascending ID's, which are appended after the largest ID, against shuffled ID's
+
+#include "../worldcup23a1.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int PLAYERS_PER_TEAM = 20;
+
+//Insert the ID's into a tree of players, and return the time per insert in nanoseconds
+static double time_tree(const std::vector<int>& ids)
+{
+    Tree<GenericNode<Player*>, Player*> tree;
+    auto start = std::chrono::steady_clock::now();
+    for (int id : ids) {
+        tree.insert(nullptr, id);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ids.size();
+}
+
+//Add the teams and the players with the given ID's, and return the time per player in nanoseconds
+static double time_world_cup(const std::vector<int>& ids)
+{
+    world_cup_t* obj = new world_cup_t();
+    int numTeams = static_cast<int>(ids.size()) / PLAYERS_PER_TEAM;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 1; i <= numTeams; i++) {
+        obj->add_team(i, 0);
+    }
+    for (int id : ids) {
+        obj->add_player(id, (id - 1) / PLAYERS_PER_TEAM + 1, 1, id % 7, id % 3, false);
+    }
+    auto end = std::chrono::steady_clock::now();
+    delete obj;
+    return std::chrono::duration<double, std::nano>(end - start).count() / ids.size();
+}
+
+int main(int argc, char** argv)
+{
+    int numIds = (argc > 1) ? atoi(argv[1]) : 4000000;
+    int numPlayers = (argc > 2) ? atoi(argv[2]) : 1000000;
+    std::vector<int> ids(numIds);
+    for (int i = 0; i < numIds; i++) {
+        ids[i] = i + 1;
+    }
+    std::vector<int> shuffled(ids);
+    std::mt19937 rng(1);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    printf("Tree::insert of %d ID's: ascending %.0f ns/insert, shuffled %.0f ns/insert\n", numIds, time_tree(ids),
+           time_tree(shuffled));
+    ids.resize(numPlayers);
+    shuffled = ids;
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    printf("add_team + add_player of %d players: ascending %.0f ns/player, shuffled %.0f ns/player\n", numPlayers,
+           time_world_cup(ids), time_world_cup(shuffled));
+    return 0;
+}
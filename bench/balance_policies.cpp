@@ -0,0 +1,61 @@
+//balance_policies.cpp - inserts, removes and lookups on a tree of ID's under each balancing policy
+
+#include "../worldcup23a1.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int NUM_LOOKUPS = 2000000;
+
+//Insert the ID's, remove the first half of them, then look up random ID's
+template <class B>
+static void run(const char* name, const char* order, const std::vector<int>& ids, const std::vector<int>& lookups)
+{
+    int numIds = static_cast<int>(ids.size());
+    Tree<GenericNode<Player*>, Player*, B> tree;
+    auto start = std::chrono::steady_clock::now();
+    for (int id : ids) {
+        tree.insert(nullptr, id);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int i = 0; i < numIds / 2; i++) {
+        tree.remove(ids[i]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    long long found = 0;
+    for (int id : lookups) {
+        found += (tree.find_data(id) != nullptr);
+    }
+    auto lookupEnd = std::chrono::steady_clock::now();
+    printf("%-13s %-9s: insert %.0f ns, remove %.0f ns, lookup %.0f ns (%lld found)\n", name, order,
+           std::chrono::duration<double, std::nano>(middle - start).count() / numIds,
+           std::chrono::duration<double, std::nano>(end - middle).count() / (numIds / 2),
+           std::chrono::duration<double, std::nano>(lookupEnd - end).count() / lookups.size(), found);
+}
+
+int main(int argc, char** argv)
+{
+    int numIds = (argc > 1) ? atoi(argv[1]) : 1000000;
+    std::vector<int> ids(numIds);
+    for (int i = 0; i < numIds; i++) {
+        ids[i] = i + 1;
+    }
+    std::mt19937 rng(3);
+    std::vector<int> shuffled(ids);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    std::vector<int> lookups(NUM_LOOKUPS);
+    for (int& id : lookups) {
+        id = 1 + rng() % numIds;
+    }
+    printf("%d ID's\n", numIds);
+    run<AVLBalance>("AVLBalance", "ascending", ids, lookups);
+    run<TreapBalance>("TreapBalance", "ascending", ids, lookups);
+    run<WeightBalance>("WeightBalance", "ascending", ids, lookups);
+    run<AVLBalance>("AVLBalance", "shuffled", shuffled, lookups);
+    run<TreapBalance>("TreapBalance", "shuffled", shuffled, lookups);
+    run<WeightBalance>("WeightBalance", "shuffled", shuffled, lookups);
+    return 0;
+}
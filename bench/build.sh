@@ -0,0 +1,17 @@
+#!/bin/sh
+#Builds the main binary and every benchmark driver in bench/ with the same compile line - a driver takes the place
+#of main23a1.cpp. policy_stream is also built once for each balancing policy, set for every tree by WC_BALANCE. The
+#binaries are written to bench/bin.
+cd "$(dirname "$0")/.." || exit 1
+CXX=${CXX:-g++}
+FLAGS="-std=c++11 -O2 -fno-delete-null-pointer-checks -Wall -Wno-nonnull-compare -pthread"
+SOURCES=$(ls *.cpp | grep -v -e '^main23a1.cpp$' -e '^avltestlior.cpp$')
+mkdir -p bench/bin
+$CXX $FLAGS -o bench/bin/main23a1 main23a1.cpp $SOURCES || exit 1
+for driver in bench/*.cpp; do
+    name=$(basename "$driver" .cpp)
+    $CXX $FLAGS -o "bench/bin/$name" "$driver" $SOURCES || exit 1
+done
+for policy in AVLBalance TreapBalance WeightBalance; do
+    $CXX $FLAGS -DWC_BALANCE=$policy -o "bench/bin/policy_stream_$policy" bench/policy_stream.cpp $SOURCES || exit 1
+done
@@ -0,0 +1,70 @@
+//command_log.cpp - encoding and decoding a binary command log, against the size of the same commands as text
+
+#include "../CommandLog.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <vector>
+
+static const char* COMMAND_NAMES[] = {"add_team", "remove_team", "add_player", "remove_player",
+                                      "update_player_stats", "play_match", "get_num_played_games", "get_team_points",
+                                      "unite_teams", "get_top_scorer", "get_all_players_count", "get_all_players",
+                                      "get_closest_player", "knockout_winner"};
+static const int NUM_ARGS[] = {2, 1, 5, 1, 4, 2, 1, 1, 3, 1, 1, 1, 2, 2};
+
+int main(int argc, char** argv)
+{
+    int numCommands = (argc > 1) ? atoi(argv[1]) : 5000000;
+    //Commands with ID's and stats of the sizes of a large tournament
+    std::mt19937 rng(1);
+    std::vector<Command> commands(numCommands);
+    size_t textBytes = 0;
+    char line[160];
+    for (Command& command : commands) {
+        command.m_type = static_cast<CommandType>(rng() % 14);
+        command.m_args[0] = 1 + static_cast<int>(rng() % 1000000);
+        command.m_args[1] = 1 + static_cast<int>(rng() % 50000);
+        for (int i = 2; i < 5; i++) {
+            command.m_args[i] = static_cast<int>(rng() % 20);
+        }
+        command.m_flag = (command.m_type == CommandType::ADD_PLAYER && rng() % 4 == 0);
+        command.m_output = nullptr;
+        int length = snprintf(line, sizeof(line), "%s", COMMAND_NAMES[static_cast<int>(command.m_type)]);
+        for (int i = 0; i < NUM_ARGS[static_cast<int>(command.m_type)]; i++) {
+            length += snprintf(line + length, sizeof(line) - length, " %d", command.m_args[i]);
+        }
+        if (command.m_type == CommandType::ADD_PLAYER) {
+            length += snprintf(line + length, sizeof(line) - length, command.m_flag ? " true" : " false");
+        }
+        textBytes += length + 1;
+    }
+
+    std::ostringstream out;
+    auto start = std::chrono::steady_clock::now();
+    {
+        CommandLogWriter writer(out);
+        for (const Command& command : commands) {
+            writer.write_command(command);
+        }
+    }
+    auto encoded = std::chrono::steady_clock::now();
+    std::string log = out.str();
+    auto decodeStart = std::chrono::steady_clock::now();
+    CommandLogReader reader(log.data(), log.size());
+    Command command;
+    std::string unknown;
+    long long checksum = 0;
+    while (reader.next(command, unknown) == LogRecord::COMMAND) {
+        checksum += command.m_args[0];
+    }
+    auto decoded = std::chrono::steady_clock::now();
+    printf("%d commands: text %.1f MB (%.1f bytes/command), log %.1f MB (%.1f bytes/command)\n", numCommands,
+           textBytes / 1e6, static_cast<double>(textBytes) / numCommands, log.size() / 1e6,
+           static_cast<double>(log.size()) / numCommands);
+    printf("encode %.1f ns/command, decode %.1f ns/command (checksum %lld)\n",
+           std::chrono::duration<double, std::nano>(encoded - start).count() / numCommands,
+           std::chrono::duration<double, std::nano>(decoded - decodeStart).count() / numCommands, checksum);
+    return 0;
+}
@@ -0,0 +1,79 @@
+//compact_players.cpp - walks and searches of fragmented player trees, before and after compact_players
+
+#include "../worldcup23a1.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int PLAYERS_PER_TEAM = 20;
+static const int NUM_LOOKUPS = 2000000;
+static const int NUM_EXPORTS = 10;
+static const int NUM_ROUNDS = 3;
+
+//Time the full exports, in milliseconds per export, and the lookups, in nanoseconds per lookup
+static void time_reads(world_cup_t* obj, const std::vector<int>& lookups, int numPlayers, const char* name)
+{
+    long long checksum = 0;
+    std::vector<int> output(numPlayers);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_EXPORTS; i++) {
+        obj->get_all_players(-1, output.data());
+        checksum += output[i];
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int id : lookups) {
+        checksum += obj->get_num_played_games(id).ans();
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("%s: get_all_players(-1) %.2f ms/op, get_num_played_games %.0f ns/op (checksum %lld)\n", name,
+           std::chrono::duration<double, std::milli>(middle - start).count() / NUM_EXPORTS,
+           std::chrono::duration<double, std::nano>(end - middle).count() / lookups.size(), checksum);
+}
+
+int main(int argc, char** argv)
+{
+    int numPlayers = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int numTeams = numPlayers / PLAYERS_PER_TEAM;
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= numTeams; i++) {
+        obj->add_team(i, 0);
+    }
+    std::vector<int> ids(numPlayers);
+    for (int i = 0; i < numPlayers; i++) {
+        ids[i] = i + 1;
+    }
+    std::mt19937 rng(5);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    for (int id : ids) {
+        obj->add_player(id, 1 + rng() % numTeams, 1 + rng() % 5, rng() % 10, rng() % 4, false);
+    }
+    //Rounds of churn: a third of the players are removed and added again, and a third are updated
+    for (int round = 0; round < NUM_ROUNDS; round++) {
+        std::shuffle(ids.begin(), ids.end(), rng);
+        for (int i = 0; i < numPlayers / 3; i++) {
+            obj->remove_player(ids[i]);
+        }
+        for (int i = 0; i < numPlayers / 3; i++) {
+            obj->add_player(ids[i], 1 + rng() % numTeams, 1, rng() % 10, rng() % 4, false);
+        }
+        for (int i = 0; i < numPlayers / 3; i++) {
+            obj->update_player_stats(ids[rng() % numPlayers], 1, rng() % 3, rng() % 2);
+        }
+    }
+    std::vector<int> lookups(NUM_LOOKUPS);
+    for (int& id : lookups) {
+        id = 1 + rng() % numPlayers;
+    }
+    printf("%d players\n", numPlayers);
+    time_reads(obj, lookups, numPlayers, "fragmented");
+    auto start = std::chrono::steady_clock::now();
+    obj->compact_players();
+    auto end = std::chrono::steady_clock::now();
+    printf("compact_players: %.1f ms\n", std::chrono::duration<double, std::milli>(end - start).count());
+    time_reads(obj, lookups, numPlayers, "compacted");
+    delete obj;
+    return 0;
+}
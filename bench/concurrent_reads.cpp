@@ -0,0 +1,80 @@
+//concurrent_reads.cpp - the five queries of world_cup_t from several threads, under its read lock or one outside mutex
+
+#include "../worldcup23a1.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const int NUM_TEAMS = 200;
+static const long TOTAL_READS = 2000000;
+
+//Read with the given number of threads, and return the reads per second in thousands
+static double time_reads(world_cup_t* obj, int numPlayers, int numThreads, std::mutex* outside)
+{
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([=] {
+            unsigned int s = t * 2654435761u + 7;
+            long long checksum = 0;
+            for (long i = 0; i < TOTAL_READS / numThreads; i++) {
+                s ^= s << 13;
+                s ^= s >> 17;
+                s ^= s << 5;
+                int playerId = s % numPlayers + 1;
+                int teamId = (s >> 8) % NUM_TEAMS + 1;
+                if (outside != nullptr) {
+                    outside->lock();
+                }
+                switch ((s >> 24) % 4) {
+                    case 0:
+                        checksum += obj->get_num_played_games(playerId).ans();
+                        break;
+                    case 1:
+                        checksum += obj->get_team_points(teamId).ans();
+                        break;
+                    case 2:
+                        checksum += obj->get_top_scorer(teamId).ans();
+                        break;
+                    default:
+                        checksum += obj->get_all_players_count(teamId).ans();
+                }
+                if (outside != nullptr) {
+                    outside->unlock();
+                }
+            }
+            if (checksum < 0) {
+                printf("checksum %lld\n", checksum);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return TOTAL_READS / seconds / 1e3;
+}
+
+int main(int argc, char** argv)
+{
+    int numPlayers = (argc > 1) ? atoi(argv[1]) : 20000;
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= NUM_TEAMS; i++) {
+        obj->add_team(i, i % 7);
+    }
+    for (int i = 1; i <= numPlayers; i++) {
+        obj->add_player(i, i % NUM_TEAMS + 1, i % 13, i % 29, i % 5, i % 11 == 0);
+    }
+    std::mutex outside;
+    printf("%d players, %ld reads, kreads/s\n", numPlayers, TOTAL_READS);
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    for (int numThreads : threadCounts) {
+        printf("threads %2d: outside mutex %.0f, read lock %.0f\n", numThreads,
+               time_reads(obj, numPlayers, numThreads, &outside), time_reads(obj, numPlayers, numThreads, nullptr));
+    }
+    delete obj;
+    return 0;
+}
@@ -0,0 +1,70 @@
+//frozen_players.cpp - player lookups and get_all_players on the live trees and on the frozen snapshot
+
+#include "../worldcup23a1.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int PLAYERS_PER_TEAM = 20;
+static const int NUM_LOOKUPS = 2000000;
+static const int NUM_EXPORTS = 20;
+static const int MAX_DELTA = 1000;
+
+//Time the lookups, in nanoseconds per lookup, and the full exports, in milliseconds per export
+static void time_reads(world_cup_t* obj, const std::vector<int>& lookups, int numPlayers, const char* name)
+{
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int id : lookups) {
+        checksum += obj->get_num_played_games(id).ans();
+    }
+    auto middle = std::chrono::steady_clock::now();
+    std::vector<int> output(numPlayers);
+    for (int i = 0; i < NUM_EXPORTS; i++) {
+        obj->get_all_players(-1, output.data());
+        checksum += output[i];
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("%s: get_num_played_games %.0f ns/op, get_all_players(-1) %.2f ms/op (checksum %lld)\n", name,
+           std::chrono::duration<double, std::nano>(middle - start).count() / lookups.size(),
+           std::chrono::duration<double, std::milli>(end - middle).count() / NUM_EXPORTS, checksum);
+}
+
+int main(int argc, char** argv)
+{
+    int numPlayers = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int numTeams = numPlayers / PLAYERS_PER_TEAM;
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= numTeams; i++) {
+        obj->add_team(i, 0);
+    }
+    //The players are added in shuffled order, and a tenth of them are removed and added again
+    std::vector<int> ids(numPlayers);
+    for (int i = 0; i < numPlayers; i++) {
+        ids[i] = i + 1;
+    }
+    std::mt19937 rng(5);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    for (int id : ids) {
+        obj->add_player(id, 1 + rng() % numTeams, 1 + rng() % 5, rng() % 10, rng() % 4, false);
+    }
+    for (int i = 0; i < numPlayers / 10; i++) {
+        obj->remove_player(ids[i]);
+    }
+    for (int i = 0; i < numPlayers / 10; i++) {
+        obj->add_player(ids[i], 1 + rng() % numTeams, 1, rng() % 10, rng() % 4, false);
+    }
+    std::vector<int> lookups(NUM_LOOKUPS);
+    for (int& id : lookups) {
+        id = 1 + rng() % numPlayers;
+    }
+    printf("%d players\n", numPlayers);
+    time_reads(obj, lookups, numPlayers, "live trees");
+    obj->freeze_players(MAX_DELTA);
+    time_reads(obj, lookups, numPlayers, "frozen");
+    delete obj;
+    return 0;
+}
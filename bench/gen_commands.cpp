@@ -0,0 +1,75 @@
+//gen_commands.cpp - writes a random stream of driver commands, for timing main23a1 and serial_main on large inputs
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+//A random team ID - a few of them never exist
+static int team(std::mt19937& rng, int numTeams)
+{
+    return 1 + static_cast<int>(rng() % (numTeams + 2));
+}
+
+int main(int argc, char** argv)
+{
+    int numLines = (argc > 1) ? atoi(argv[1]) : 1000000;
+    unsigned int seed = (argc > 2) ? static_cast<unsigned int>(atoi(argv[2])) : 1;
+    int numTeams = (numLines / 2000 > 8) ? numLines / 2000 : 8;
+    int numPlayers = (numLines / 10 > 60) ? numLines / 10 : 60;
+    std::mt19937 rng(seed);
+    for (int i = 1; i <= numTeams; i++) {
+        printf("add_team %d %d\n", i, static_cast<int>(rng() % 6));
+    }
+    for (int i = 0; i < numLines; i++) {
+        int kind = static_cast<int>(rng() % 100);
+        int playerId = 1 + static_cast<int>(rng() % numPlayers);
+        if (kind < 35) {
+            int games = static_cast<int>(rng() % 5);
+            printf("add_player %d %d %d %d %d %s\n", playerId, team(rng, numTeams), games,
+                   games > 0 ? static_cast<int>(rng() % 4) : 0, games > 0 ? static_cast<int>(rng() % 4) : 0,
+                   rng() % 4 == 0 ? "true" : "false");
+        }
+        else if (kind < 42) {
+            printf("remove_player %d\n", playerId);
+        }
+        else if (kind < 55) {
+            printf("update_player_stats %d %d %d %d\n", playerId, static_cast<int>(rng() % 3),
+                   static_cast<int>(rng() % 3), static_cast<int>(rng() % 3));
+        }
+        else if (kind < 62) {
+            printf("play_match %d %d\n", team(rng, numTeams), team(rng, numTeams));
+        }
+        else if (kind < 65) {
+            printf("get_num_played_games %d\n", playerId);
+        }
+        else if (kind < 68) {
+            printf("get_team_points %d\n", team(rng, numTeams));
+        }
+        else if (kind < 69) {
+            printf("unite_teams %d %d %d\n", team(rng, numTeams), team(rng, numTeams), team(rng, numTeams + 2));
+        }
+        else if (kind < 74) {
+            printf("get_top_scorer %d\n", rng() % 4 == 0 ? -1 : team(rng, numTeams));
+        }
+        else if (kind < 78) {
+            printf("get_all_players_count %d\n", rng() % 4 == 0 ? -1 : team(rng, numTeams));
+        }
+        else if (kind < 80) {
+            printf("get_all_players %d\n", team(rng, numTeams));
+        }
+        else if (kind < 88) {
+            printf("get_closest_player %d %d\n", playerId, team(rng, numTeams));
+        }
+        else if (kind < 93) {
+            int minTeamId = static_cast<int>(rng() % (numTeams + 3));
+            printf("knockout_winner %d %d\n", minTeamId, minTeamId + static_cast<int>(rng() % 7));
+        }
+        else if (kind < 97) {
+            printf("add_team %d %d\n", team(rng, numTeams + 2), static_cast<int>(rng() % 6));
+        }
+        else {
+            printf("remove_team %d\n", team(rng, numTeams + 2));
+        }
+    }
+    return 0;
+}
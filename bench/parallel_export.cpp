@@ -0,0 +1,50 @@
+//parallel_export.cpp - get_all_players of the whole league and of one team, with 1, 2, 4 and 8 worker threads
+
+#include "../worldcup23a1.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const int NUM_TEAMS = 4;
+static const int REPEATS = 5;
+
+//Export the players of a team the given number of times, and return the fastest export in milliseconds
+static double time_export(world_cup_t& obj, int teamId, std::vector<int>& output)
+{
+    double best = 1e9;
+    for (int i = 0; i < REPEATS; i++) {
+        std::fill(output.begin(), output.end(), 0);
+        auto start = std::chrono::steady_clock::now();
+        obj.get_all_players(teamId, output.data());
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ms);
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    int numPlayers = (argc > 1) ? atoi(argv[1]) : 10000000;
+    world_cup_t obj;
+    for (int teamId = 1; teamId <= NUM_TEAMS; teamId++) {
+        obj.add_team(teamId, 0);
+    }
+    for (int playerId = 1; playerId <= numPlayers; playerId++) {
+        obj.add_player(playerId, 1 + playerId % NUM_TEAMS, 1, (playerId * 7919) % 50, (playerId * 31) % 5, false);
+    }
+    std::vector<int> serial(numPlayers), output(numPlayers);
+    std::vector<int> teamSerial(obj.get_all_players_count(2).ans()), teamOutput(teamSerial.size());
+    obj.get_all_players(-1, serial.data());
+    obj.get_all_players(2, teamSerial.data());
+    const int threadCounts[] = {1, 2, 4, 8};
+    for (int numThreads : threadCounts) {
+        obj.set_worker_threads(numThreads);
+        double league = time_export(obj, -1, output);
+        double team = time_export(obj, 2, teamOutput);
+        printf("%d players, %d threads: league %.1f ms, team %.1f ms, same as serial: %s\n", numPlayers, numThreads,
+               league, team, (output == serial && teamOutput == teamSerial) ? "yes" : "no");
+    }
+    return 0;
+}
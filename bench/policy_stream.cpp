@@ -0,0 +1,91 @@
+//policy_stream.cpp - a binary command log replayed on world_cup_t, timed under the balancing policy of the build.
+//bench/build.sh builds it once per policy (bench/bin/policy_stream_<policy>, with -DWC_BALANCE=<policy>), so the
+//same log can be replayed under each of them:
+//    bench/bin/gen_commands 1000000 | bench/bin/main23a1 --convert > commands.wcl
+//    bench/bin/policy_stream_TreapBalance < commands.wcl
+
+#include "../worldcup23a1.h"
+#include "../CommandLog.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#define POLICY_NAME(policy) POLICY_STRING(policy)
+#define POLICY_STRING(policy) #policy
+
+static const int REPEATS = 3;
+
+//Run a command on the system, and return its status and answer folded into a single number
+static long long execute(world_cup_t& obj, const Command& command, std::vector<int>& output)
+{
+    const int* d = command.m_args;
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+            return static_cast<int>(obj.add_team(d[0], d[1]));
+        case CommandType::REMOVE_TEAM:
+            return static_cast<int>(obj.remove_team(d[0]));
+        case CommandType::ADD_PLAYER:
+            return static_cast<int>(obj.add_player(d[0], d[1], d[2], d[3], d[4], command.m_flag));
+        case CommandType::REMOVE_PLAYER:
+            return static_cast<int>(obj.remove_player(d[0]));
+        case CommandType::UPDATE_PLAYER_STATS:
+            return static_cast<int>(obj.update_player_stats(d[0], d[1], d[2], d[3]));
+        case CommandType::PLAY_MATCH:
+            return static_cast<int>(obj.play_match(d[0], d[1]));
+        case CommandType::GET_NUM_PLAYED_GAMES:
+            return obj.get_num_played_games(d[0]).ans();
+        case CommandType::GET_TEAM_POINTS:
+            return obj.get_team_points(d[0]).ans();
+        case CommandType::UNITE_TEAMS:
+            return static_cast<int>(obj.unite_teams(d[0], d[1], d[2]));
+        case CommandType::GET_TOP_SCORER:
+            return obj.get_top_scorer(d[0]).ans();
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+            return obj.get_all_players_count(d[0]).ans();
+        case CommandType::GET_ALL_PLAYERS: {
+            int count = obj.get_all_players_count(d[0]).ans();
+            if (count <= 0) {
+                return static_cast<int>(obj.get_all_players(d[0], nullptr));
+            }
+            output.resize(count);
+            obj.get_all_players(d[0], output.data());
+            return output[0] + output[count - 1];
+        }
+        case CommandType::GET_CLOSEST_PLAYER:
+            return obj.get_closest_player(d[0], d[1]).ans();
+        default:
+            return obj.knockout_winner(d[0], d[1]).ans();
+    }
+}
+
+int main()
+{
+    std::string log((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+    CommandLogReader reader(log.data(), log.size());
+    std::vector<Command> commands;
+    Command command;
+    std::string unknown;
+    while (reader.next(command, unknown) == LogRecord::COMMAND) {
+        commands.push_back(command);
+    }
+    //The checksum of the answers is the same under every policy
+    double best = 1e9;
+    unsigned long long checksum = 0;
+    std::vector<int> output;
+    for (int i = 0; i < REPEATS; i++) {
+        world_cup_t obj;
+        checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const Command& next : commands) {
+            checksum = checksum * 31 + execute(obj, next, output);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = (seconds < best) ? seconds : best;
+    }
+    printf("%s: %d commands in %.3f s (best of %d), %.0f ns/command, checksum %llu\n", POLICY_NAME(WC_BALANCE),
+           static_cast<int>(commands.size()), best, REPEATS, best * 1e9 / commands.size(), checksum);
+    return 0;
+}
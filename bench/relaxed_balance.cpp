@@ -0,0 +1,79 @@
+//relaxed_balance.cpp - a roster import under several slacks of set_relaxed_balance, and the lookups around it
+
+#include "../worldcup23a1.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const int PLAYERS_PER_TEAM = 20;
+static const int NUM_LOOKUPS = 1000000;
+
+//The average time of a lookup, in nanoseconds
+static double time_lookups(world_cup_t* obj, const std::vector<int>& lookups)
+{
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int id : lookups) {
+        checksum += obj->get_num_played_games(id).ans();
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (checksum < 0) {
+        printf("checksum %lld\n", checksum);
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / lookups.size();
+}
+
+//Import the players under the given slack, then restore strict balance
+static void run(const std::vector<int>& ids, const std::vector<int>& lookups, int slack, const char* order)
+{
+    int numPlayers = static_cast<int>(ids.size());
+    int numTeams = numPlayers / PLAYERS_PER_TEAM;
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= numTeams; i++) {
+        obj->add_team(i, 0);
+    }
+    obj->set_relaxed_balance(slack);
+    std::mt19937 rng(5);
+    auto start = std::chrono::steady_clock::now();
+    for (int id : ids) {
+        obj->add_player(id, 1 + rng() % numTeams, 1, rng() % 10, rng() % 4, false);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    double before = time_lookups(obj, lookups);
+    auto rebalanceStart = std::chrono::steady_clock::now();
+    obj->set_relaxed_balance(1);
+    auto rebalanceEnd = std::chrono::steady_clock::now();
+    double after = time_lookups(obj, lookups);
+    printf("%s, slack %d: import %.0f ns/player, lookup %.0f ns, rebalance %.1f ms, lookup after %.0f ns\n", order,
+           slack, std::chrono::duration<double, std::nano>(middle - start).count() / numPlayers, before,
+           std::chrono::duration<double, std::milli>(rebalanceEnd - rebalanceStart).count(), after);
+    delete obj;
+}
+
+int main(int argc, char** argv)
+{
+    int numPlayers = (argc > 1) ? atoi(argv[1]) : 500000;
+    std::vector<int> ids(numPlayers);
+    for (int i = 0; i < numPlayers; i++) {
+        ids[i] = i + 1;
+    }
+    std::mt19937 rng(1);
+    std::vector<int> lookups(NUM_LOOKUPS);
+    for (int& id : lookups) {
+        id = 1 + rng() % numPlayers;
+    }
+    std::vector<int> shuffled(ids);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    printf("%d players\n", numPlayers);
+    const int slacks[] = {1, 4, 16};
+    for (int slack : slacks) {
+        run(ids, lookups, slack, "ascending");
+    }
+    for (int slack : slacks) {
+        run(shuffled, lookups, slack, "shuffled");
+    }
+    return 0;
+}
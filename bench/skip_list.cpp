@@ -0,0 +1,110 @@
+//skip_list.cpp - mixed inserts, removes and max lookups from 1, 2, 4 and 8 threads, on ConcurrentSkipList and on a
+//MultiTree behind a std::mutex
+
+#include "../worldcup23a1.h"
+#include "../ConcurrentSkipList.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const int REPEATS = 3;
+
+//Run the operations of one thread: half inserts of IDs of its own, a quarter removes of nodes it inserted and a
+//quarter max lookups
+template <class Insert, class Remove, class Max>
+static void run_operations(int thread, int numThreads, int numOperations, Insert insert, Remove remove, Max max)
+{
+    unsigned int state = thread * 2654435761u + 1;
+    std::vector<int> ids, goals, cards;
+    int nextId = thread;
+    for (int i = 0; i < numOperations; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        unsigned int choice = state % 4;
+        if (choice < 2 || ids.empty()) {
+            ids.push_back(nextId);
+            goals.push_back(state % 1000);
+            cards.push_back((state >> 10) % 10);
+            insert(nextId, goals.back(), cards.back());
+            nextId += numThreads;
+        }
+        else if (choice == 2) {
+            size_t j = (state >> 3) % ids.size();
+            remove(ids[j], goals[j], cards[j]);
+            ids[j] = ids.back();
+            goals[j] = goals.back();
+            cards[j] = cards.back();
+            ids.pop_back();
+            goals.pop_back();
+            cards.pop_back();
+        }
+        else {
+            max();
+        }
+    }
+}
+
+//Split the operations between the threads, and return the best throughput of the runs in thousands per second
+template <class Structure, class Run>
+static double time_threads(int numThreads, int numOperations, Run run)
+{
+    double best = 1e9;
+    for (int i = 0; i < REPEATS; i++) {
+        Structure structure;
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < numThreads; t++) {
+            threads.emplace_back(run, std::ref(structure), t, numThreads, numOperations / numThreads);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = (seconds < best) ? seconds : best;
+    }
+    return numOperations / best / 1e3;
+}
+
+//A MultiTree and the mutex that guards it
+struct LockedTree {
+    MultiTree<Player*> m_tree;
+    std::mutex m_mutex;
+};
+
+int main(int argc, char** argv)
+{
+    int numOperations = (argc > 1) ? atoi(argv[1]) : 400000;
+    const int threadCounts[] = {1, 2, 4, 8};
+    for (int numThreads : threadCounts) {
+        double skipList = time_threads<ConcurrentSkipList<Player*>>(numThreads, numOperations,
+            [](ConcurrentSkipList<Player*>& list, int thread, int threads, int operations) {
+                run_operations(thread, threads, operations,
+                    [&](int id, int goals, int cards) { list.insert(nullptr, id, goals, cards); },
+                    [&](int id, int goals, int cards) { list.remove(id, goals, cards); },
+                    [&] { list.search_and_return_max(); });
+            });
+        double lockedTree = time_threads<LockedTree>(numThreads, numOperations,
+            [](LockedTree& locked, int thread, int threads, int operations) {
+                run_operations(thread, threads, operations,
+                    [&](int id, int goals, int cards) {
+                        std::lock_guard<std::mutex> lock(locked.m_mutex);
+                        locked.m_tree.insert(nullptr, id, goals, cards);
+                    },
+                    [&](int id, int goals, int cards) {
+                        std::lock_guard<std::mutex> lock(locked.m_mutex);
+                        locked.m_tree.remove(id, goals, cards);
+                    },
+                    [&] {
+                        std::lock_guard<std::mutex> lock(locked.m_mutex);
+                        locked.m_tree.search_and_return_max();
+                    });
+            });
+        printf("%d operations, %d threads: skip list %.0f kops/s, mutex and MultiTree %.0f kops/s\n", numOperations,
+               numThreads, skipList, lockedTree);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+//snapshot_reads.cpp - a writer of player stats, alone or beside a looping export, with snapshot reads off and on
+
+#include "../worldcup23a1.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+static const int NUM_TEAMS = 200;
+static const int SECONDS = 3;
+
+//Update player stats for SECONDS seconds, and report the updates per second and the slowest update
+static void run(int numPlayers, bool exports, bool snapshot)
+{
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= NUM_TEAMS; i++) {
+        obj->add_team(i, 0);
+    }
+    for (int i = 1; i <= numPlayers; i++) {
+        obj->add_player(i, i % NUM_TEAMS + 1, 1, i % 7, i % 5, i % 11 == 0);
+    }
+    obj->set_snapshot_reads(snapshot);
+    std::atomic<bool> stop(false);
+    std::atomic<long> numExports(0);
+    std::thread exporter([&] {
+        std::vector<int> output(numPlayers + 1);
+        while (exports && !stop.load()) {
+            obj->get_all_players(-1, output.data());
+            numExports++;
+        }
+    });
+    auto start = std::chrono::steady_clock::now();
+    long updates = 0;
+    double slowest = 0;
+    unsigned int s = 1;
+    while (std::chrono::steady_clock::now() - start < std::chrono::seconds(SECONDS)) {
+        for (int i = 0; i < 100; i++) {
+            s = s * 1103515245 + 12345;
+            auto before = std::chrono::steady_clock::now();
+            obj->update_player_stats((s >> 4) % numPlayers + 1, 1, (s >> 12) % 2, (s >> 14) % 2);
+            double took = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - before).count();
+            slowest = (took > slowest) ? took : slowest;
+        }
+        updates += 100;
+    }
+    stop = true;
+    exporter.join();
+    printf("%-14s snapshot %-3s: %.0f updates/s, slowest update %.1f ms, %ld exports\n",
+           exports ? "looping export" : "no export", snapshot ? "on" : "off", updates / static_cast<double>(SECONDS),
+           slowest, numExports.load());
+    delete obj;
+}
+
+int main(int argc, char** argv)
+{
+    int numPlayers = (argc > 1) ? atoi(argv[1]) : 500000;
+    printf("%d players, %d s per run\n", numPlayers, SECONDS);
+    run(numPlayers, false, false);
+    run(numPlayers, false, true);
+    run(numPlayers, true, false);
+    run(numPlayers, true, true);
+    return 0;
+}
@@ -0,0 +1,60 @@
+//top_scorers.cpp - get_top_scorers of a team and of the entire game, against a full get_all_players
+
+#include "../worldcup23a1.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static const int PLAYERS_PER_TEAM = 1000;
+static const int NUM_QUERIES = 2000;
+
+//The average time of a query, in microseconds
+static double time_queries(world_cup_t* obj, int numTeams, bool league, int amount, int* output, long long& checksum)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        int teamId = league ? -1 : 1 + i % numTeams;
+        checksum += obj->get_top_scorers(teamId, amount, output).ans();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / NUM_QUERIES;
+}
+
+int main(int argc, char** argv)
+{
+    int numPlayers = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int numTeams = numPlayers / PLAYERS_PER_TEAM + 1;
+    world_cup_t* obj = new world_cup_t();
+    for (int i = 1; i <= numTeams; i++) {
+        obj->add_team(i, 0);
+    }
+    std::mt19937 rng(1);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 1; i <= numPlayers; i++) {
+        int goals = rng() % 50;
+        int cards = rng() % 20;
+        obj->add_player(i, 1 + rng() % numTeams, 1, goals, cards, i % 11 == 0);
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("load %d players in %d teams: %.1f s\n", numPlayers, numTeams,
+           std::chrono::duration<double>(end - start).count());
+
+    int* output = new int[numPlayers];
+    long long checksum = 0;
+    const int amounts[] = {10, 1000};
+    for (int amount : amounts) {
+        double league = time_queries(obj, numTeams, true, amount, output, checksum);
+        double team = time_queries(obj, numTeams, false, amount, output, checksum);
+        printf("k=%d: league %.2f us/query, team %.2f us/query\n", amount, league, team);
+    }
+    start = std::chrono::steady_clock::now();
+    obj->get_all_players(-1, output);
+    end = std::chrono::steady_clock::now();
+    printf("get_all_players(-1) for comparison: %.1f ms\n",
+           std::chrono::duration<double, std::milli>(end - start).count());
+    printf("checksum %lld\n", checksum);
+    delete[] output;
+    delete obj;
+    return 0;
+}
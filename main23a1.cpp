@@ -1,85 +1,458 @@
 #include "worldcup23a1.h"
+#include "Command.h"
+#include "SpscRing.h"
+#include "CommandLog.h"
 #include <string>
+#include <cstring>
 #include <iostream>
+#include <thread>
+#include <climits>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 
-void print(string cmd, StatusType res);
-void print(string cmd, output_t<int> res);
-void query_get_all_players(string cmd, world_cup_t *obj, int teamID);
+// The driver runs as a pipeline of three threads, connected by SPSC rings: the parser reads the commands, main
+// applies them to world_cup in order, and the writer prints their results.
+// By default the input is mapped into memory (or read whole, if it is not a file) and parsed by hand, and the output
+// is written in large blocks. With --iostream, the input is read with cin and every line is printed with endl.
+// With --convert, the text commands are encoded into a binary log (see CommandLog.h) instead of being run, and with
+// --binary, the input is such a log, replayed in place of the text commands.
 
-int main()
+// What the parser found - a command, a command followed by bad input, an unknown command, input that ends the run
+// before any command (a corrupt binary log), or the end of the input
+enum struct ParseStatus {
+    COMMAND,
+    BAD_FORMAT,
+    UNKNOWN,
+    INVALID,
+    END
+};
+
+struct ParsedCommand {
+    ParseStatus m_status;
+    Command m_command;
+};
+
+// How a result is printed - a status, a status with an answer, a status with the players found, or one of the
+// messages that end the run
+enum struct OutputKind {
+    STATUS,
+    VALUE,
+    PLAYERS,
+    BAD_FORMAT,
+    UNKNOWN,
+    END
+};
+
+struct Output {
+    OutputKind m_kind;
+    CommandType m_type;
+    StatusType m_status;
+    int m_value;
+    int* m_players;
+};
+
+// The name of every command, and the number of integer arguments it reads
+struct CommandName {
+    const char* m_name;
+    CommandType m_type;
+    int m_numArgs;
+};
+
+static const CommandName CommandNames[] =
 {
-    cin >> std::boolalpha;
-	
-    int d1, d2, d3, d4, d5;
-    bool b1;
+    {"add_team",              CommandType::ADD_TEAM,              2},
+    {"remove_team",           CommandType::REMOVE_TEAM,           1},
+    {"add_player",            CommandType::ADD_PLAYER,            5},
+    {"remove_player",         CommandType::REMOVE_PLAYER,         1},
+    {"update_player_stats",   CommandType::UPDATE_PLAYER_STATS,   4},
+    {"play_match",            CommandType::PLAY_MATCH,            2},
+    {"get_num_played_games",  CommandType::GET_NUM_PLAYED_GAMES,  1},
+    {"get_team_points",       CommandType::GET_TEAM_POINTS,       1},
+    {"unite_teams",           CommandType::UNITE_TEAMS,           3},
+    {"get_top_scorer",        CommandType::GET_TOP_SCORER,        1},
+    {"get_all_players_count", CommandType::GET_ALL_PLAYERS_COUNT, 1},
+    {"get_all_players",       CommandType::GET_ALL_PLAYERS,       1},
+    {"get_closest_player",    CommandType::GET_CLOSEST_PLAYER,    2},
+    {"knockout_winner",       CommandType::KNOCKOUT_WINNER,       2}
+};
+
+static const int NUM_COMMANDS = sizeof(CommandNames) / sizeof(CommandNames[0]);
+static const int RING_CAPACITY = 4096;
+
+// The whole input, and whether it is mapped (or else allocated)
+struct InputText {
+    char* m_data;
+    size_t m_size;
+    bool m_mapped;
+};
+
+bool load_input(InputText& input);
+void release_input(InputText& input);
+void parse_commands(SpscRing<ParsedCommand>* commands, string* unknown);
+void parse_mapped_commands(SpscRing<ParsedCommand>* commands, string* unknown, const InputText* input);
+void parse_binary_commands(SpscRing<ParsedCommand>* commands, string* unknown, const InputText* input);
+void convert_commands(SpscRing<ParsedCommand>* commands, const string* unknown);
+void execute_commands(world_cup_t *obj, SpscRing<ParsedCommand>* commands, SpscRing<Output>* outputs);
+void write_outputs(SpscRing<Output>* outputs, const string* unknown, bool* failed, bool lineByLine);
+Output execute(world_cup_t *obj, const Command& command);
+Output query_get_all_players(world_cup_t *obj, int teamID);
+
+int main(int argc, char** argv)
+{
+    const char* mode = (argc > 1) ? argv[1] : "";
+    bool useIostream = (strcmp(mode, "--iostream") == 0);
+    bool useBinary = (strcmp(mode, "--binary") == 0);
+    bool convert = (strcmp(mode, "--convert") == 0);
+    InputText input = {nullptr, 0, false};
+    if (!useIostream && !load_input(input)) {
+        if (useBinary) {
+            cout << "Invalid input format" << endl;
+            return -1;
+        }
+        useIostream = true;
+    }
+
+    if (convert) {
+        SpscRing<ParsedCommand> commands(RING_CAPACITY);
+        string unknown;
+        thread parser = useIostream ? thread(parse_commands, &commands, &unknown)
+                                    : thread(parse_mapped_commands, &commands, &unknown, &input);
+        convert_commands(&commands, &unknown);
+        parser.join();
+        release_input(input);
+        return 0;
+    }
 
     // Init
 	world_cup_t *obj = new world_cup_t();
-	
+    SpscRing<ParsedCommand> commands(RING_CAPACITY);
+    SpscRing<Output> outputs(RING_CAPACITY);
+    string unknown;
+    bool failed = false;
+
     // Execute all commands in file
+    thread parser = useIostream ? thread(parse_commands, &commands, &unknown)
+                  : useBinary   ? thread(parse_binary_commands, &commands, &unknown, &input)
+                                : thread(parse_mapped_commands, &commands, &unknown, &input);
+    thread writer(write_outputs, &outputs, &unknown, &failed, useIostream);
+    execute_commands(obj, &commands, &outputs);
+    parser.join();
+    writer.join();
+
+    // Quit
+    release_input(input);
+	delete obj;
+	return failed ? -1 : 0;
+}
+
+// Input
+bool load_input(InputText& input)
+{
+    struct stat status;
+    if (fstat(STDIN_FILENO, &status) == 0 && S_ISREG(status.st_mode)) {
+        input.m_size = status.st_size;
+        if (input.m_size == 0) {
+            return true;
+        }
+        void* data = mmap(nullptr, input.m_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, input.m_size, MADV_SEQUENTIAL);
+            input.m_data = static_cast<char*>(data);
+            input.m_mapped = true;
+            return true;
+        }
+    }
+    // A pipe, or a file that cannot be mapped, is read whole
+    size_t capacity = 1 << 20;
+    input.m_data = static_cast<char*>(malloc(capacity));
+    input.m_size = 0;
+    if (input.m_data == nullptr) {
+        return false;
+    }
+    while (true) {
+        if (input.m_size == capacity) {
+            char* larger = static_cast<char*>(realloc(input.m_data, capacity * 2));
+            if (larger == nullptr) {
+                break;
+            }
+            input.m_data = larger;
+            capacity *= 2;
+        }
+        ssize_t count = read(STDIN_FILENO, input.m_data + input.m_size, capacity - input.m_size);
+        if (count <= 0) {
+            break;
+        }
+        input.m_size += count;
+    }
+    // As with cin, a failed read ends the input - the commands read so far still run
+    return true;
+}
+
+void release_input(InputText& input)
+{
+    if (input.m_mapped) {
+        munmap(input.m_data, input.m_size);
+    }
+    else {
+        free(input.m_data);
+    }
+}
+
+// Stages
+void parse_commands(SpscRing<ParsedCommand>* commands, string* unknown)
+{
+    cin >> std::boolalpha;
+
+    // The arguments keep their values between commands, as a failed read leaves the rest of them unchanged
+    int d[5] = {0, 0, 0, 0, 0};
+    bool b1 = false;
+
 	string op;
-    int line;
+    ParsedCommand parsed;
 	while (cin >> op)
     {
-        if (!op.compare("add_team")) {
-            cin >> d1 >> d2;
-            print(op, obj->add_team(d1, d2));
-        } else if (!op.compare("remove_team")) {
-            cin >> d1;
-            print(op, obj->remove_team(d1));
-        } else if (!op.compare("add_player")) {
-            cin >> d1 >> d2 >> d3 >> d4 >> d5 >> b1;
-            print(op, obj->add_player(d1, d2, d3, d4, d5, b1));
-        } else if (!op.compare("remove_player")) {
-            cin >> d1;
-            print(op, obj->remove_player(d1));
-        } else if (!op.compare("update_player_stats")) {
-            cin >> d1 >> d2 >> d3 >> d4;
-            print(op, obj->update_player_stats(d1, d2, d3, d4));
-        } else if (!op.compare("play_match")) {
-            cin >> d1 >> d2;
-            print(op, obj->play_match(d1, d2));
-        } else if (!op.compare("get_num_played_games")) {
-            cin >> d1;
-            print(op, obj->get_num_played_games(d1));
-        } else if (!op.compare("get_team_points")) {
-            cin >> d1;
-            print(op, obj->get_team_points(d1));
-        } else if (!op.compare("unite_teams")) {
-            cin >> d1 >> d2 >> d3;
-            print(op, obj->unite_teams(d1, d2, d3));
-        } else if (!op.compare("get_top_scorer")) {
-            cin >> d1;
-            print(op, obj->get_top_scorer(d1));
-        } else if (!op.compare("get_all_players_count")) {
-            cin >> d1;
-            print(op, obj->get_all_players_count(d1));
-        } else if (!op.compare("get_all_players")) {
-            cin >> d1;
-            query_get_all_players(op, obj, d1);
-        } else if (!op.compare("get_closest_player")) {
-            cin >> d1 >> d2;
-            print(op, obj->get_closest_player(d1, d2));
-        } else if (!op.compare("knockout_winner")) {
-            cin >> d1 >> d2;
-            print(op, obj->knockout_winner(d1, d2));
-        } else {
-            cout << "Unknown command: " << op << endl;
-            return -1;
+        int index = 0;
+        while (index < NUM_COMMANDS && op.compare(CommandNames[index].m_name) != 0) {
+            index++;
         }
-        // Verify no faults
-        if (cin.fail()){
-            cout << "Invalid input format" << endl;
-            return -1;
+        if (index == NUM_COMMANDS) {
+            // The writer reads the name only after it received the marker
+            *unknown = op;
+            parsed.m_status = ParseStatus::UNKNOWN;
+            commands->push(parsed);
+            return;
+        }
+        for (int i = 0; i < CommandNames[index].m_numArgs; i++) {
+            cin >> d[i];
+        }
+        if (CommandNames[index].m_type == CommandType::ADD_PLAYER) {
+            cin >> b1;
+        }
+        parsed.m_command.m_type = CommandNames[index].m_type;
+        memcpy(parsed.m_command.m_args, d, sizeof(d));
+        parsed.m_command.m_flag = b1;
+        parsed.m_command.m_output = nullptr;
+        // Verify no faults - the command still runs, and the run ends right after it
+        parsed.m_status = cin.fail() ? ParseStatus::BAD_FORMAT : ParseStatus::COMMAND;
+        commands->push(parsed);
+        if (parsed.m_status == ParseStatus::BAD_FORMAT) {
+            return;
+        }
+    }
+    parsed.m_status = ParseStatus::END;
+    commands->push(parsed);
+}
+
+// The same characters cin skips as white space
+static inline bool is_space(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Finds a command by the length of its name and, where names share a length, a letter that tells them apart
+static int find_command(const char* token, size_t length)
+{
+    int index;
+    switch (length) {
+        case 8:  index = 0; break;                                          // add_team
+        case 10: index = (token[0] == 'a') ? 2 : 5; break;                  // add_player, play_match
+        case 11: index = (token[0] == 'r') ? 1 : 8; break;                  // remove_team, unite_teams
+        case 13: index = 3; break;                                          // remove_player
+        case 14: index = 9; break;                                          // get_top_scorer
+        case 15: index = (token[0] == 'k') ? 13 : (token[4] == 't') ? 7 : 11; // knockout_winner, get_team_points,
+            break;                                                          // get_all_players
+        case 18: index = 12; break;                                         // get_closest_player
+        case 19: index = 4; break;                                          // update_player_stats
+        case 20: index = 6; break;                                          // get_num_played_games
+        case 21: index = 10; break;                                         // get_all_players_count
+        default: return -1;
+    }
+    return (memcmp(token, CommandNames[index].m_name, length) == 0) ? index : -1;
+}
+
+// Reads an integer as cin does - a value out of range fails and is clamped, and no digits fail and give 0
+static bool parse_int(const char*& pos, const char* end, int& value)
+{
+    while (pos < end && is_space(*pos)) {
+        pos++;
+    }
+    // At the end of the input, cin fails before reading and leaves the value as it was
+    if (pos == end) {
+        return false;
+    }
+    bool negative = false;
+    if (pos < end && (*pos == '-' || *pos == '+')) {
+        negative = (*pos == '-');
+        pos++;
+    }
+    const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+    long long magnitude = 0;
+    bool overflow = false;
+    const char* digits = pos;
+    while (pos < end && *pos >= '0' && *pos <= '9') {
+        magnitude = magnitude * 10 + (*pos - '0');
+        if (magnitude > limit) {
+            overflow = true;
+            magnitude = limit;
         }
-        line++;
+        pos++;
     }
+    if (pos == digits) {
+        value = 0;
+        return false;
+    }
+    value = negative ? static_cast<int>(-magnitude) : static_cast<int>(magnitude);
+    return !overflow;
+}
 
-    // Quit 
-	delete obj;
-	return 0;
+// Reads "true" or "false" as cin does with boolalpha - anything else fails and gives false
+static bool parse_bool(const char*& pos, const char* end, bool& value)
+{
+    while (pos < end && is_space(*pos)) {
+        pos++;
+    }
+    if (pos == end) {
+        return false;
+    }
+    if (end - pos >= 4 && memcmp(pos, "true", 4) == 0) {
+        value = true;
+        pos += 4;
+        return true;
+    }
+    if (end - pos >= 5 && memcmp(pos, "false", 5) == 0) {
+        value = false;
+        pos += 5;
+        return true;
+    }
+    value = false;
+    return false;
+}
+
+void parse_mapped_commands(SpscRing<ParsedCommand>* commands, string* unknown, const InputText* input)
+{
+    const char* pos = input->m_data;
+    const char* end = input->m_data + input->m_size;
+
+    // The arguments keep their values between commands, as in parse_commands
+    int d[5] = {0, 0, 0, 0, 0};
+    bool b1 = false;
+
+    ParsedCommand parsed;
+    while (true)
+    {
+        while (pos < end && is_space(*pos)) {
+            pos++;
+        }
+        if (pos == end) {
+            break;
+        }
+        const char* token = pos;
+        while (pos < end && !is_space(*pos)) {
+            pos++;
+        }
+        int index = find_command(token, pos - token);
+        if (index < 0) {
+            unknown->assign(token, pos - token);
+            parsed.m_status = ParseStatus::UNKNOWN;
+            commands->push(parsed);
+            return;
+        }
+        // Once a read fails, cin reads none of the arguments after it
+        bool ok = true;
+        for (int i = 0; ok && i < CommandNames[index].m_numArgs; i++) {
+            ok = parse_int(pos, end, d[i]);
+        }
+        if (ok && CommandNames[index].m_type == CommandType::ADD_PLAYER) {
+            ok = parse_bool(pos, end, b1);
+        }
+        parsed.m_command.m_type = CommandNames[index].m_type;
+        memcpy(parsed.m_command.m_args, d, sizeof(d));
+        parsed.m_command.m_flag = b1;
+        parsed.m_command.m_output = nullptr;
+        parsed.m_status = ok ? ParseStatus::COMMAND : ParseStatus::BAD_FORMAT;
+        commands->push(parsed);
+        if (!ok) {
+            return;
+        }
+    }
+    parsed.m_status = ParseStatus::END;
+    commands->push(parsed);
+}
+
+void parse_binary_commands(SpscRing<ParsedCommand>* commands, string* unknown, const InputText* input)
+{
+    CommandLogReader reader(input->m_data, input->m_size);
+    ParsedCommand parsed;
+    while (true) {
+        switch (reader.next(parsed.m_command, *unknown)) {
+            case LogRecord::COMMAND:
+                parsed.m_status = ParseStatus::COMMAND;
+                commands->push(parsed);
+                continue;
+            case LogRecord::UNKNOWN:
+                parsed.m_status = ParseStatus::UNKNOWN;
+                break;
+            case LogRecord::END:
+                parsed.m_status = ParseStatus::END;
+                break;
+            default:
+                // The command before a bad format record already ran, as the text command did
+                parsed.m_status = ParseStatus::INVALID;
+                break;
+        }
+        commands->push(parsed);
+        return;
+    }
+}
+
+void convert_commands(SpscRing<ParsedCommand>* commands, const string* unknown)
+{
+    CommandLogWriter writer(cout);
+    ParsedCommand parsed;
+    while (true) {
+        commands->pop(parsed);
+        if (parsed.m_status == ParseStatus::END) {
+            return;
+        }
+        if (parsed.m_status == ParseStatus::UNKNOWN) {
+            writer.write_unknown(*unknown);
+            return;
+        }
+        writer.write_command(parsed.m_command);
+        if (parsed.m_status == ParseStatus::BAD_FORMAT) {
+            writer.write_bad_format();
+            return;
+        }
+    }
+}
+
+void execute_commands(world_cup_t *obj, SpscRing<ParsedCommand>* commands, SpscRing<Output>* outputs)
+{
+    ParsedCommand parsed;
+    Output output;
+    while (true) {
+        commands->pop(parsed);
+        if (parsed.m_status == ParseStatus::END || parsed.m_status == ParseStatus::UNKNOWN) {
+            output.m_kind = (parsed.m_status == ParseStatus::END) ? OutputKind::END : OutputKind::UNKNOWN;
+            outputs->push(output);
+            return;
+        }
+        if (parsed.m_status == ParseStatus::INVALID) {
+            output.m_kind = OutputKind::BAD_FORMAT;
+            outputs->push(output);
+            return;
+        }
+        outputs->push(execute(obj, parsed.m_command));
+        if (parsed.m_status == ParseStatus::BAD_FORMAT) {
+            output.m_kind = OutputKind::BAD_FORMAT;
+            outputs->push(output);
+            return;
+        }
+    }
 }
 
 // Helpers
@@ -91,21 +464,191 @@ static const char *StatusTypeStr[] =
 	"FAILURE"
 };
 
-void print(string cmd, StatusType res) 
+// The output is gathered in a buffer and written in large blocks, instead of flushing every line
+static const int OUTPUT_BUFFER = 1 << 16;
+
+static void append(char* buffer, int& length, const char* text)
+{
+    int size = strlen(text);
+    if (length + size > OUTPUT_BUFFER) {
+        cout.write(buffer, length);
+        length = 0;
+        if (size > OUTPUT_BUFFER) {
+            cout.write(text, size);
+            return;
+        }
+    }
+    memcpy(buffer + length, text, size);
+    length += size;
+}
+
+static void append(char* buffer, int& length, int value)
+{
+    char digits[12];
+    int index = sizeof(digits);
+    digits[--index] = '\0';
+    unsigned int magnitude = (value < 0) ? 0u - static_cast<unsigned int>(value) : value;
+    do {
+        digits[--index] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        digits[--index] = '-';
+    }
+    append(buffer, length, digits + index);
+}
+
+// The original printing, one line at a time
+void print(string cmd, StatusType res)
 {
 	cout << cmd << ": " << StatusTypeStr[(int) res] << endl;
 }
 
-void print(string cmd, output_t<int> res)
+void print(string cmd, const Output& res)
 {
-    if (res.status() == StatusType::SUCCESS) {
-	    cout << cmd << ": " << StatusTypeStr[(int) res.status()] << ", " << res.ans() << endl;
+    if (res.m_kind == OutputKind::VALUE && res.m_status == StatusType::SUCCESS) {
+        cout << cmd << ": " << StatusTypeStr[(int) res.m_status] << ", " << res.m_value << endl;
     } else {
-	    cout << cmd << ": " << StatusTypeStr[(int) res.status()] << endl;
+        print(cmd, res.m_status);
+    }
+    if (res.m_kind == OutputKind::PLAYERS && res.m_status == StatusType::SUCCESS) {
+        for (int i = 0; i < res.m_value; ++i)
+        {
+            cout << res.m_players[i] << endl;
+        }
+    }
+}
+
+void write_outputs(SpscRing<Output>* outputs, const string* unknown, bool* failed, bool lineByLine)
+{
+    char* buffer = new char[OUTPUT_BUFFER];
+    int length = 0;
+    Output output;
+    while (true) {
+        outputs->pop(output);
+        if (output.m_kind == OutputKind::END) {
+            break;
+        }
+        if (lineByLine && (output.m_kind == OutputKind::UNKNOWN || output.m_kind == OutputKind::BAD_FORMAT)) {
+            cout << ((output.m_kind == OutputKind::UNKNOWN) ? "Unknown command: " + *unknown
+                                                            : string("Invalid input format")) << endl;
+            *failed = true;
+            break;
+        }
+        if (lineByLine) {
+            print(CommandNames[static_cast<int>(output.m_type)].m_name, output);
+            delete[] output.m_players;
+            continue;
+        }
+        if (output.m_kind == OutputKind::UNKNOWN) {
+            append(buffer, length, "Unknown command: ");
+            append(buffer, length, unknown->c_str());
+            append(buffer, length, "\n");
+            *failed = true;
+            break;
+        }
+        if (output.m_kind == OutputKind::BAD_FORMAT) {
+            append(buffer, length, "Invalid input format\n");
+            *failed = true;
+            break;
+        }
+        append(buffer, length, CommandNames[static_cast<int>(output.m_type)].m_name);
+        append(buffer, length, ": ");
+        append(buffer, length, StatusTypeStr[(int) output.m_status]);
+        if (output.m_kind == OutputKind::VALUE && output.m_status == StatusType::SUCCESS) {
+            append(buffer, length, ", ");
+            append(buffer, length, output.m_value);
+        }
+        append(buffer, length, "\n");
+        if (output.m_kind == OutputKind::PLAYERS) {
+            if (output.m_status == StatusType::SUCCESS) {
+                for (int i = 0; i < output.m_value; ++i)
+                {
+                    append(buffer, length, output.m_players[i]);
+                    append(buffer, length, "\n");
+                }
+            }
+            delete[] output.m_players;
+        }
+    }
+    cout.write(buffer, length);
+    cout.flush();
+    delete[] buffer;
+}
+
+static Output status_output(StatusType res)
+{
+    Output output;
+    output.m_kind = OutputKind::STATUS;
+    output.m_status = res;
+    output.m_value = 0;
+    output.m_players = nullptr;
+    return output;
+}
+
+static Output value_output(output_t<int> res)
+{
+    Output output;
+    output.m_kind = OutputKind::VALUE;
+    output.m_status = res.status();
+    output.m_value = res.ans();
+    output.m_players = nullptr;
+    return output;
+}
+
+Output execute(world_cup_t *obj, const Command& command)
+{
+    const int* d = command.m_args;
+    Output output;
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+            output = status_output(obj->add_team(d[0], d[1]));
+            break;
+        case CommandType::REMOVE_TEAM:
+            output = status_output(obj->remove_team(d[0]));
+            break;
+        case CommandType::ADD_PLAYER:
+            output = status_output(obj->add_player(d[0], d[1], d[2], d[3], d[4], command.m_flag));
+            break;
+        case CommandType::REMOVE_PLAYER:
+            output = status_output(obj->remove_player(d[0]));
+            break;
+        case CommandType::UPDATE_PLAYER_STATS:
+            output = status_output(obj->update_player_stats(d[0], d[1], d[2], d[3]));
+            break;
+        case CommandType::PLAY_MATCH:
+            output = status_output(obj->play_match(d[0], d[1]));
+            break;
+        case CommandType::GET_NUM_PLAYED_GAMES:
+            output = value_output(obj->get_num_played_games(d[0]));
+            break;
+        case CommandType::GET_TEAM_POINTS:
+            output = value_output(obj->get_team_points(d[0]));
+            break;
+        case CommandType::UNITE_TEAMS:
+            output = status_output(obj->unite_teams(d[0], d[1], d[2]));
+            break;
+        case CommandType::GET_TOP_SCORER:
+            output = value_output(obj->get_top_scorer(d[0]));
+            break;
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+            output = value_output(obj->get_all_players_count(d[0]));
+            break;
+        case CommandType::GET_ALL_PLAYERS:
+            output = query_get_all_players(obj, d[0]);
+            break;
+        case CommandType::GET_CLOSEST_PLAYER:
+            output = value_output(obj->get_closest_player(d[0], d[1]));
+            break;
+        default:
+            output = value_output(obj->knockout_winner(d[0], d[1]));
+            break;
     }
+    output.m_type = command.m_type;
+    return output;
 }
 
-void query_get_all_players(string cmd, world_cup_t *obj, int teamID)
+Output query_get_all_players(world_cup_t *obj, int teamID)
 {
 	output_t<int> count = obj->get_all_players_count(teamID);
     // Allocate if okay
@@ -114,14 +657,10 @@ void query_get_all_players(string cmd, world_cup_t *obj, int teamID)
         out_mem = new int[count.ans()];
         for (int i = 0; i < count.ans(); ++i) out_mem[i] = -1;
     }
-    // Call function
-    StatusType status = obj->get_all_players(teamID, out_mem);
-    print(cmd, status);
-    if (status == StatusType::SUCCESS) {
-	    for (int i = 0; i < count.ans(); ++i)
-        {
-		    cout << out_mem[i] << endl;
-	    }
-    }
-    delete[] out_mem;
+    // Call function - the writer prints the players and frees the array
+    Output output = status_output(obj->get_all_players(teamID, out_mem));
+    output.m_kind = OutputKind::PLAYERS;
+    output.m_value = count.ans();
+    output.m_players = out_mem;
+    return output;
 }
@@ -0,0 +1,353 @@
+#ifndef WORLD_CUP_SYSTEM_TESTUTILS_H
+#define WORLD_CUP_SYSTEM_TESTUTILS_H
+
+#include "../worldcup23a1.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+/*
+* Helpers shared by the tests in tests/. Every test prints its results to stdout, and tests/run.sh compares them with
+* the expected output in tests/<name>.out.
+*/
+
+static const char* const STATUS_NAMES[] = {"SUCCESS", "ALLOCATION_ERROR", "INVALID_INPUT", "FAILURE"};
+
+//Print a status, as main23a1 does
+inline void print_status(const char* name, StatusType status)
+{
+    printf("%s: %s\n", name, STATUS_NAMES[static_cast<int>(status)]);
+}
+
+//Print an output_t - the answer is only printed with SUCCESS
+inline void print_output(const char* name, output_t<int> output)
+{
+    if (output.status() == StatusType::SUCCESS) {
+        printf("%s: SUCCESS, %d\n", name, output.ans());
+        return;
+    }
+    print_status(name, output.status());
+}
+
+//Print an output_t holding the number of ID's written to ids, followed by the ID's themselves
+inline void print_ids(const char* name, output_t<int> output, const int* ids)
+{
+    if (output.status() != StatusType::SUCCESS) {
+        print_status(name, output.status());
+        return;
+    }
+    printf("%s: SUCCESS, %d:", name, output.ans());
+    for (int i = 0; i < output.ans(); i++) {
+        printf(" %d", ids[i]);
+    }
+    printf("\n");
+}
+
+//Stop the test with a message once a check fails
+#define TEST_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("check failed at %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            return 1; \
+        } \
+    } while (0)
+
+
+/*
+* Class Model
+* A plain model of the players and teams of world_cup, kept in maps, that the tests compare the system with. It covers
+* the functions of the random streams of RandomStream - teams are never united.
+*/
+class Model {
+public:
+
+    struct ModelPlayer {
+        int m_id;
+        int m_team;
+        int m_games;
+        int m_goals;
+        int m_cards;
+        bool m_goalKeeper;
+    };
+
+    struct ModelTeam {
+        int m_id;
+        int m_points;
+        int m_games;
+    };
+
+    StatusType add_team(int teamId, int points)
+    {
+        if (m_teams.count(teamId) != 0) {
+            return StatusType::FAILURE;
+        }
+        m_teams[teamId] = ModelTeam{teamId, points, 0};
+        return StatusType::SUCCESS;
+    }
+
+    StatusType remove_team(int teamId)
+    {
+        if (m_teams.count(teamId) == 0 || get_team_players(teamId).size() > 0) {
+            return StatusType::FAILURE;
+        }
+        m_teams.erase(teamId);
+        return StatusType::SUCCESS;
+    }
+
+    StatusType add_player(int playerId, int teamId, int gamesPlayed, int goals, int cards, bool goalKeeper)
+    {
+        if (m_teams.count(teamId) == 0 || m_players.count(playerId) != 0) {
+            return StatusType::FAILURE;
+        }
+        //The games of the team are counted once the player joined it
+        m_players[playerId] = ModelPlayer{playerId, teamId, gamesPlayed - m_teams[teamId].m_games, goals, cards,
+                                          goalKeeper};
+        return StatusType::SUCCESS;
+    }
+
+    StatusType remove_player(int playerId)
+    {
+        if (m_players.erase(playerId) == 0) {
+            return StatusType::FAILURE;
+        }
+        return StatusType::SUCCESS;
+    }
+
+    StatusType update_player_stats(int playerId, int gamesPlayed, int goals, int cards)
+    {
+        if (m_players.count(playerId) == 0) {
+            return StatusType::FAILURE;
+        }
+        ModelPlayer& player = m_players[playerId];
+        player.m_games += gamesPlayed;
+        player.m_goals += goals;
+        player.m_cards += cards;
+        return StatusType::SUCCESS;
+    }
+
+    StatusType play_match(int teamId1, int teamId2)
+    {
+        if (!is_qualified(teamId1) || !is_qualified(teamId2)) {
+            return StatusType::FAILURE;
+        }
+        int strength1 = get_strength(teamId1);
+        int strength2 = get_strength(teamId2);
+        m_teams[teamId1].m_points += (strength1 > strength2) ? 3 : (strength1 == strength2) ? 1 : 0;
+        m_teams[teamId2].m_points += (strength2 > strength1) ? 3 : (strength1 == strength2) ? 1 : 0;
+        m_teams[teamId1].m_games++;
+        m_teams[teamId2].m_games++;
+        return StatusType::SUCCESS;
+    }
+
+    int get_num_played_games(int playerId) const
+    {
+        const ModelPlayer& player = m_players.at(playerId);
+        return player.m_games + m_teams.at(player.m_team).m_games;
+    }
+
+    //The team stats of TeamStat, in its order: points, goals, cards and players
+    int get_team_stat(int teamId, int stat) const
+    {
+        int value = (stat == 0) ? m_teams.at(teamId).m_points : 0;
+        for (std::map<int, ModelPlayer>::const_iterator it = m_players.begin(); it != m_players.end(); ++it) {
+            if (it->second.m_team == teamId) {
+                value += (stat == 1) ? it->second.m_goals : (stat == 2) ? it->second.m_cards : (stat == 3) ? 1 : 0;
+            }
+        }
+        return value;
+    }
+
+    int get_strength(int teamId) const
+    {
+        return get_team_stat(teamId, 0) + get_team_stat(teamId, 1) - get_team_stat(teamId, 2);
+    }
+
+    bool is_qualified(int teamId) const
+    {
+        if (m_teams.count(teamId) == 0) {
+            return false;
+        }
+        int players = 0;
+        bool goalKeeper = false;
+        for (std::map<int, ModelPlayer>::const_iterator it = m_players.begin(); it != m_players.end(); ++it) {
+            if (it->second.m_team == teamId) {
+                players++;
+                goalKeeper = goalKeeper || it->second.m_goalKeeper;
+            }
+        }
+        return players >= 11 && goalKeeper;
+    }
+
+    //The order of get_all_players - by goals, then by fewer cards, then by ID
+    static bool is_before(const ModelPlayer& first, const ModelPlayer& second)
+    {
+        if (first.m_goals != second.m_goals) {
+            return first.m_goals < second.m_goals;
+        }
+        if (first.m_cards != second.m_cards) {
+            return first.m_cards > second.m_cards;
+        }
+        return first.m_id < second.m_id;
+    }
+
+    //The players of a team (or of the entire game, if teamId < 0) in the order of get_all_players
+    std::vector<ModelPlayer> get_team_players(int teamId) const
+    {
+        std::vector<ModelPlayer> players;
+        for (std::map<int, ModelPlayer>::const_iterator it = m_players.begin(); it != m_players.end(); ++it) {
+            if (teamId < 0 || it->second.m_team == teamId) {
+                players.push_back(it->second);
+            }
+        }
+        std::sort(players.begin(), players.end(), is_before);
+        return players;
+    }
+
+    //The ID's of the players of a team (or of the entire game, if teamId < 0) closest to the given stats, by the
+    //difference in goals, then in cards, then in ID, then preferring the bigger ID. The given ID is skipped.
+    std::vector<int> get_closest_players(int teamId, int goals, int cards, int id) const
+    {
+        std::vector<ModelPlayer> players = get_team_players(teamId);
+        std::vector<std::pair<std::vector<int>, int> > keys;
+        for (size_t i = 0; i < players.size(); i++) {
+            const ModelPlayer& player = players[i];
+            if (player.m_id != id) {
+                std::vector<int> key = {std::abs(player.m_goals - goals), std::abs(player.m_cards - cards),
+                                        std::abs(player.m_id - id), -player.m_id};
+                keys.push_back(std::make_pair(key, player.m_id));
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        std::vector<int> closest;
+        for (size_t i = 0; i < keys.size(); i++) {
+            closest.push_back(keys[i].second);
+        }
+        return closest;
+    }
+
+    std::map<int, ModelTeam> m_teams;
+    std::map<int, ModelPlayer> m_players;
+
+};
+
+
+/*
+* Class RandomStream
+* A reproducible stream of commands over a small range of ID's, run on a system and on the model together. Teams are
+* added and removed, players are added, removed and updated, and matches are played - the statuses of the system and
+* the model are compared after every command.
+*/
+class RandomStream {
+public:
+
+    RandomStream(unsigned int seed, int numTeams, int numPlayers) :
+        m_rng(seed),
+        m_numTeams(numTeams),
+        m_numPlayers(numPlayers)
+    {}
+
+    //Run the next command on both, and return false if their statuses differ
+    bool step(world_cup_t& system, Model& model)
+    {
+        int kind = next(100);
+        int team1 = 1 + next(m_numTeams);
+        int team2 = 1 + next(m_numTeams);
+        int player = 1 + next(m_numPlayers);
+        if (kind < 5) {
+            int points = next(6);
+            return system.add_team(team1, points) == model.add_team(team1, points);
+        }
+        if (kind < 7) {
+            return system.remove_team(team1) == model.remove_team(team1);
+        }
+        if (kind < 50) {
+            int games = next(4);
+            int goals = (games > 0) ? next(8) : 0;
+            int cards = (games > 0) ? next(4) : 0;
+            bool goalKeeper = (next(5) == 0);
+            //A player may only be added with more games than its team played
+            if (model.m_teams.count(team1) != 0) {
+                games += model.m_teams[team1].m_games;
+            }
+            return system.add_player(player, team1, games, goals, cards, goalKeeper) ==
+                   model.add_player(player, team1, games, goals, cards, goalKeeper);
+        }
+        if (kind < 58) {
+            return system.remove_player(player) == model.remove_player(player);
+        }
+        if (kind < 85) {
+            int games = next(2);
+            int goals = next(3);
+            int cards = next(2);
+            return system.update_player_stats(player, games, goals, cards) ==
+                   model.update_player_stats(player, games, goals, cards);
+        }
+        if (team1 == team2) {
+            return true;
+        }
+        return system.play_match(team1, team2) == model.play_match(team1, team2);
+    }
+
+    int next(int range)
+    {
+        return static_cast<int>(m_rng() % static_cast<unsigned int>(range));
+    }
+
+private:
+
+    std::mt19937 m_rng;
+    int m_numTeams;
+    int m_numPlayers;
+
+};
+
+
+//Add 11 players with the same stats to a team, the first of them a goalkeeper, and return whether all were added
+inline bool add_squad(world_cup_t& system, int firstId, int teamId, int goals, int cards)
+{
+    bool added = true;
+    for (int i = 0; i < 11; i++) {
+        added = (system.add_player(firstId + i, teamId, 1, goals, cards, i == 0) == StatusType::SUCCESS) && added;
+    }
+    return added;
+}
+
+//Whether a player with goals playerId % 7 and no cards comes before the other player, in the order of get_all_players
+inline bool is_before(int first, int second)
+{
+    return (first % 7 != second % 7) ? first % 7 < second % 7 : first < second;
+}
+
+//Compare the players of the system, and their games, with the model
+inline bool check_players(world_cup_t& system, const Model& model)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(-1);
+    std::vector<int> output(players.size() + 1);
+    if (!players.empty() && system.get_all_players(-1, output.data()) != StatusType::SUCCESS) {
+        return false;
+    }
+    for (size_t i = 0; i < players.size(); i++) {
+        if (output[i] != players[i].m_id ||
+            system.get_num_played_games(players[i].m_id).ans() != model.get_num_played_games(players[i].m_id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Compare the points of the teams with the model, and check that every qualified team has a strength rank
+inline bool check_teams(world_cup_t& system, const Model& model)
+{
+    for (std::map<int, Model::ModelTeam>::const_iterator it = model.m_teams.begin(); it != model.m_teams.end(); ++it) {
+        if (system.get_team_points(it->first).ans() != it->second.m_points ||
+            (model.is_qualified(it->first) && system.get_team_strength_rank(it->first).status() != StatusType::SUCCESS)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif //WORLD_CUP_SYSTEM_TESTUTILS_H
@@ -0,0 +1,175 @@
+//apply_batch.cpp - apply_batch gives the same results as calling the functions one after the other
+
+#include "TestUtils.h"
+
+static const int NUM_TEAMS = 10;
+static const int NUM_PLAYERS = 150;
+
+static Result to_result(output_t<int> output)
+{
+    return {output.status(), output.ans()};
+}
+
+//Run a command through the matching function of world_cup_t
+static Result run_single(world_cup_t& system, const Command& command)
+{
+    const int* args = command.m_args;
+    Result result = {StatusType::SUCCESS, 0};
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+            result.m_status = system.add_team(args[0], args[1]);
+            return result;
+        case CommandType::REMOVE_TEAM:
+            result.m_status = system.remove_team(args[0]);
+            return result;
+        case CommandType::ADD_PLAYER:
+            result.m_status = system.add_player(args[0], args[1], args[2], args[3], args[4], command.m_flag);
+            return result;
+        case CommandType::REMOVE_PLAYER:
+            result.m_status = system.remove_player(args[0]);
+            return result;
+        case CommandType::UPDATE_PLAYER_STATS:
+            result.m_status = system.update_player_stats(args[0], args[1], args[2], args[3]);
+            return result;
+        case CommandType::PLAY_MATCH:
+            result.m_status = system.play_match(args[0], args[1]);
+            return result;
+        case CommandType::UNITE_TEAMS:
+            result.m_status = system.unite_teams(args[0], args[1], args[2]);
+            return result;
+        case CommandType::GET_ALL_PLAYERS:
+            result.m_status = system.get_all_players(args[0], command.m_output);
+            return result;
+        case CommandType::GET_NUM_PLAYED_GAMES:
+            return to_result(system.get_num_played_games(args[0]));
+        case CommandType::GET_TEAM_POINTS:
+            return to_result(system.get_team_points(args[0]));
+        case CommandType::GET_TOP_SCORER:
+            return to_result(system.get_top_scorer(args[0]));
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+            return to_result(system.get_all_players_count(args[0]));
+        case CommandType::GET_CLOSEST_PLAYER:
+            return to_result(system.get_closest_player(args[0], args[1]));
+        case CommandType::KNOCKOUT_WINNER:
+            return to_result(system.knockout_winner(args[0], args[1]));
+    }
+    return result;
+}
+
+//A random command over a small range of ID's - one in 40 has an invalid argument. A third of the commands add
+//players, so that enough teams qualify for matches.
+static Command random_command(std::mt19937& rng, int* output)
+{
+    Command command;
+    int kind = rng() % 21;
+    command.m_type = (kind < 14) ? static_cast<CommandType>(kind) : CommandType::ADD_PLAYER;
+    command.m_flag = (rng() % 4 == 0);
+    command.m_output = output;
+    int* args = command.m_args;
+    args[0] = 1 + rng() % NUM_TEAMS;
+    args[1] = 1 + rng() % NUM_TEAMS;
+    args[2] = 1 + rng() % NUM_TEAMS;
+    args[3] = rng() % 6;
+    args[4] = rng() % 3;
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+            args[1] = rng() % 5;
+            break;
+        case CommandType::ADD_PLAYER:
+            args[0] = 1 + rng() % NUM_PLAYERS;
+            args[2] = 1 + rng() % 4 + args[3];
+            break;
+        case CommandType::REMOVE_PLAYER:
+        case CommandType::GET_NUM_PLAYED_GAMES:
+        case CommandType::UPDATE_PLAYER_STATS:
+        case CommandType::GET_CLOSEST_PLAYER:
+            args[0] = 1 + rng() % NUM_PLAYERS;
+            args[1] = rng() % 2;
+            args[2] = rng() % 3;
+            args[3] = rng() % 2;
+            if (command.m_type == CommandType::GET_CLOSEST_PLAYER) {
+                args[1] = 1 + rng() % NUM_TEAMS;
+            }
+            break;
+        case CommandType::GET_TOP_SCORER:
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+        case CommandType::GET_ALL_PLAYERS:
+            args[0] = (rng() % 3 == 0) ? -1 : args[0];
+            break;
+        case CommandType::KNOCKOUT_WINNER:
+            args[0] = rng() % NUM_TEAMS;
+            args[1] = args[0] + rng() % NUM_TEAMS;
+            break;
+        default:
+            break;
+    }
+    if (rng() % 40 == 0) {
+        args[rng() % 2] = -1 - static_cast<int>(rng() % 2);
+    }
+    return command;
+}
+
+int main()
+{
+    //A fixed batch: the teams it adds are read, played and united before it ends
+    world_cup_t system;
+    int players[8];
+    Command commands[] = {
+        {CommandType::ADD_TEAM, {1, 2}, false, nullptr},
+        {CommandType::ADD_TEAM, {2, 0}, false, nullptr},
+        {CommandType::ADD_PLAYER, {10, 1, 1, 3, 0}, true, nullptr},
+        {CommandType::ADD_PLAYER, {20, 2, 1, 5, 1}, false, nullptr},
+        {CommandType::ADD_PLAYER, {-4, 2, 1, 5, 1}, false, nullptr},
+        {CommandType::GET_TEAM_POINTS, {1}, false, nullptr},
+        {CommandType::PLAY_MATCH, {1, 2}, false, nullptr},
+        {CommandType::UPDATE_PLAYER_STATS, {10, 1, 4, 0}, false, nullptr},
+        {CommandType::GET_TOP_SCORER, {-1}, false, nullptr},
+        {CommandType::UNITE_TEAMS, {1, 2, 3}, false, nullptr},
+        {CommandType::GET_ALL_PLAYERS_COUNT, {3}, false, nullptr},
+        {CommandType::GET_ALL_PLAYERS, {3}, false, players},
+        {CommandType::GET_TEAM_POINTS, {3}, false, nullptr},
+        {CommandType::REMOVE_TEAM, {1}, false, nullptr},
+        {CommandType::KNOCKOUT_WINNER, {0, 5}, false, nullptr},
+    };
+    const int numCommands = sizeof(commands) / sizeof(commands[0]);
+    Result results[numCommands];
+    print_status("apply_batch(nullptr)", system.apply_batch(nullptr, 0, results));
+    print_status("apply_batch", system.apply_batch(commands, numCommands, results));
+    for (int i = 0; i < numCommands; i++) {
+        printf("command %d (type %d): %s, %d\n", i, static_cast<int>(commands[i].m_type),
+               STATUS_NAMES[static_cast<int>(results[i].m_status)], results[i].m_value);
+    }
+    printf("players of team 3: %d %d\n", players[0], players[1]);
+
+    //Random streams, run in batches of random sizes on one system and one command at a time on another
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t batchSystem;
+        world_cup_t singleSystem;
+        std::mt19937 rng(seed);
+        std::vector<int> batchOutputs(64 * (NUM_PLAYERS + 1));
+        std::vector<int> singleOutput(NUM_PLAYERS + 1);
+        for (int batch = 0; batch < 150; batch++) {
+            int size = 1 + rng() % 64;
+            std::vector<Command> randomCommands;
+            for (int i = 0; i < size; i++) {
+                randomCommands.push_back(random_command(rng, batchOutputs.data() + i * (NUM_PLAYERS + 1)));
+            }
+            std::vector<Result> batchResults(size);
+            TEST_CHECK(batchSystem.apply_batch(randomCommands.data(), size, batchResults.data()) ==
+                       StatusType::SUCCESS);
+            for (int i = 0; i < size; i++) {
+                Command single = randomCommands[i];
+                single.m_output = singleOutput.data();
+                Result result = run_single(singleSystem, single);
+                TEST_CHECK(result.m_status == batchResults[i].m_status && result.m_value == batchResults[i].m_value);
+                if (single.m_type == CommandType::GET_ALL_PLAYERS && result.m_status == StatusType::SUCCESS) {
+                    int count = singleSystem.get_all_players_count(single.m_args[0]).ans();
+                    TEST_CHECK(std::equal(singleOutput.begin(), singleOutput.begin() + count,
+                                          randomCommands[i].m_output));
+                }
+            }
+        }
+    }
+    printf("random batches: ok\n");
+    return 0;
+}
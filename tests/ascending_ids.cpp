@@ -0,0 +1,94 @@
+//ascending_ids.cpp - the node with the largest ID, kept by Tree for appending ascending ID's
+
+#include "TestUtils.h"
+#include "../GenericNode.h"
+#include "../Player.h"
+
+typedef Tree<GenericNode<Player*>, Player*> IdTree;
+
+//Compare the tree with the set of ID's - is_consistent also checks that the largest node is the last one, and
+//find_max_data returns its player
+static bool check_tree(const IdTree& tree, const std::map<int, Player*>& players)
+{
+    if (!tree.is_consistent() || tree.get_size() != static_cast<int>(players.size())) {
+        return false;
+    }
+    int largest = players.empty() ? 0 : players.rbegin()->first;
+    Player** last = tree.find_max_data();
+    if ((last == nullptr) != players.empty() || (last != nullptr && *last != players.rbegin()->second)) {
+        return false;
+    }
+    return tree.find_data(largest + 1) == nullptr && (largest == 0 || tree.find_data(largest) != nullptr);
+}
+
+int main()
+{
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        IdTree* tree = new IdTree();
+        std::map<int, Player*> players;
+        std::vector<Player*> owned;
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 5000; i++) {
+            int kind = static_cast<int>(rng() % 10);
+            int largest = players.empty() ? 0 : players.rbegin()->first;
+            int id;
+            //Mostly appends above the largest ID, with removes of the largest and of other ID's, and some inserts
+            //below it
+            if (kind < 5) {
+                id = largest + 1 + static_cast<int>(rng() % 3);
+            }
+            else if (kind < 7 && !players.empty()) {
+                id = largest;
+            }
+            else {
+                id = 1 + static_cast<int>(rng() % (largest + 1));
+            }
+            std::map<int, Player*>::iterator it = players.find(id);
+            if (it == players.end()) {
+                owned.push_back(new Player(id, 1, 0, 0, false, nullptr));
+                tree->insert(owned.back(), id);
+                players[id] = owned.back();
+            }
+            else {
+                tree->remove(id);
+                players.erase(it);
+            }
+            //The tree is rebuilt from time to time, which finds the largest node again
+            if (i % 700 == 699) {
+                tree->compact();
+            }
+            if (i % 1100 == 1099) {
+                std::vector<Player*> sorted;
+                for (it = players.begin(); it != players.end(); ++it) {
+                    sorted.push_back(it->second);
+                }
+                delete tree;
+                tree = new IdTree();
+                tree->insertInorder(sorted.data(), static_cast<int>(sorted.size()) - 1);
+            }
+            TEST_CHECK(check_tree(*tree, players));
+        }
+        delete tree;
+        for (Player* player : owned) {
+            delete player;
+        }
+    }
+    printf("random appends: ok\n");
+
+    //Players registered in ascending order, then the last of them removed and added again
+    world_cup_t system;
+    system.add_team(1, 0);
+    for (int playerId = 1; playerId <= 30; playerId++) {
+        TEST_CHECK(system.add_player(playerId, 1, 1, playerId % 4, 0, playerId == 1) == StatusType::SUCCESS);
+    }
+    print_status("add_player(30, 1, 1, 0, 0)", system.add_player(30, 1, 1, 0, 0, false));
+    print_status("remove_player(30)", system.remove_player(30));
+    print_output("get_num_played_games(30)", system.get_num_played_games(30));
+    print_status("add_player(30, 1, 2, 0, 0)", system.add_player(30, 1, 2, 0, 0, false));
+    print_status("add_player(31, 1, 3, 0, 0)", system.add_player(31, 1, 3, 0, 0, false));
+    print_output("get_num_played_games(30)", system.get_num_played_games(30));
+    print_output("get_num_played_games(31)", system.get_num_played_games(31));
+    print_output("get_num_played_games(32)", system.get_num_played_games(32));
+    print_output("get_all_players_count(1)", system.get_all_players_count(1));
+    return 0;
+}
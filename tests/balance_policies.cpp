@@ -0,0 +1,169 @@
+//balance_policies.cpp - Tree and MultiTree under AVLBalance, TreapBalance and WeightBalance
+
+#include "TestUtils.h"
+#include "../AVLMultiVariable.h"
+#include "../GenericNode.h"
+#include "../Player.h"
+
+//Compare both trees with the model - their invariants, the balance of their policy, their sizes and the order of
+//the players by score
+template <class B>
+static bool check_trees(MultiTree<Player*, B>& byScore, const Tree<GenericNode<Player*>, Player*, B>& byId,
+                        const std::map<int, Player*>& players)
+{
+    if (!byScore.is_consistent() || !byId.is_consistent() || !byScore.is_balanced() || !byId.is_balanced() ||
+        byScore.get_size() != static_cast<int>(players.size()) || byId.get_size() != static_cast<int>(players.size())) {
+        return false;
+    }
+    std::vector<Model::ModelPlayer> sorted;
+    for (std::map<int, Player*>::const_iterator it = players.begin(); it != players.end(); ++it) {
+        sorted.push_back(Model::ModelPlayer{it->first, 0, 0, it->second->get_goals(), it->second->get_cards(), false});
+    }
+    std::vector<int> ids(players.size() + 1);
+    std::sort(sorted.begin(), sorted.end(), Model::is_before);
+    byScore.get_all_data(ids.data());
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (ids[i] != sorted[i].m_id || byId.find_data(sorted[i].m_id) == nullptr ||
+            byScore.get_rank(sorted[i].m_id, sorted[i].m_goals, sorted[i].m_cards) !=
+                static_cast<int>(sorted.size() - i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Players with ascending ID's, then the ranks and the top scorers of the tree
+template <class B>
+static void print_ascending(const char* name)
+{
+    MultiTree<Player*, B> byScore;
+    Tree<GenericNode<Player*>, Player*, B> byId;
+    std::vector<Player*> owned;
+    for (int id = 1; id <= 31; id++) {
+        owned.push_back(new Player(id, 1, id % 4, id % 3, false, nullptr));
+        byScore.insert(owned.back(), id, id % 4, id % 3);
+        byId.insert(owned.back(), id);
+    }
+    for (int id = 2; id <= 31; id += 3) {
+        byScore.remove(id, id % 4, id % 3);
+        byId.remove(id);
+    }
+    int top[3];
+    int amount = byScore.get_top_data(top, 3);
+    printf("%s: size %d, consistent %d, balanced %d, rank of 7 %d, top %d: %d %d %d\n", name, byScore.get_size(),
+           byScore.is_consistent() && byId.is_consistent(), byScore.is_balanced() && byId.is_balanced(),
+           byScore.get_rank(7, 3, 1), amount, top[0], top[1], top[2]);
+    for (Player* player : owned) {
+        delete player;
+    }
+}
+
+//Random inserts, removes and repositions, with the trees rebuilt from time to time - by compact, or by
+//rebalance_all after a stretch of relaxed balance. Returns 1 once a check fails
+template <class B>
+static int run_random(const char* name)
+{
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        MultiTree<Player*, B> byScore;
+        Tree<GenericNode<Player*>, Player*, B> byId;
+        std::map<int, Player*> players;
+        std::vector<Player*> owned;
+        std::mt19937 rng(seed);
+        int nextId = 1;
+        for (int i = 0; i < 3000; i++) {
+            //Half of the ID's are ascending, as when players register one after another
+            int id = (rng() % 2 == 0) ? nextId++ : 1 + static_cast<int>(rng() % (nextId + 100));
+            int goals = static_cast<int>(rng() % 3);
+            int cards = static_cast<int>(rng() % 2);
+            std::map<int, Player*>::iterator it = players.find(id);
+            if (it == players.end()) {
+                owned.push_back(new Player(id, 1, goals, cards, false, nullptr));
+                byScore.insert(owned.back(), id, goals, cards);
+                byId.insert(owned.back(), id);
+                players[id] = owned.back();
+            }
+            else if (rng() % 3 != 0) {
+                byScore.remove(id, it->second->get_goals(), it->second->get_cards());
+                byId.remove(id);
+                players.erase(it);
+            }
+            else {
+                Player* player = it->second;
+                byScore.reposition(id, player->get_goals(), player->get_cards(), player->get_goals() + goals,
+                                   player->get_cards() + cards);
+                player->update_goals(goals);
+                player->update_cards(cards);
+            }
+            if (i % 500 == 0) {
+                byScore.set_relaxed((i % 1000 == 0) ? 1 : 3);
+                byId.set_relaxed((i % 1000 == 0) ? 1 : 3);
+            }
+            if (i % 1000 == 499) {
+                byScore.compact();
+                byId.compact();
+            }
+            else if (i % 1000 == 999) {
+                byScore.set_relaxed(1);
+                byId.set_relaxed(1);
+                byScore.rebalance_all();
+                byId.rebalance_all();
+            }
+            TEST_CHECK(check_trees(byScore, byId, players));
+        }
+        for (Player* player : owned) {
+            delete player;
+        }
+    }
+    printf("random %s: ok\n", name);
+    return 0;
+}
+
+//Trees built by insertInorder from sorted players of every size up to 300. Returns 1 once a check fails
+template <class B>
+static int build_inorder(const char* name)
+{
+    std::vector<Player*> owned;
+    std::map<int, Player*> players;
+    std::vector<Player*> byScoreOrder;
+    for (int size = 1; size <= 300; size++) {
+        owned.push_back(new Player(size * 7, 1, size % 5, size % 2, false, nullptr));
+        players[size * 7] = owned.back();
+        std::vector<Player*> byIdOrder;
+        for (std::map<int, Player*>::iterator it = players.begin(); it != players.end(); ++it) {
+            byIdOrder.push_back(it->second);
+        }
+        byScoreOrder = byIdOrder;
+        std::sort(byScoreOrder.begin(), byScoreOrder.end(), [](const Player* first, const Player* second) {
+            return Model::is_before(Model::ModelPlayer{first->get_playerId(), 0, 0, first->get_goals(),
+                                                       first->get_cards(), false},
+                                    Model::ModelPlayer{second->get_playerId(), 0, 0, second->get_goals(),
+                                                       second->get_cards(), false});
+        });
+        MultiTree<Player*, B> byScore;
+        Tree<GenericNode<Player*>, Player*, B> byId;
+        byScore.insertInorder(byScoreOrder.data(), size - 1);
+        byId.insertInorder(byIdOrder.data(), size - 1);
+        TEST_CHECK(check_trees(byScore, byId, players));
+    }
+    for (Player* player : owned) {
+        delete player;
+    }
+    printf("insertInorder %s: ok\n", name);
+    return 0;
+}
+
+int main()
+{
+    print_ascending<AVLBalance>("AVLBalance");
+    print_ascending<TreapBalance>("TreapBalance");
+    print_ascending<WeightBalance>("WeightBalance");
+    if (run_random<AVLBalance>("AVLBalance") != 0 || run_random<TreapBalance>("TreapBalance") != 0 ||
+        run_random<WeightBalance>("WeightBalance") != 0) {
+        return 1;
+    }
+    if (build_inorder<AVLBalance>("AVLBalance") != 0 || build_inorder<TreapBalance>("TreapBalance") != 0 ||
+        build_inorder<WeightBalance>("WeightBalance") != 0) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+//closest_players.cpp - get_closest_players and get_closest_to_profile of a team and of the entire game
+
+#include "TestUtils.h"
+
+//Compare the output of a query with the expected players, of which only the first amount are inserted
+static bool check_output(output_t<int> found, const std::vector<int>& expected, const std::vector<int>& output,
+                         int amount)
+{
+    if (expected.empty()) {
+        return found.status() == StatusType::FAILURE;
+    }
+    int size = std::min(amount, static_cast<int>(expected.size()));
+    return found.status() == StatusType::SUCCESS && found.ans() == size &&
+           std::equal(expected.begin(), expected.begin() + size, output.begin());
+}
+
+//Compare both queries with the model, for the players of a team (or of the entire game, if teamId < 0)
+static bool check_closest(world_cup_t& system, const Model& model, int teamId, int playerId, int goals, int cards,
+                          int amount)
+{
+    std::vector<int> output(amount);
+    output_t<int> profile = system.get_closest_to_profile(goals, cards, teamId, amount, output.data());
+    if (!check_output(profile, model.get_closest_players(teamId, goals, cards, 0), output, amount)) {
+        return false;
+    }
+    std::map<int, Model::ModelPlayer>::const_iterator it = model.m_players.find(playerId);
+    output_t<int> byPlayer = system.get_closest_players(playerId, teamId, amount, output.data());
+    if (it == model.m_players.end() || (teamId > 0 && it->second.m_team != teamId)) {
+        return byPlayer.status() == StatusType::FAILURE;
+    }
+    std::vector<int> expected = model.get_closest_players(teamId, it->second.m_goals, it->second.m_cards, playerId);
+    return check_output(byPlayer, expected, output, amount);
+}
+
+int main()
+{
+    int output[8];
+    world_cup_t system;
+    system.add_team(1, 0);
+    system.add_team(2, 0);
+    system.add_player(10, 1, 1, 3, 1, false);
+    print_ids("get_closest_players(10, 1, 3) of a single player", system.get_closest_players(10, 1, 3, output),
+              output);
+    system.add_player(11, 1, 1, 3, 2, false);
+    system.add_player(12, 1, 1, 5, 1, false);
+    system.add_player(13, 1, 1, 1, 1, false);
+    system.add_player(9, 1, 1, 3, 0, false);
+    system.add_player(20, 2, 1, 3, 1, false);
+    print_ids("get_closest_players(10, 1, 8)", system.get_closest_players(10, 1, 8, output), output);
+    print_ids("get_closest_players(10, -1, 8)", system.get_closest_players(10, -1, 8, output), output);
+    print_ids("get_closest_players(10, -1, 2)", system.get_closest_players(10, -1, 2, output), output);
+    print_ids("get_closest_to_profile(4, 1, 1, 8)", system.get_closest_to_profile(4, 1, 1, 8, output), output);
+    print_ids("get_closest_to_profile(0, 5, -1, 3)", system.get_closest_to_profile(0, 5, -1, 3, output), output);
+    print_ids("get_closest_players(20, 1, 3)", system.get_closest_players(20, 1, 3, output), output);
+    print_ids("get_closest_players(30, -1, 3)", system.get_closest_players(30, -1, 3, output), output);
+    print_ids("get_closest_to_profile(0, 0, 3, 3)", system.get_closest_to_profile(0, 0, 3, 3, output), output);
+    print_ids("get_closest_players(10, 0, 3)", system.get_closest_players(10, 0, 3, output), output);
+    print_ids("get_closest_to_profile(-1, 0, 1, 3)", system.get_closest_to_profile(-1, 0, 1, 3, output), output);
+    print_ids("get_closest_to_profile(0, 0, 1, 0)", system.get_closest_to_profile(0, 0, 1, 0, output), output);
+
+    //Random streams of commands, checking a random player and profile after each command
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 6, 120);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            int teamId = 1 + stream.next(6);
+            int playerId = 1 + stream.next(120);
+            int goals = stream.next(14);
+            int cards = stream.next(6);
+            int amount = 1 + stream.next(40);
+            if (model.m_teams.count(teamId) != 0) {
+                TEST_CHECK(check_closest(randomSystem, model, teamId, playerId, goals, cards, amount));
+            }
+            TEST_CHECK(check_closest(randomSystem, model, -1, playerId, goals, cards, amount));
+        }
+    }
+    printf("random closest players: ok\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+//command_log.cpp - CommandLogWriter and CommandLogReader: the encoding, round trips, cut logs and corrupt records
+
+#include "TestUtils.h"
+#include "../CommandLog.h"
+#include <climits>
+#include <sstream>
+
+static const char* RECORD_NAMES[] = {"COMMAND", "BAD_FORMAT", "UNKNOWN", "END", "CORRUPT"};
+static const int NUM_ARGS[] = {2, 1, 5, 1, 4, 2, 1, 1, 3, 1, 1, 1, 2, 2};
+
+//A command with the given type and arguments
+static Command make_command(CommandType type, int a0, int a1 = 0, int a2 = 0, int a3 = 0, int a4 = 0, bool flag = false)
+{
+    Command command = {type, {a0, a1, a2, a3, a4}, flag, nullptr};
+    return command;
+}
+
+//A random command - the arguments are small, or anywhere in the range of int
+static Command random_command(std::mt19937& rng)
+{
+    Command command;
+    command.m_type = static_cast<CommandType>(rng() % 14);
+    for (int i = 0; i < 5; i++) {
+        command.m_args[i] = (rng() % 2 == 0) ? static_cast<int>(rng() % 200) - 100 : static_cast<int>(rng());
+    }
+    command.m_flag = (command.m_type == CommandType::ADD_PLAYER && rng() % 2 == 0);
+    command.m_output = nullptr;
+    return command;
+}
+
+//Whether two commands have the same type, arguments and goalKeeper flag
+static bool same_command(const Command& first, const Command& second)
+{
+    int type = static_cast<int>(first.m_type);
+    if (first.m_type != second.m_type || first.m_flag != second.m_flag) {
+        return false;
+    }
+    for (int i = 0; i < NUM_ARGS[type]; i++) {
+        if (first.m_args[i] != second.m_args[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Encode the commands, followed by the record that ends the log (END adds none)
+static std::string encode(const std::vector<Command>& commands, LogRecord ending, const std::string& unknown)
+{
+    std::ostringstream out;
+    {
+        CommandLogWriter writer(out);
+        for (const Command& command : commands) {
+            writer.write_command(command);
+        }
+        if (ending == LogRecord::BAD_FORMAT) {
+            writer.write_bad_format();
+        }
+        else if (ending == LogRecord::UNKNOWN) {
+            writer.write_unknown(unknown);
+        }
+    }
+    return out.str();
+}
+
+//Decode a log into its commands, and return the record that ended it
+static LogRecord decode(const std::string& log, std::vector<Command>& commands, std::string& unknown)
+{
+    CommandLogReader reader(log.data(), log.size());
+    Command command;
+    LogRecord record;
+    while ((record = reader.next(command, unknown)) == LogRecord::COMMAND) {
+        commands.push_back(command);
+    }
+    //Once the log ended, the reader keeps returning the same record
+    std::string again;
+    return (reader.next(command, again) == record) ? record : LogRecord::CORRUPT;
+}
+
+//Decode the bytes and print the record that ends them
+static void print_decoded(const char* name, const std::string& log)
+{
+    std::vector<Command> commands;
+    std::string unknown;
+    LogRecord record = decode(log, commands, unknown);
+    printf("%s: %d commands, then %s\n", name, static_cast<int>(commands.size()), RECORD_NAMES[static_cast<int>(record)]);
+}
+
+int main()
+{
+    std::vector<Command> fixed;
+    fixed.push_back(make_command(CommandType::ADD_TEAM, 1, 2));
+    fixed.push_back(make_command(CommandType::ADD_PLAYER, 5, 1, 1, -1, 0, true));
+    fixed.push_back(make_command(CommandType::KNOCKOUT_WINNER, INT_MIN, INT_MAX));
+    std::string log = encode(fixed, LogRecord::UNKNOWN, "foo");
+    printf("log of %d bytes:", static_cast<int>(log.size()));
+    for (char byte : log) {
+        printf(" %02x", static_cast<unsigned char>(byte));
+    }
+    printf("\n");
+    std::vector<Command> decoded;
+    std::string unknown;
+    LogRecord record = decode(log, decoded, unknown);
+    for (const Command& command : decoded) {
+        printf("command %d:", static_cast<int>(command.m_type));
+        for (int i = 0; i < NUM_ARGS[static_cast<int>(command.m_type)]; i++) {
+            printf(" %d", command.m_args[i]);
+        }
+        printf("%s\n", command.m_flag ? " true" : "");
+    }
+    printf("ended by %s \"%s\"\n", RECORD_NAMES[static_cast<int>(record)], unknown.c_str());
+    print_decoded("empty log", encode(std::vector<Command>(), LogRecord::END, ""));
+    print_decoded("bad format", encode(fixed, LogRecord::BAD_FORMAT, ""));
+
+    //Corrupt logs: no header, the goalKeeper bit on another command, a varint of 6 bytes, a fifth varint byte above 4
+    //bits, and an unknown name longer than the rest of the log
+    std::string header = log.substr(0, 4);
+    print_decoded("text input", std::string("add_team 1 2\n"));
+    print_decoded("goalKeeper bit on add_team", header + std::string("\x10\x02\x04", 3));
+    print_decoded("long varint", header + std::string("\x06\x80\x80\x80\x80\x80\x00", 7));
+    print_decoded("wide varint", header + std::string("\x06\xff\xff\xff\xff\x10", 6));
+    print_decoded("long unknown name", header + std::string("\x0f\x09" "ab", 4));
+
+    //Random logs, decoded whole and cut at every byte - a cut log gives the commands before the cut, then END if
+    //the cut falls between records, or else CORRUPT
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        std::mt19937 rng(seed);
+        std::vector<Command> commands;
+        std::vector<size_t> boundaries(1, 4);
+        for (int i = 0; i < 300; i++) {
+            commands.push_back(random_command(rng));
+            boundaries.push_back(encode(commands, LogRecord::END, "").size());
+        }
+        LogRecord ending = static_cast<LogRecord>(rng() % 3);
+        std::string name;
+        for (unsigned int i = rng() % 6; i > 0; i--) {
+            name.push_back(static_cast<char>(rng()));
+        }
+        std::string whole = encode(commands, ending, name);
+        std::vector<Command> found;
+        std::string foundName;
+        TEST_CHECK(decode(whole, found, foundName) == (ending == LogRecord::COMMAND ? LogRecord::END : ending));
+        TEST_CHECK(found.size() == commands.size());
+        for (size_t i = 0; i < commands.size(); i++) {
+            TEST_CHECK(same_command(found[i], commands[i]));
+        }
+        TEST_CHECK(ending != LogRecord::UNKNOWN || foundName == name);
+        std::string plain = encode(commands, LogRecord::END, "");
+        for (size_t cut = 4; cut < plain.size(); cut++) {
+            std::vector<Command> prefix;
+            record = decode(plain.substr(0, cut), prefix, foundName);
+            size_t complete = std::upper_bound(boundaries.begin(), boundaries.end(), cut) - boundaries.begin() - 1;
+            TEST_CHECK(prefix.size() == complete);
+            TEST_CHECK(record == ((boundaries[complete] == cut) ? LogRecord::END : LogRecord::CORRUPT));
+        }
+    }
+    printf("random logs: ok\n");
+    return 0;
+}
@@ -0,0 +1,114 @@
+//compact_players.cpp - Tree::compact and compact_players, with inserts and removes before and after compaction
+
+#include "TestUtils.h"
+#include "../AVLMultiVariable.h"
+#include "../GenericNode.h"
+#include "../Player.h"
+
+typedef MultiTree<Player*> PlayerTree;
+typedef Tree<GenericNode<Player*>, Player*> IdTree;
+
+//Compare both trees with the model - their invariants, their sizes and the order of their ID's
+static bool check_trees(const PlayerTree& byScore, const IdTree& byId, const std::map<int, Player*>& players)
+{
+    if (!byScore.is_consistent() || !byId.is_consistent() || byScore.get_size() != static_cast<int>(players.size()) ||
+        byId.get_size() != static_cast<int>(players.size())) {
+        return false;
+    }
+    std::vector<Model::ModelPlayer> sorted;
+    for (std::map<int, Player*>::const_iterator it = players.begin(); it != players.end(); ++it) {
+        sorted.push_back(Model::ModelPlayer{it->first, 0, 0, it->second->get_goals(), it->second->get_cards(), false});
+    }
+    //The order of the ID tree is checked by is_consistent
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (byId.find_data(sorted[i].m_id) == nullptr) {
+            return false;
+        }
+    }
+    std::vector<int> ids(players.size() + 1);
+    std::sort(sorted.begin(), sorted.end(), Model::is_before);
+    byScore.get_all_data(ids.data());
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (ids[i] != sorted[i].m_id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    //Random inserts, removes and repositions on both kinds of trees, compacted every 100 changes. Every node of
+    //the block is removed over time, so the block is freed while the trees are in use.
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        PlayerTree byScore;
+        IdTree byId;
+        std::map<int, Player*> players;
+        std::vector<Player*> owned;
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 4000; i++) {
+            int id = 1 + static_cast<int>(rng() % 200);
+            int goals = static_cast<int>(rng() % 3);
+            int cards = static_cast<int>(rng() % 2);
+            std::map<int, Player*>::iterator it = players.find(id);
+            if (it == players.end()) {
+                owned.push_back(new Player(id, 1, goals, cards, false, nullptr));
+                byScore.insert(owned.back(), id, goals, cards);
+                byId.insert(owned.back(), id);
+                players[id] = owned.back();
+            }
+            else if (rng() % 2 == 0) {
+                byScore.remove(id, it->second->get_goals(), it->second->get_cards());
+                byId.remove(id);
+                players.erase(it);
+            }
+            else {
+                Player* player = it->second;
+                byScore.reposition(id, player->get_goals(), player->get_cards(), player->get_goals() + goals,
+                                   player->get_cards() + cards);
+                player->update_goals(goals);
+                player->update_cards(cards);
+            }
+            if (i % 100 == 99) {
+                byScore.compact();
+                byId.compact();
+            }
+            TEST_CHECK(check_trees(byScore, byId, players));
+        }
+        for (Player* player : owned) {
+            delete player;
+        }
+    }
+    printf("random compacted trees: ok\n");
+
+    world_cup_t system;
+    print_status("compact_players() of no players", system.compact_players());
+    system.add_team(1, 0);
+    system.add_player(10, 1, 1, 2, 0, false);
+    system.add_player(11, 1, 1, 1, 0, false);
+    system.add_player(12, 1, 1, 3, 0, false);
+    print_status("compact_players()", system.compact_players());
+    print_status("add_player(13, 1, 1, 0, 0)", system.add_player(13, 1, 1, 0, 0, false));
+    print_status("update_player_stats(13, 1, 5, 0)", system.update_player_stats(13, 1, 5, 0));
+    print_status("remove_player(10)", system.remove_player(10));
+    int output[4];
+    print_status("get_all_players(-1)", system.get_all_players(-1, output));
+    printf("players: %d %d %d\n", output[0], output[1], output[2]);
+    print_output("get_top_scorer(1)", system.get_top_scorer(1));
+
+    //Random streams of commands with compact_players between them
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 8, 120);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            if (stream.next(20) == 0) {
+                TEST_CHECK(randomSystem.compact_players() == StatusType::SUCCESS);
+            }
+            TEST_CHECK(check_players(randomSystem, model));
+        }
+    }
+    printf("random compacted players: ok\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+//concurrent_reads.cpp - queries from several threads while one thread writes, with buffered updates and frozen players
+
+#include "TestUtils.h"
+#include <atomic>
+#include <thread>
+
+static const int NUM_READERS = 4;
+static const int NUM_PLAYERS = 600;
+static const int NUM_TEAMS = 6;
+
+//Read while the players are added - every read must see the players of some moment between two adds. Returns the
+//number of failed checks
+static int read_while_adding(world_cup_t* system, const std::atomic<bool>* stop, unsigned int seed)
+{
+    std::vector<int> output(NUM_PLAYERS + 1);
+    std::mt19937 rng(seed);
+    int failures = 0;
+    while (!stop->load()) {
+        int before = system->get_all_players_count(-1).ans();
+        std::fill(output.begin(), output.end(), 0);
+        StatusType status = system->get_all_players(-1, output.data());
+        int after = system->get_all_players_count(-1).ans();
+        int seen = 0;
+        while (output[seen] != 0) {
+            seen++;
+        }
+        bool sorted = true;
+        for (int i = 1; i < seen; i++) {
+            sorted = sorted && is_before(output[i - 1], output[i]);
+        }
+        int teamId = 1 + static_cast<int>(rng() % NUM_TEAMS);
+        int topScorer = system->get_top_scorer(teamId).ans();
+        if ((before > 0 && status != StatusType::SUCCESS) || seen < before || seen > after || !sorted ||
+            (topScorer != 0 && topScorer % NUM_TEAMS != teamId - 1)) {
+            failures++;
+        }
+        std::this_thread::yield();
+    }
+    return failures;
+}
+
+//Read while games are played and stats updated - the games of a player never go back. Returns the number of failed
+//checks
+static int read_while_updating(world_cup_t* system, const std::atomic<bool>* stop, unsigned int seed)
+{
+    std::vector<int> games(NUM_PLAYERS + 1, 0);
+    std::mt19937 rng(seed);
+    int failures = 0;
+    while (!stop->load()) {
+        int playerId = 1 + static_cast<int>(rng() % NUM_PLAYERS);
+        output_t<int> result = system->get_num_played_games(playerId);
+        if (result.status() != StatusType::SUCCESS || result.ans() < games[playerId]) {
+            failures++;
+        }
+        else {
+            games[playerId] = result.ans();
+        }
+        std::this_thread::yield();
+    }
+    return failures;
+}
+
+//Run the readers with one writer, which starts once every reader runs, and return the number of failed checks
+template <class Read, class Write>
+static int run_readers(world_cup_t* system, Read read, Write write)
+{
+    std::atomic<bool> stop(false);
+    std::atomic<int> started(0);
+    std::vector<int> failures(NUM_READERS, 0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; r++) {
+        readers.emplace_back([&, r] {
+            started++;
+            failures[r] = read(system, &stop, r + 1);
+        });
+    }
+    while (started.load() < NUM_READERS) {
+        std::this_thread::yield();
+    }
+    write(system);
+    stop = true;
+    int total = 0;
+    for (int r = 0; r < NUM_READERS; r++) {
+        readers[r].join();
+        total += failures[r];
+    }
+    return total;
+}
+
+int main()
+{
+    world_cup_t* system = new world_cup_t();
+    TEST_CHECK(system->set_update_buffer(16, 0) == StatusType::SUCCESS);
+    TEST_CHECK(system->freeze_players(8) == StatusType::SUCCESS);
+    for (int teamId = 1; teamId <= NUM_TEAMS; teamId++) {
+        TEST_CHECK(system->add_team(teamId, 0) == StatusType::SUCCESS);
+    }
+    //Player i joins team i % NUM_TEAMS + 1, with i % 7 goals, and every goalkeeper is in the first two teams
+    int failures = run_readers(system, read_while_adding, [](world_cup_t* writer) {
+        for (int playerId = 1; playerId <= NUM_PLAYERS; playerId++) {
+            int teamId = playerId % NUM_TEAMS + 1;
+            writer->add_player(playerId, teamId, 1, playerId % 7, 0, teamId <= 2);
+            std::this_thread::yield();
+        }
+    });
+    printf("failed reads while adding: %d\n", failures);
+
+    failures = run_readers(system, read_while_updating, [](world_cup_t* writer) {
+        for (int round = 0; round < 20; round++) {
+            writer->play_match(1, 2);
+            for (int playerId = 1 + round; playerId <= NUM_PLAYERS; playerId += 20) {
+                writer->update_player_stats(playerId, 1, 0, 1);
+                std::this_thread::yield();
+            }
+        }
+    });
+    printf("failed reads while updating: %d\n", failures);
+
+    print_status("flush_updates()", system->flush_updates());
+    print_output("get_all_players_count(-1)", system->get_all_players_count(-1));
+    print_output("get_num_played_games(1)", system->get_num_played_games(1));
+    print_output("get_num_played_games(6)", system->get_num_played_games(6));
+    print_output("get_team_points(1)", system->get_team_points(1));
+    print_output("get_team_points(2)", system->get_team_points(2));
+    print_output("get_top_scorer(-1)", system->get_top_scorer(-1));
+    print_output("get_top_scorer(3)", system->get_top_scorer(3));
+    delete system;
+    return 0;
+}
@@ -0,0 +1,84 @@
+//failed_flush.cpp - held updates when their flush runs out of memory: queries still answer, and no team is lost
+
+#include "TestUtils.h"
+#include <cstdlib>
+#include <new>
+
+//The number of allocations left before the one that fails, or -1 to never fail
+static int g_allocationsLeft = -1;
+
+void* operator new(std::size_t size)
+{
+    if (g_allocationsLeft >= 0 && g_allocationsLeft-- == 0) {
+        throw std::bad_alloc();
+    }
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+//The replaced operator new allocates with malloc, so the memory is released with free
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    world_cup_t system;
+    system.set_update_buffer(100, 0);
+    system.add_team(1, 0);
+    system.add_team(2, 0);
+    system.add_player(10, 1, 1, 1, 0, false);
+    system.add_player(20, 2, 1, 2, 0, false);
+    print_status("update_player_stats(10, 1, 5, 0)", system.update_player_stats(10, 1, 5, 0));
+    //The first allocation of the flush fails - the query reads without the held update instead of retrying, and
+    //the next query applies it
+    g_allocationsLeft = 0;
+    output_t<int> topScorer = system.get_top_scorer(-1);
+    g_allocationsLeft = -1;
+    print_output("get_top_scorer(-1) with a failed flush", topScorer);
+    print_output("get_num_played_games(10)", system.get_num_played_games(10));
+    g_allocationsLeft = 0;
+    StatusType status = system.flush_updates();
+    g_allocationsLeft = -1;
+    print_status("flush_updates() of no updates", status);
+    print_status("update_player_stats(20, 1, 1, 0)", system.update_player_stats(20, 1, 1, 0));
+    g_allocationsLeft = 1;
+    status = system.flush_updates();
+    g_allocationsLeft = -1;
+    print_status("flush_updates() with a failed allocation", status);
+    print_output("get_num_played_games(20)", system.get_num_played_games(20));
+
+    //Random streams with a flush that fails at one of the allocations made before the teams are unlinked, or at
+    //recording an updated team - the held updates are applied later and every team is still in the indexes
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 6, 150);
+        TEST_CHECK(randomSystem.set_update_buffer(1000, 0) == StatusType::SUCCESS);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            if (i % 30 != 29) {
+                continue;
+            }
+            g_allocationsLeft = stream.next(7);
+            StatusType status = (stream.next(2) == 0) ? randomSystem.flush_updates()
+                                                      : randomSystem.get_top_scorer(-1).status();
+            g_allocationsLeft = -1;
+            TEST_CHECK(status != StatusType::INVALID_INPUT);
+            TEST_CHECK(check_players(randomSystem, model) && check_teams(randomSystem, model));
+        }
+    }
+    printf("random failed flushes: ok\n");
+    return 0;
+}
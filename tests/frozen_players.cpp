@@ -0,0 +1,98 @@
+//frozen_players.cpp - EytzingerIndex, and the reads of world_cup_t while the players are frozen
+
+#include "TestUtils.h"
+#include "../EytzingerIndex.h"
+#include <set>
+
+//Compare the reads served by the snapshot with the model
+static bool check_frozen(world_cup_t& system, const Model& model)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(-1);
+    if (players.empty()) {
+        return system.get_all_players_count(-1).ans() == 0;
+    }
+    if (!check_players(system, model)) {
+        return false;
+    }
+    std::vector<int> output(players.size());
+    //The closest players of the first and the last player
+    const int playerIds[] = {players.front().m_id, players.back().m_id};
+    for (int playerId : playerIds) {
+        const Model::ModelPlayer& player = model.m_players.at(playerId);
+        std::vector<int> expected = model.get_closest_players(-1, player.m_goals, player.m_cards, playerId);
+        output_t<int> closest = system.get_closest_players(playerId, -1, 5, output.data());
+        int size = std::min(5, static_cast<int>(expected.size()));
+        if ((size == 0 && closest.status() != StatusType::FAILURE) || (size > 0 && (closest.ans() != size ||
+            !std::equal(expected.begin(), expected.begin() + size, output.begin())))) {
+            return false;
+        }
+    }
+    //A player that is not in the game, whether it never was or was removed
+    for (int playerId = 1; playerId <= 5; playerId++) {
+        if (model.m_players.count(playerId) == 0 &&
+            system.get_num_played_games(playerId).status() != StatusType::FAILURE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    //Every ID of sets of every size up to 300 is found with its data, and no other ID is
+    std::mt19937 rng(1);
+    for (int size = 0; size < 300; size++) {
+        std::set<int> idSet;
+        while (static_cast<int>(idSet.size()) < size) {
+            idSet.insert(1 + rng() % 1000);
+        }
+        std::vector<int> ids(idSet.begin(), idSet.end());
+        std::vector<int> data(ids.size());
+        for (size_t i = 0; i < ids.size(); i++) {
+            data[i] = ids[i] * 7;
+        }
+        EytzingerIndex<int> index;
+        index.build(ids.data(), data.data(), size);
+        for (int id = -2; id < 1003; id++) {
+            int* found = index.find(id);
+            TEST_CHECK((found != nullptr) == (idSet.count(id) != 0));
+            TEST_CHECK(found == nullptr || *found == id * 7);
+        }
+    }
+    printf("eytzinger index: ok\n");
+
+    world_cup_t system;
+    system.add_team(1, 0);
+    system.add_player(10, 1, 3, 2, 0, false);
+    system.add_player(11, 1, 1, 1, 0, false);
+    print_status("freeze_players(-1)", system.freeze_players(-1));
+    print_status("freeze_players(2)", system.freeze_players(2));
+    print_output("get_num_played_games(10)", system.get_num_played_games(10));
+    //Changes since the snapshot was taken are seen by the next read, before and after it is taken again
+    print_status("update_player_stats(11, 2, 5, 0)", system.update_player_stats(11, 2, 5, 0));
+    print_output("get_num_played_games(11)", system.get_num_played_games(11));
+    print_status("remove_player(10)", system.remove_player(10));
+    print_output("get_num_played_games(10)", system.get_num_played_games(10));
+    print_status("add_player(12, 1, 4, 0, 0, true)", system.add_player(12, 1, 4, 0, 0, true));
+    print_status("add_player(13, 1, 4, 9, 0, true)", system.add_player(13, 1, 4, 9, 0, true));
+    int output[4];
+    print_status("get_all_players(-1)", system.get_all_players(-1, output));
+    printf("players: %d %d %d\n", output[0], output[1], output[2]);
+    print_status("freeze_players(0)", system.freeze_players(0));
+    print_output("get_num_played_games(13)", system.get_num_played_games(13));
+
+    //Random streams of commands with snapshots of several limits, checking the frozen reads after each command
+    const int limits[] = {1, 2, 8, 64, 1000};
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 8, 120);
+        TEST_CHECK(randomSystem.freeze_players(limits[seed - 1]) == StatusType::SUCCESS);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            TEST_CHECK(check_frozen(randomSystem, model));
+        }
+    }
+    printf("random frozen reads: ok\n");
+    return 0;
+}
@@ -0,0 +1,139 @@
+//parallel_export.cpp - get_all_players with several worker threads, against the serial export and the model
+
+#include "TestUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+static const int NUM_TEAMS = 4;
+static const int THREAD_COUNTS[] = {1, 2, 3, 4, 8};
+
+//A system of the given number of players, spread over the teams with repeating scores
+static void add_players(world_cup_t& system, int numPlayers)
+{
+    for (int teamId = 1; teamId <= NUM_TEAMS; teamId++) {
+        system.add_team(teamId, 0);
+    }
+    for (int playerId = 1; playerId <= numPlayers; playerId++) {
+        system.add_player(playerId, 1 + playerId % NUM_TEAMS, 1, (playerId * 7919) % 50, (playerId * 31) % 5, false);
+    }
+}
+
+//The export of a team, or of the whole league for teamId -1
+static std::vector<int> export_players(world_cup_t& system, int teamId)
+{
+    std::vector<int> output(system.get_all_players_count(teamId).ans());
+    if (!output.empty()) {
+        system.get_all_players(teamId, output.data());
+    }
+    return output;
+}
+
+//Export from several threads at once while a writer changes the stats of team 3 - the exports of team 2 must equal
+//the serial one, and every league export must hold each player once. Returns the number of failed checks
+static int export_concurrently(world_cup_t& system, const std::vector<int>& teamSerial, int numPlayers)
+{
+    std::atomic<int> started(0);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&, r] {
+            started++;
+            for (int i = 0; i < 5; i++) {
+                std::vector<int> output(numPlayers, 0);
+                if (r == 2) {
+                    system.get_all_players(2, output.data());
+                    output.resize(teamSerial.size());
+                    failures += (output != teamSerial);
+                }
+                else {
+                    system.get_all_players(-1, output.data());
+                    std::sort(output.begin(), output.end());
+                    for (int j = 0; j < numPlayers; j++) {
+                        failures += (output[j] != j + 1);
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    while (started.load() < 3) {
+        std::this_thread::yield();
+    }
+    for (int playerId = 3; playerId <= numPlayers; playerId += 4 * 37) {
+        system.update_player_stats(playerId, 1, 1, 0);
+        std::this_thread::yield();
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    return failures.load();
+}
+
+int main()
+{
+    world_cup_t system;
+    print_status("set_worker_threads(0)", system.set_worker_threads(0));
+    add_players(system, 12);
+    for (int numThreads : {1, 4}) {
+        print_status("set_worker_threads", system.set_worker_threads(numThreads));
+        std::vector<int> output = export_players(system, -1);
+        printf("%d threads:", numThreads);
+        for (int playerId : output) {
+            printf(" %d", playerId);
+        }
+        printf("\n");
+    }
+
+    //Sizes around the grain below which subtrees are walked serially, exported with every thread count
+    const int sizes[] = {0, 1, 100, 2047, 2048, 2049, 5000, 30000};
+    for (int numPlayers : sizes) {
+        world_cup_t sized;
+        add_players(sized, numPlayers);
+        std::vector<int> serial = export_players(sized, -1);
+        std::vector<int> teamSerial = export_players(sized, 2);
+        int failures = 0;
+        for (int numThreads : THREAD_COUNTS) {
+            sized.set_worker_threads(numThreads);
+            failures += (export_players(sized, -1) != serial) + (export_players(sized, 2) != teamSerial);
+        }
+        printf("%d players: %d exports differ from serial\n", numPlayers, failures);
+    }
+
+    //Exports from several threads at once, with a writer on another team
+    for (int numThreads : {1, 4}) {
+        world_cup_t shared;
+        add_players(shared, 20000);
+        shared.set_worker_threads(numThreads);
+        std::vector<int> teamSerial = export_players(shared, 2);
+        printf("concurrent exports with %d threads: %d failed checks\n", numThreads,
+               export_concurrently(shared, teamSerial, 20000));
+    }
+
+    //Random streams against the model, exporting every team with a random number of threads after each command
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 6, 3000);
+        for (int i = 0; i < 4000; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            if (i % 100 != 99) {
+                continue;
+            }
+            TEST_CHECK(randomSystem.set_worker_threads(THREAD_COUNTS[stream.next(5)]) == StatusType::SUCCESS);
+            for (int teamId = -1; teamId <= 6; teamId++) {
+                if (teamId == 0 || (teamId > 0 && model.m_teams.count(teamId) == 0)) {
+                    continue;
+                }
+                std::vector<Model::ModelPlayer> players = model.get_team_players(teamId);
+                std::vector<int> output = export_players(randomSystem, teamId);
+                TEST_CHECK(output.size() == players.size());
+                for (size_t j = 0; j < players.size(); j++) {
+                    TEST_CHECK(output[j] == players[j].m_id);
+                }
+            }
+        }
+    }
+    printf("random exports: ok\n");
+    return 0;
+}
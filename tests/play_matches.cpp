@@ -0,0 +1,99 @@
+//play_matches.cpp - play_matches gives the same results as playing the matches one after the other
+
+#include "TestUtils.h"
+
+static const int NUM_TEAMS = 12;
+
+//Add a squad of 11 players with random stats to every team - every fourth team has no goalkeeper
+static bool add_squads(world_cup_t& system, Model& model, std::mt19937& rng)
+{
+    for (int teamId = 1; teamId <= NUM_TEAMS; teamId++) {
+        int points = rng() % 6;
+        if (system.add_team(teamId, points) != model.add_team(teamId, points)) {
+            return false;
+        }
+        for (int i = 0; i < 11; i++) {
+            int playerId = teamId * 100 + i;
+            int goals = rng() % 4;
+            int cards = rng() % 3;
+            bool goalKeeper = (i == 0 && teamId % 4 != 0);
+            if (system.add_player(playerId, teamId, 1, goals, cards, goalKeeper) !=
+                model.add_player(playerId, teamId, 1, goals, cards, goalKeeper)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    world_cup_t system;
+    Model model;
+    std::mt19937 rng(1);
+    TEST_CHECK(add_squads(system, model, rng));
+    //Team 1 plays three times in a row, so every match depends on the one before it
+    const int teamIds1[] = {1, 1, 2, 1, 4, 0, 5};
+    const int teamIds2[] = {2, 3, 3, 2, 5, 6, 5};
+    StatusType results[7];
+    print_status("play_matches(nullptr)", system.play_matches(nullptr, teamIds2, 7, results));
+    print_status("play_matches of no matches", system.play_matches(teamIds1, teamIds2, 0, results));
+    print_status("play_matches", system.play_matches(teamIds1, teamIds2, 7, results));
+    for (int i = 0; i < 7; i++) {
+        printf("match %d against %d: %s\n", teamIds1[i], teamIds2[i], STATUS_NAMES[static_cast<int>(results[i])]);
+        if (results[i] == StatusType::SUCCESS) {
+            TEST_CHECK(model.play_match(teamIds1[i], teamIds2[i]) == StatusType::SUCCESS);
+        }
+    }
+    for (int teamId = 1; teamId <= 5; teamId++) {
+        printf("points of team %d: %d (model %d)\n", teamId, system.get_team_points(teamId).ans(),
+               model.m_teams[teamId].m_points);
+    }
+
+    //Random lists of matches, played together on one system and one at a time on another
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t batchSystem;
+        world_cup_t singleSystem;
+        Model batchModel;
+        Model singleModel;
+        std::mt19937 batchRng(seed);
+        std::mt19937 singleRng(seed);
+        TEST_CHECK(add_squads(batchSystem, batchModel, batchRng) && add_squads(singleSystem, singleModel, singleRng));
+        std::mt19937 matchRng(seed);
+        for (int round = 0; round < 200; round++) {
+            int size = 1 + matchRng() % 20;
+            std::vector<int> ids1(size);
+            std::vector<int> ids2(size);
+            for (int i = 0; i < size; i++) {
+                ids1[i] = 1 + matchRng() % NUM_TEAMS;
+                ids2[i] = 1 + matchRng() % NUM_TEAMS;
+                if (matchRng() % 30 == 0) {
+                    ids1[i] = -ids1[i];
+                }
+            }
+            std::vector<StatusType> batchResults(size);
+            TEST_CHECK(batchSystem.play_matches(ids1.data(), ids2.data(), size, batchResults.data()) ==
+                       StatusType::SUCCESS);
+            for (int i = 0; i < size; i++) {
+                TEST_CHECK(singleSystem.play_match(ids1[i], ids2[i]) == batchResults[i]);
+                if (batchResults[i] == StatusType::SUCCESS) {
+                    TEST_CHECK(batchModel.play_match(ids1[i], ids2[i]) == StatusType::SUCCESS);
+                }
+            }
+            //A player update between the rounds changes the strength of a team
+            int playerId = (1 + matchRng() % NUM_TEAMS) * 100 + matchRng() % 11;
+            int goals = matchRng() % 3;
+            TEST_CHECK(batchSystem.update_player_stats(playerId, 1, goals, 0) ==
+                       batchModel.update_player_stats(playerId, 1, goals, 0));
+            TEST_CHECK(singleSystem.update_player_stats(playerId, 1, goals, 0) == StatusType::SUCCESS);
+            for (int teamId = 1; teamId <= NUM_TEAMS; teamId++) {
+                TEST_CHECK(batchSystem.get_team_points(teamId).ans() == batchModel.m_teams[teamId].m_points);
+                TEST_CHECK(singleSystem.get_team_points(teamId).ans() == batchModel.m_teams[teamId].m_points);
+                TEST_CHECK(batchSystem.get_team_points_rank(teamId).ans() ==
+                           singleSystem.get_team_points_rank(teamId).ans());
+            }
+        }
+    }
+    printf("random matches: ok\n");
+    return 0;
+}
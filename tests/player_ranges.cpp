@@ -0,0 +1,80 @@
+//player_ranges.cpp - the goals band and cards threshold queries of a team and of the entire game
+
+#include "TestUtils.h"
+
+//Compare both queries of a goals band and of a cards threshold with the model, for a team or the entire game
+static bool check_ranges(world_cup_t& system, const Model& model, int teamId, int minGoals, int maxGoals, int cards)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(teamId);
+    std::vector<int> byGoals;
+    std::vector<int> byCards;
+    for (size_t i = 0; i < players.size(); i++) {
+        if (players[i].m_goals >= minGoals && players[i].m_goals <= maxGoals) {
+            byGoals.push_back(players[i].m_id);
+        }
+        if (players[i].m_cards > cards) {
+            byCards.push_back(players[i].m_id);
+        }
+    }
+    std::vector<int> output(players.size() + 1);
+    output_t<int> countGoals = system.count_players_by_goals(teamId, minGoals, maxGoals);
+    output_t<int> getGoals = system.get_players_by_goals(teamId, minGoals, maxGoals, output.data());
+    if (countGoals.status() != StatusType::SUCCESS || countGoals.ans() != static_cast<int>(byGoals.size()) ||
+        getGoals.status() != StatusType::SUCCESS || !std::equal(byGoals.begin(), byGoals.end(), output.begin()) ||
+        getGoals.ans() != countGoals.ans()) {
+        return false;
+    }
+    output_t<int> countCards = system.count_players_by_cards(teamId, cards);
+    output_t<int> getCards = system.get_players_by_cards(teamId, cards, output.data());
+    return countCards.status() == StatusType::SUCCESS && countCards.ans() == static_cast<int>(byCards.size()) &&
+           getCards.status() == StatusType::SUCCESS && getCards.ans() == countCards.ans() &&
+           std::equal(byCards.begin(), byCards.end(), output.begin());
+}
+
+int main()
+{
+    int output[8];
+    world_cup_t system;
+    print_output("count_players_by_goals(-1, 0, 5) of no players", system.count_players_by_goals(-1, 0, 5));
+    system.add_team(1, 0);
+    system.add_team(2, 0);
+    system.add_player(10, 1, 1, 2, 0, false);
+    system.add_player(11, 1, 1, 2, 3, false);
+    system.add_player(12, 1, 1, 5, 1, false);
+    system.add_player(20, 2, 1, 3, 2, false);
+    system.add_player(21, 2, 1, 0, 4, false);
+    print_output("count_players_by_goals(1, 2, 4)", system.count_players_by_goals(1, 2, 4));
+    print_ids("get_players_by_goals(1, 2, 4)", system.get_players_by_goals(1, 2, 4, output), output);
+    print_ids("get_players_by_goals(-1, 1, 5)", system.get_players_by_goals(-1, 1, 5, output), output);
+    print_ids("get_players_by_goals(-1, 6, 9)", system.get_players_by_goals(-1, 6, 9, output), output);
+    print_output("count_players_by_cards(-1, 1)", system.count_players_by_cards(-1, 1));
+    print_ids("get_players_by_cards(-1, 1)", system.get_players_by_cards(-1, 1, output), output);
+    print_ids("get_players_by_cards(2, 3)", system.get_players_by_cards(2, 3, output), output);
+    print_status("update_player_stats(21, 1, 3, 0)", system.update_player_stats(21, 1, 3, 0));
+    print_ids("get_players_by_goals(2, 3, 3)", system.get_players_by_goals(2, 3, 3, output), output);
+    print_output("count_players_by_goals(3, 0, 5)", system.count_players_by_goals(3, 0, 5));
+    print_output("count_players_by_goals(1, 4, 2)", system.count_players_by_goals(1, 4, 2));
+    print_output("count_players_by_goals(0, 0, 2)", system.count_players_by_goals(0, 0, 2));
+    print_output("count_players_by_cards(1, -1)", system.count_players_by_cards(1, -1));
+    print_ids("get_players_by_cards(1, 0, nullptr)", system.get_players_by_cards(1, 0, nullptr), output);
+
+    //Random streams of commands, checking random bands and thresholds after each command
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 8, 120);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            int teamId = 1 + stream.next(8);
+            int minGoals = stream.next(12);
+            int maxGoals = minGoals + stream.next(8);
+            int cards = stream.next(8);
+            if (model.m_teams.count(teamId) != 0) {
+                TEST_CHECK(check_ranges(randomSystem, model, teamId, minGoals, maxGoals, cards));
+            }
+            TEST_CHECK(check_ranges(randomSystem, model, -1, minGoals, maxGoals, cards));
+        }
+    }
+    printf("random ranges: ok\n");
+    return 0;
+}
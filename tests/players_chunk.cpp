@@ -0,0 +1,118 @@
+//players_chunk.cpp - get_players_chunk walks, whole and with changes between the chunks
+
+#include "TestUtils.h"
+
+//Walk the players of a team in chunks of the given capacity, and compare the walk with the model
+static bool check_walk(world_cup_t& system, const Model& model, int teamId, int capacity)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(teamId);
+    std::vector<int> output(capacity);
+    PlayerCursor cursor;
+    size_t walked = 0;
+    while (true) {
+        output_t<int> chunk = system.get_players_chunk(teamId, cursor, output.data(), capacity);
+        if (chunk.status() != StatusType::SUCCESS || chunk.ans() > capacity ||
+            walked + chunk.ans() > players.size()) {
+            return false;
+        }
+        for (int i = 0; i < chunk.ans(); i++) {
+            if (output[i] != players[walked + i].m_id) {
+                return false;
+            }
+        }
+        walked += chunk.ans();
+        if (chunk.ans() < capacity) {
+            return walked == players.size();
+        }
+    }
+}
+
+int main()
+{
+    world_cup_t system;
+    PlayerCursor cursor;
+    int output[4];
+    print_output("get_players_chunk(-1, 4) of no players", system.get_players_chunk(-1, cursor, output, 4));
+    print_output("get_players_chunk(0, 4)", system.get_players_chunk(0, cursor, output, 4));
+    print_output("get_players_chunk(-1, 0)", system.get_players_chunk(-1, cursor, output, 0));
+    print_output("get_players_chunk(3, 4) of no team", system.get_players_chunk(3, cursor, output, 4));
+    system.add_team(1, 0);
+    system.add_team(2, 0);
+    for (int playerId = 1; playerId <= 9; playerId++) {
+        system.add_player(playerId, 1 + playerId % 2, 1, playerId % 3, 0, false);
+    }
+    //The players by goals: 3 6 9 (0 goals), 1 4 7 (1 goal), 2 5 8 (2 goals)
+    for (int call = 0; call < 4; call++) {
+        output_t<int> chunk = system.get_players_chunk(-1, cursor, output, 4);
+        print_output("get_players_chunk(-1, 4)", chunk);
+        for (int i = 0; i < chunk.ans(); i++) {
+            printf("%d ", output[i]);
+        }
+        printf("\n");
+    }
+    PlayerCursor teamCursor;
+    print_output("get_players_chunk(2, 4)", system.get_players_chunk(2, teamCursor, output, 4));
+    printf("%d %d %d %d\n", output[0], output[1], output[2], output[3]);
+    //Player 5 is removed before it is reached, and player 11 is added after the cursor
+    print_status("remove_player(5)", system.remove_player(5));
+    print_status("add_player(11, 2, 1, 3, 0)", system.add_player(11, 2, 1, 3, 0, false));
+    output_t<int> rest = system.get_players_chunk(2, teamCursor, output, 4);
+    print_output("get_players_chunk(2, 4)", rest);
+    for (int i = 0; i < rest.ans(); i++) {
+        printf("%d ", output[i]);
+    }
+    printf("\n");
+
+    //Random streams, walking every team with several capacities after each command
+    const int capacities[] = {1, 2, 7, 64, 1000};
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 6, 120);
+        for (int i = 0; i < 800; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            int teamId = stream.next(7);
+            TEST_CHECK(check_walk(randomSystem, model, teamId == 0 ? -1 : teamId, capacities[stream.next(5)]) ||
+                       (teamId != 0 && model.m_teams.count(teamId) == 0));
+        }
+    }
+    printf("random walks: ok\n");
+
+    //Walks of all the players with players updated and removed between the chunks - every player that is left
+    //alone is passed exactly once
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t walkedSystem;
+        std::mt19937 rng(seed);
+        for (int teamId = 1; teamId <= 4; teamId++) {
+            walkedSystem.add_team(teamId, 0);
+        }
+        for (int i = 0; i < 2000; i++) {
+            walkedSystem.add_player(1 + rng() % 3000, 1 + rng() % 4, 1, rng() % 6, rng() % 4, false);
+        }
+        std::vector<int> all(walkedSystem.get_all_players_count(-1).ans());
+        TEST_CHECK(walkedSystem.get_all_players(-1, all.data()) == StatusType::SUCCESS);
+        std::map<int, int> seen;
+        std::map<int, bool> touched;
+        PlayerCursor walk;
+        std::vector<int> chunk(16);
+        while (true) {
+            output_t<int> found = walkedSystem.get_players_chunk(-1, walk, chunk.data(), 16);
+            TEST_CHECK(found.status() == StatusType::SUCCESS);
+            for (int i = 0; i < found.ans(); i++) {
+                seen[chunk[i]]++;
+            }
+            if (found.ans() < 16) {
+                break;
+            }
+            int playerId = all[rng() % all.size()];
+            StatusType status = (rng() % 2 == 0) ? walkedSystem.update_player_stats(playerId, 1, rng() % 3, 0)
+                                                 : walkedSystem.remove_player(playerId);
+            touched[playerId] = touched[playerId] || status == StatusType::SUCCESS;
+        }
+        for (int playerId : all) {
+            TEST_CHECK(touched[playerId] || seen[playerId] == 1);
+        }
+    }
+    printf("walks with changes: ok\n");
+    return 0;
+}
@@ -0,0 +1,92 @@
+//relaxed_balance.cpp - trees with deferred rotations, rebalance_all, and set_relaxed_balance
+
+#include "TestUtils.h"
+#include "../AVLMultiVariable.h"
+#include "../GenericNode.h"
+#include "../Player.h"
+
+typedef MultiTree<Player*> PlayerTree;
+typedef Tree<GenericNode<Player*>, Player*> IdTree;
+
+//Compare both trees with the model - their invariants, their balance within the slack, and their sizes
+static bool check_trees(const PlayerTree& byScore, const IdTree& byId, const std::map<int, Player*>& players)
+{
+    int size = static_cast<int>(players.size());
+    return byScore.is_consistent() && byId.is_consistent() && byScore.is_balanced() && byId.is_balanced() &&
+           byScore.get_size() == size && byId.get_size() == size;
+}
+
+int main()
+{
+    //Bursts of inserts, in ascending or random order, and of removes under several slacks. After each burst the
+    //tree is made strict again, which must restore AVL balance.
+    const int slacks[] = {1, 2, 3, 5, 8};
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        PlayerTree byScore;
+        IdTree byId;
+        std::map<int, Player*> players;
+        std::vector<Player*> owned;
+        std::mt19937 rng(seed);
+        int nextId = 1;
+        for (int burst = 0; burst < 20; burst++) {
+            int slack = slacks[rng() % 5];
+            byScore.set_relaxed(slack);
+            byId.set_relaxed(slack);
+            bool ascending = (rng() % 2 == 0);
+            for (int i = 0; i < 150; i++) {
+                int id = ascending ? nextId++ : 1 + static_cast<int>(rng() % 3000);
+                std::map<int, Player*>::iterator it = players.find(id);
+                if (it == players.end() && rng() % 3 != 0) {
+                    owned.push_back(new Player(id, 1, rng() % 5, rng() % 3, false, nullptr));
+                    byScore.insert(owned.back(), id, owned.back()->get_goals(), owned.back()->get_cards());
+                    byId.insert(owned.back(), id);
+                    players[id] = owned.back();
+                }
+                else if (it != players.end()) {
+                    byScore.remove(id, it->second->get_goals(), it->second->get_cards());
+                    byId.remove(id);
+                    players.erase(it);
+                }
+                TEST_CHECK(check_trees(byScore, byId, players));
+            }
+            byScore.set_relaxed(1);
+            byId.set_relaxed(1);
+            byScore.rebalance_all();
+            byId.rebalance_all();
+            TEST_CHECK(check_trees(byScore, byId, players));
+        }
+        for (Player* player : owned) {
+            delete player;
+        }
+    }
+    printf("random relaxed trees: ok\n");
+
+    world_cup_t system;
+    print_status("set_relaxed_balance(0)", system.set_relaxed_balance(0));
+    print_status("set_relaxed_balance(4)", system.set_relaxed_balance(4));
+    system.add_team(1, 0);
+    for (int playerId = 1; playerId <= 40; playerId++) {
+        TEST_CHECK(system.add_player(playerId, 1, 1, playerId % 5, 0, false) == StatusType::SUCCESS);
+    }
+    print_output("get_top_scorer(1)", system.get_top_scorer(1));
+    print_status("set_relaxed_balance(1)", system.set_relaxed_balance(1));
+    print_output("get_top_scorer(1)", system.get_top_scorer(1));
+    print_output("get_num_played_games(40)", system.get_num_played_games(40));
+    print_output("get_all_players_count(1)", system.get_all_players_count(1));
+
+    //Random streams of commands, with the slack changed from time to time
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 8, 120);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            if (stream.next(100) == 0) {
+                TEST_CHECK(randomSystem.set_relaxed_balance(1 + stream.next(6)) == StatusType::SUCCESS);
+            }
+            TEST_CHECK(check_players(randomSystem, model));
+        }
+    }
+    printf("random relaxed players: ok\n");
+    return 0;
+}
@@ -0,0 +1,136 @@
+//reposition.cpp - MultiTree::reposition, checking the links, sizes and order of the tree after every change
+
+#include "TestUtils.h"
+#include "../AVLMultiVariable.h"
+#include "../GenericNode.h"
+#include "../Player.h"
+
+typedef MultiTree<Player*> PlayerTree;
+
+//The players of the model, in the order of the tree
+static std::vector<Model::ModelPlayer> sorted_players(const std::map<int, Model::ModelPlayer>& players)
+{
+    std::vector<Model::ModelPlayer> sorted;
+    for (std::map<int, Model::ModelPlayer>::const_iterator it = players.begin(); it != players.end(); ++it) {
+        sorted.push_back(it->second);
+    }
+    std::sort(sorted.begin(), sorted.end(), Model::is_before);
+    return sorted;
+}
+
+//The place of a player in the order of the tree
+static int find_place(const std::vector<Model::ModelPlayer>& sorted, int playerId)
+{
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (sorted[i].m_id == playerId) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+//Compare the tree with the model - its invariants, its size and the order of its ID's
+static bool check_tree(const PlayerTree& tree, const std::map<int, Model::ModelPlayer>& players)
+{
+    if (!tree.is_consistent() || tree.get_size() != static_cast<int>(players.size())) {
+        return false;
+    }
+    std::vector<Model::ModelPlayer> sorted = sorted_players(players);
+    std::vector<int> ids(sorted.size() + 1);
+    tree.get_all_data(ids.data());
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (ids[i] != sorted[i].m_id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    //A fixed tree of five players: 1(0, 0) 2(1, 2) 3(1, 0) 4(2, 1) 5(3, 0)
+    PlayerTree tree;
+    std::map<int, Model::ModelPlayer> players;
+    std::vector<Player*> owned;
+    const int fixed[][3] = {{1, 0, 0}, {2, 1, 2}, {3, 1, 0}, {4, 2, 1}, {5, 3, 0}};
+    for (const int* player : fixed) {
+        owned.push_back(new Player(player[0], 1, player[1], player[2], false, nullptr));
+        tree.insert(owned.back(), player[0], player[1], player[2]);
+        players[player[0]] = Model::ModelPlayer{player[0], 0, 1, player[1], player[2], false};
+    }
+    TEST_CHECK(check_tree(tree, players));
+    int ids[5];
+    const int moves[][5] = {{3, 1, 0, 1, 1}, {3, 1, 1, 2, 2}, {1, 0, 0, 5, 0}, {1, 5, 0, 0, 3}, {4, 2, 1, 2, 1}};
+    for (const int* move : moves) {
+        bool moved = tree.reposition(move[0], move[1], move[2], move[3], move[4]);
+        players[move[0]].m_goals = move[3];
+        players[move[0]].m_cards = move[4];
+        tree.get_all_data(ids);
+        printf("reposition(%d, %d, %d -> %d, %d): %s, order: %d %d %d %d %d\n", move[0], move[1], move[2], move[3],
+               move[4], moved ? "moved" : "in place", ids[0], ids[1], ids[2], ids[3], ids[4]);
+        TEST_CHECK(check_tree(tree, players));
+    }
+
+    //Random inserts, removes and repositions on trees of up to 300 players
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        PlayerTree randomTree;
+        std::map<int, Model::ModelPlayer> randomPlayers;
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 6000; i++) {
+            int kind = static_cast<int>(rng() % 10);
+            int id = 1 + static_cast<int>(rng() % 300);
+            int goals = static_cast<int>(rng() % 12);
+            int cards = static_cast<int>(rng() % 5);
+            std::map<int, Model::ModelPlayer>::iterator it = randomPlayers.find(id);
+            if (it == randomPlayers.end()) {
+                if (kind < 6) {
+                    owned.push_back(new Player(id, 1, goals, cards, false, nullptr));
+                    randomTree.insert(owned.back(), id, goals, cards);
+                    randomPlayers[id] = Model::ModelPlayer{id, 0, 1, goals, cards, false};
+                }
+            }
+            else if (kind < 2) {
+                randomTree.remove(id, it->second.m_goals, it->second.m_cards);
+                randomPlayers.erase(it);
+            }
+            else {
+                //Small changes mostly keep the node in place, large ones move it across the tree
+                if (kind < 6) {
+                    goals = std::max(0, it->second.m_goals + static_cast<int>(rng() % 3) - 1);
+                    cards = std::max(0, it->second.m_cards + static_cast<int>(rng() % 3) - 1);
+                }
+                int oldPlace = find_place(sorted_players(randomPlayers), id);
+                bool moved = randomTree.reposition(id, it->second.m_goals, it->second.m_cards, goals, cards);
+                it->second.m_goals = goals;
+                it->second.m_cards = cards;
+                TEST_CHECK(moved == (find_place(sorted_players(randomPlayers), id) != oldPlace));
+            }
+            TEST_CHECK(check_tree(randomTree, randomPlayers));
+        }
+    }
+    printf("random repositions: ok\n");
+
+    //The plain tree keeps the same invariants through random inserts and removes
+    Tree<GenericNode<Player*>, Player*> idTree;
+    std::map<int, Player*> idPlayers;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 20000; i++) {
+        int id = 1 + static_cast<int>(rng() % 500);
+        if (idPlayers.count(id) == 0) {
+            owned.push_back(new Player(id, 1, 0, 0, false, nullptr));
+            idTree.insert(owned.back(), id);
+            idPlayers[id] = owned.back();
+        }
+        else {
+            idTree.remove(id);
+            idPlayers.erase(id);
+        }
+        TEST_CHECK(idTree.is_consistent() && idTree.get_size() == static_cast<int>(idPlayers.size()));
+    }
+    printf("random id tree: ok\n");
+
+    for (Player* player : owned) {
+        delete player;
+    }
+    return 0;
+}
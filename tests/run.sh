@@ -0,0 +1,59 @@
+#!/bin/sh
+#Builds the main binary and every test in tests/ with the same compile line, runs the main binary on test.in and on
+#every input in tests/driver (comparing its output and exit code with tests/driver/<name>.out), and compares the
+#output of every test with tests/<name>.out. The binaries are written to tests/bin.
+#Every driver input is run in each way the driver reads its input: mapped from the file, read whole from a pipe,
+#parsed with cin (--iostream), and converted into a binary log (--convert) that is then replayed (--binary).
+cd "$(dirname "$0")/.." || exit 1
+CXX=${CXX:-g++}
+FLAGS="-std=c++11 -O2 -fno-delete-null-pointer-checks -Wall -Wno-nonnull-compare -pthread"
+SOURCES=$(ls *.cpp | grep -v -e '^main23a1.cpp$' -e '^avltestlior.cpp$')
+mkdir -p tests/bin
+OBJECTS=""
+for source in $SOURCES; do
+    object="tests/bin/${source%.cpp}.o"
+    $CXX $FLAGS -c -o "$object" "$source" || exit 1
+    OBJECTS="$OBJECTS $object"
+done
+failed=0
+run_driver() {
+    case "$2" in
+        mapped) tests/bin/main23a1 < "$1" ;;
+        piped) cat "$1" | tests/bin/main23a1 ;;
+        iostream) tests/bin/main23a1 --iostream < "$1" ;;
+        binary) tests/bin/main23a1 --convert < "$1" > tests/bin/driver.wcl &&
+                tests/bin/main23a1 --binary < tests/bin/driver.wcl ;;
+    esac
+    echo "exit $?"
+}
+$CXX $FLAGS -o tests/bin/main23a1 main23a1.cpp $OBJECTS || exit 1
+if tests/bin/main23a1 < test.in | cmp -s - test.out; then
+    echo "PASS test.in"
+else
+    echo "FAIL test.in"
+    failed=1
+fi
+for input in tests/driver/*.in; do
+    name=$(basename "$input" .in)
+    for mode in mapped piped iostream binary; do
+        if run_driver "$input" $mode | cmp -s - "tests/driver/$name.out"; then
+            echo "PASS driver/$name ($mode)"
+        else
+            echo "FAIL driver/$name ($mode)"
+            failed=1
+        fi
+    done
+done
+for test in tests/*.cpp; do
+    name=$(basename "$test" .cpp)
+    if ! $CXX $FLAGS -o "tests/bin/$name" "$test" $OBJECTS; then
+        echo "FAIL $name (build)"
+        failed=1
+    elif "tests/bin/$name" | cmp -s - "tests/$name.out"; then
+        echo "PASS $name"
+    else
+        echo "FAIL $name"
+        failed=1
+    fi
+done
+exit $failed
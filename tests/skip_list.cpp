@@ -0,0 +1,228 @@
+//skip_list.cpp - ConcurrentSkipList alone and with several threads, checked for order and for lost or repeated nodes
+
+#include "TestUtils.h"
+#include "../ConcurrentSkipList.h"
+#include <atomic>
+#include <set>
+#include <thread>
+#include <tuple>
+
+static const int THREAD_COUNTS[] = {1, 2, 4, 8};
+static const int SHARED_KEYS = 300;
+
+//The keys of a node, ordered like the list: goals, then more cards first, then ID
+struct SkipKey {
+    int m_goals;
+    int m_cards;
+    int m_id;
+
+    bool operator<(const SkipKey& other) const
+    {
+        return std::make_tuple(m_goals, -m_cards, m_id) < std::make_tuple(other.m_goals, -other.m_cards, other.m_id);
+    }
+};
+
+//Whether the list holds exactly the given keys, in order, and its size and max agree with them
+static bool check_list(ConcurrentSkipList<int>& list, const std::set<SkipKey>& expected)
+{
+    std::vector<int> output(expected.size() + 1, 0);
+    int count = list.get_all_data(output.data());
+    if (count != static_cast<int>(expected.size()) || list.get_size() != count) {
+        return false;
+    }
+    int index = 0;
+    for (const SkipKey& key : expected) {
+        if (output[index++] != key.m_id) {
+            return false;
+        }
+    }
+    return list.search_and_return_max() == (expected.empty() ? 0 : expected.rbegin()->m_id);
+}
+
+//The keys of a shared node - every thread inserts and removes the same ones
+static SkipKey shared_key(int index)
+{
+    return SkipKey{index % 10, index % 3, -1 - index};
+}
+
+//Run the given number of threads on one list. Every thread inserts and removes random nodes with IDs of its own, and
+//all of them race to insert every shared node and then to remove the even ones - each shared insert and remove must
+//succeed in exactly one thread. Returns the number of failed checks
+static int run_threads(int numThreads, unsigned int seed)
+{
+    ConcurrentSkipList<int> list;
+    std::vector<std::set<SkipKey>> owned(numThreads);
+    std::atomic<int> started(0);
+    std::atomic<int> finished(0);
+    std::atomic<int> inserted(0);
+    std::atomic<int> removed(0);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(seed * 100 + t);
+            std::vector<SkipKey> keys;
+            started++;
+            while (started.load() < numThreads) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < 4000; i++) {
+                if (i % 10 == 0) {
+                    SkipKey key = shared_key(i / 10 % SHARED_KEYS);
+                    try {
+                        list.insert(key.m_id, key.m_id, key.m_goals, key.m_cards);
+                        inserted++;
+                    }
+                    catch (const InvalidID& e) {
+                    }
+                }
+                if (keys.empty() || rng() % 3 != 0) {
+                    SkipKey key{static_cast<int>(rng() % 20), static_cast<int>(rng() % 4),
+                                t + 1 + numThreads * static_cast<int>(rng() % 1000)};
+                    try {
+                        list.insert(key.m_id, key.m_id, key.m_goals, key.m_cards);
+                        keys.push_back(key);
+                    }
+                    catch (const InvalidID& e) {
+                        //Only a node with the same keys may already be there, and only this thread adds it
+                        bool found = false;
+                        for (const SkipKey& other : keys) {
+                            found = found || !(other < key || key < other);
+                        }
+                        failures += !found;
+                    }
+                }
+                else {
+                    size_t j = rng() % keys.size();
+                    try {
+                        list.remove(keys[j].m_id, keys[j].m_goals, keys[j].m_cards);
+                    }
+                    catch (const NodeNotFound& e) {
+                        failures++;
+                    }
+                    keys[j] = keys.back();
+                    keys.pop_back();
+                }
+                if (i % 50 == 0) {
+                    list.search_and_return_max();
+                    std::this_thread::yield();
+                }
+            }
+            //The shared nodes are removed once no thread inserts them anymore
+            finished++;
+            while (finished.load() < numThreads) {
+                std::this_thread::yield();
+            }
+            for (int index = 0; index < SHARED_KEYS; index += 2) {
+                try {
+                    list.remove(shared_key(index).m_id, shared_key(index).m_goals, shared_key(index).m_cards);
+                    removed++;
+                }
+                catch (const NodeNotFound& e) {
+                }
+            }
+            owned[t].insert(keys.begin(), keys.end());
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    std::set<SkipKey> expected;
+    for (const std::set<SkipKey>& keys : owned) {
+        expected.insert(keys.begin(), keys.end());
+    }
+    for (int index = 1; index < SHARED_KEYS; index += 2) {
+        expected.insert(shared_key(index));
+    }
+    failures += (inserted.load() != SHARED_KEYS) + (removed.load() != SHARED_KEYS / 2) + !check_list(list, expected);
+    list.reclaim();
+    failures += !check_list(list, expected);
+    return failures.load();
+}
+
+int main()
+{
+    ConcurrentSkipList<int> list;
+    int output[8];
+    printf("get_size() of an empty list: %d\n", list.get_size());
+    printf("search_and_return_max() of an empty list: %d\n", list.search_and_return_max());
+    const int keys[][3] = {{1, 2, 0}, {2, 2, 1}, {3, 0, 0}, {4, 2, 0}, {5, 5, 3}};
+    for (const int* key : keys) {
+        list.insert(key[0] * 10, key[0], key[1], key[2]);
+    }
+    try {
+        list.insert(0, 3, 0, 0);
+    }
+    catch (const InvalidID& e) {
+        printf("insert of 3 again: InvalidID\n");
+    }
+    list.insert(60, 3, 1, 0);
+    try {
+        list.remove(3, 2, 0);
+    }
+    catch (const NodeNotFound& e) {
+        printf("remove of 3 with other keys: NodeNotFound\n");
+    }
+    printf("search_and_return_max(): %d\n", list.search_and_return_max());
+    int count = list.get_all_data(output);
+    printf("get_all_data():");
+    for (int i = 0; i < count; i++) {
+        printf(" %d", output[i]);
+    }
+    printf("\n");
+    list.remove(5, 5, 3);
+    list.remove(3, 0, 0);
+    printf("search_and_return_max() after removing 5: %d\n", list.search_and_return_max());
+    count = list.get_all_data(output);
+    printf("get_all_data():");
+    for (int i = 0; i < count; i++) {
+        printf(" %d", output[i]);
+    }
+    printf("\n");
+
+    //Random inserts and removes from one thread, against a set of the keys
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        ConcurrentSkipList<int> randomList;
+        std::set<SkipKey> expected;
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 3000; i++) {
+            SkipKey key{static_cast<int>(rng() % 8), static_cast<int>(rng() % 3), static_cast<int>(1 + rng() % 200)};
+            bool present = expected.count(key) > 0;
+            bool insert = rng() % 2 == 0;
+            bool thrown = false;
+            try {
+                if (insert) {
+                    randomList.insert(key.m_id, key.m_id, key.m_goals, key.m_cards);
+                    expected.insert(key);
+                }
+                else {
+                    randomList.remove(key.m_id, key.m_goals, key.m_cards);
+                    expected.erase(key);
+                }
+            }
+            catch (const InvalidID& e) {
+                thrown = true;
+            }
+            catch (const NodeNotFound& e) {
+                thrown = true;
+            }
+            //An insert fails only on keys that are there, and a remove only on keys that are not
+            TEST_CHECK(thrown == (insert ? present : !present));
+            if (i % 100 == 99) {
+                TEST_CHECK(check_list(randomList, expected));
+                randomList.reclaim();
+            }
+        }
+    }
+    printf("random single thread: ok\n");
+
+    //Several threads on one list, with their own nodes and with nodes they all race for
+    for (int numThreads : THREAD_COUNTS) {
+        int failures = 0;
+        for (unsigned int seed = 1; seed <= 5; seed++) {
+            failures += run_threads(numThreads, seed);
+        }
+        printf("%d threads: %d failed checks\n", numThreads, failures);
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+//snapshot_reads.cpp - get_all_players and knockout_winner from published versions, alone and alongside writers
+
+#include "TestUtils.h"
+#include <atomic>
+#include <thread>
+
+static const int NUM_EXPORTERS = 3;
+static const int NUM_PLAYERS = 900;
+
+//Compare the exports and knockouts of a system with snapshot reads with those of a system without them
+static bool check_same(world_cup_t& snapshot, world_cup_t& plain, const Model& model, int minTeamId, int maxTeamId)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(-1);
+    std::vector<int> first(players.size() + 1);
+    std::vector<int> second(players.size() + 1);
+    StatusType status = snapshot.get_all_players(-1, first.data());
+    if (status != plain.get_all_players(-1, second.data())) {
+        return false;
+    }
+    for (size_t i = 0; i < players.size(); i++) {
+        if (first[i] != players[i].m_id || second[i] != players[i].m_id) {
+            return false;
+        }
+    }
+    output_t<int> winner = snapshot.knockout_winner(minTeamId, maxTeamId);
+    output_t<int> plainWinner = plain.knockout_winner(minTeamId, maxTeamId);
+    return winner.status() == plainWinner.status() && winner.ans() == plainWinner.ans();
+}
+
+//Export until stopped, while players are added and removed - every export must be sorted with no repeated player.
+//Returns the number of failed exports
+static int export_until_stopped(world_cup_t* system, const std::atomic<bool>* stop)
+{
+    std::vector<int> output(NUM_PLAYERS + 1);
+    std::vector<char> seen(NUM_PLAYERS + 1);
+    int failures = 0;
+    while (!stop->load()) {
+        std::fill(output.begin(), output.end(), 0);
+        std::fill(seen.begin(), seen.end(), 0);
+        StatusType status = system->get_all_players(-1, output.data());
+        for (int i = 0; status == StatusType::SUCCESS && output[i] != 0; i++) {
+            if (seen[output[i]] || (i > 0 && !is_before(output[i - 1], output[i]))) {
+                failures++;
+                break;
+            }
+            seen[output[i]] = 1;
+        }
+        system->knockout_winner(1, 10);
+        std::this_thread::yield();
+    }
+    return failures;
+}
+
+int main()
+{
+    world_cup_t system;
+    print_status("set_snapshot_reads(true)", system.set_snapshot_reads(true));
+    int output[40];
+    print_status("get_all_players(-1) of no players", system.get_all_players(-1, output));
+    print_output("knockout_winner(1, 3) of no teams", system.knockout_winner(1, 3));
+    system.add_team(1, 0);
+    system.add_team(2, 3);
+    system.add_team(3, 0);
+    add_squad(system, 100, 1, 2, 0);
+    add_squad(system, 200, 2, 0, 1);
+    add_squad(system, 300, 3, 1, 0);
+    //Team strengths: 22, -8 and 11
+    print_output("knockout_winner(1, 3)", system.knockout_winner(1, 3));
+    print_status("update_player_stats(200, 0, 40, 0)", system.update_player_stats(200, 0, 40, 0));
+    print_output("knockout_winner(1, 3)", system.knockout_winner(1, 3));
+    print_status("get_all_players(-1)", system.get_all_players(-1, output));
+    printf("first players: %d %d, last players: %d %d\n", output[0], output[1], output[31], output[32]);
+    print_status("set_snapshot_reads(false)", system.set_snapshot_reads(false));
+    print_output("knockout_winner(1, 3)", system.knockout_winner(1, 3));
+
+    //Random streams on a system with snapshot reads, turned off and on again from time to time, and on one without
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t snapshotSystem;
+        world_cup_t plainSystem;
+        Model snapshotModel;
+        Model plainModel;
+        RandomStream snapshotStream(seed, 10, 150);
+        RandomStream plainStream(seed, 10, 150);
+        TEST_CHECK(snapshotSystem.set_snapshot_reads(true) == StatusType::SUCCESS);
+        bool enabled = true;
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(snapshotStream.step(snapshotSystem, snapshotModel));
+            TEST_CHECK(plainStream.step(plainSystem, plainModel));
+            if (rng() % 200 == 0) {
+                enabled = !enabled;
+                TEST_CHECK(snapshotSystem.set_snapshot_reads(enabled) == StatusType::SUCCESS);
+            }
+            int minTeamId = static_cast<int>(rng() % 10);
+            TEST_CHECK(check_same(snapshotSystem, plainSystem, snapshotModel, minTeamId,
+                                  minTeamId + static_cast<int>(rng() % 6)));
+        }
+    }
+    printf("random snapshot reads: ok\n");
+
+    //Exporters with snapshot reads while one writer adds players, then removes every third of them
+    world_cup_t* shared = new world_cup_t();
+    TEST_CHECK(shared->set_snapshot_reads(true) == StatusType::SUCCESS);
+    for (int teamId = 1; teamId <= 10; teamId++) {
+        TEST_CHECK(shared->add_team(teamId, 0) == StatusType::SUCCESS);
+    }
+    std::atomic<bool> stop(false);
+    std::vector<int> failures(NUM_EXPORTERS, 0);
+    std::vector<std::thread> exporters;
+    for (int e = 0; e < NUM_EXPORTERS; e++) {
+        exporters.emplace_back([&, e] { failures[e] = export_until_stopped(shared, &stop); });
+    }
+    for (int playerId = 1; playerId <= NUM_PLAYERS; playerId++) {
+        shared->add_player(playerId, playerId % 10 + 1, 1, playerId % 7, 0, playerId % 10 == playerId % 20);
+        std::this_thread::yield();
+    }
+    for (int playerId = 3; playerId <= NUM_PLAYERS; playerId += 3) {
+        shared->remove_player(playerId);
+        std::this_thread::yield();
+    }
+    stop = true;
+    int totalFailures = 0;
+    for (int e = 0; e < NUM_EXPORTERS; e++) {
+        exporters[e].join();
+        totalFailures += failures[e];
+    }
+    printf("failed exports alongside the writer: %d\n", totalFailures);
+    print_output("get_all_players_count(-1)", shared->get_all_players_count(-1));
+    print_output("knockout_winner(1, 10)", shared->knockout_winner(1, 10));
+    std::vector<int> published(NUM_PLAYERS + 1);
+    std::vector<int> walked(NUM_PLAYERS + 1);
+    TEST_CHECK(shared->get_all_players(-1, published.data()) == StatusType::SUCCESS);
+    TEST_CHECK(shared->set_snapshot_reads(false) == StatusType::SUCCESS);
+    TEST_CHECK(shared->get_all_players(-1, walked.data()) == StatusType::SUCCESS);
+    printf("published version equals the tree: %s\n", (published == walked) ? "yes" : "no");
+    print_output("knockout_winner(1, 10)", shared->knockout_winner(1, 10));
+    delete shared;
+    return 0;
+}
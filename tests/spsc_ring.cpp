@@ -0,0 +1,59 @@
+//spsc_ring.cpp - SpscRing passing items in order between two threads, through rings of several sizes
+
+#include "TestUtils.h"
+#include "../SpscRing.h"
+#include <thread>
+
+static const int NUM_ITEMS = 200000;
+
+//An item larger than a word, so a torn copy would show as a mismatch between its fields
+struct Item {
+    int m_sequence;
+    long long m_square;
+};
+
+//Push the items from one thread and pop them on this one, and return the number of items out of order or torn
+static int pass_items(int capacity)
+{
+    SpscRing<Item> ring(capacity);
+    std::thread producer([&] {
+        for (int i = 0; i < NUM_ITEMS; i++) {
+            ring.push(Item{i, static_cast<long long>(i) * i});
+        }
+    });
+    int failures = 0;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        Item item;
+        ring.pop(item);
+        if (item.m_sequence != i || item.m_square != static_cast<long long>(i) * i) {
+            failures++;
+        }
+    }
+    producer.join();
+    return failures;
+}
+
+int main()
+{
+    //A ring of one item, rings rounded up to a power of two, and the size used by the driver
+    const int capacities[] = {1, 3, 64, 4096};
+    for (int capacity : capacities) {
+        printf("capacity %d: %d items, %d out of order\n", capacity, NUM_ITEMS, pass_items(capacity));
+    }
+
+    //Items pushed and popped by the same thread, wrapping around the ring several times
+    SpscRing<int> ring(4);
+    int failures = 0;
+    for (int i = 0; i < 40; i += 3) {
+        ring.push(i);
+        ring.push(i + 1);
+        ring.push(i + 2);
+        for (int j = i; j < i + 3; j++) {
+            int item;
+            ring.pop(item);
+            failures += (item != j);
+        }
+    }
+    printf("single thread wraps: %d out of order\n", failures);
+    return 0;
+}
@@ -0,0 +1,93 @@
+//standings.cpp - get_top_teams_by_points, get_strongest_teams and the rank queries
+
+#include "TestUtils.h"
+
+//Compare the standings of the system with the model - every order and every rank
+static bool check_standings(world_cup_t& system, const Model& model)
+{
+    std::vector<std::pair<int, int> > byPoints;
+    std::vector<std::pair<int, int> > byStrength;
+    for (std::map<int, Model::ModelTeam>::const_iterator it = model.m_teams.begin(); it != model.m_teams.end(); ++it) {
+        byPoints.push_back(std::make_pair(it->second.m_points, it->first));
+        if (model.is_qualified(it->first)) {
+            byStrength.push_back(std::make_pair(model.get_strength(it->first), it->first));
+        }
+    }
+    //The most points first, ties broken by the higher ID
+    std::sort(byPoints.rbegin(), byPoints.rend());
+    std::sort(byStrength.rbegin(), byStrength.rend());
+    std::vector<int> output(byPoints.size() + 1);
+    output_t<int> top = system.get_top_teams_by_points(static_cast<int>(byPoints.size()) + 1, output.data());
+    if (byPoints.empty()) {
+        return top.status() == StatusType::FAILURE;
+    }
+    if (top.status() != StatusType::SUCCESS || top.ans() != static_cast<int>(byPoints.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < byPoints.size(); i++) {
+        if (output[i] != byPoints[i].second || system.get_team_points_rank(byPoints[i].second).ans() != (int)i + 1) {
+            return false;
+        }
+    }
+    output_t<int> strongest = system.get_strongest_teams(static_cast<int>(byPoints.size()) + 1, output.data());
+    if (byStrength.empty()) {
+        return strongest.status() == StatusType::FAILURE;
+    }
+    if (strongest.status() != StatusType::SUCCESS || strongest.ans() != static_cast<int>(byStrength.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < byStrength.size(); i++) {
+        if (output[i] != byStrength[i].second ||
+            system.get_team_strength_rank(byStrength[i].second).ans() != (int)i + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    int output[8];
+    world_cup_t system;
+    print_ids("get_top_teams_by_points(3) of no teams", system.get_top_teams_by_points(3, output), output);
+    system.add_team(1, 5);
+    system.add_team(2, 3);
+    system.add_team(3, 5);
+    system.add_team(4, 0);
+    //Strength of team 1: 5 + 11 - 0 = 16, of team 2: 3 + 22 - 11 = 14. Team 3 and 4 are not qualified.
+    add_squad(system, 100, 1, 1, 0);
+    add_squad(system, 200, 2, 2, 1);
+    print_ids("get_top_teams_by_points(3)", system.get_top_teams_by_points(3, output), output);
+    print_ids("get_top_teams_by_points(8)", system.get_top_teams_by_points(8, output), output);
+    print_ids("get_strongest_teams(8)", system.get_strongest_teams(8, output), output);
+    print_output("get_team_points_rank(1)", system.get_team_points_rank(1));
+    print_output("get_team_points_rank(3)", system.get_team_points_rank(3));
+    print_output("get_team_strength_rank(2)", system.get_team_strength_rank(2));
+    print_output("get_team_strength_rank(3)", system.get_team_strength_rank(3));
+    print_output("get_team_points_rank(9)", system.get_team_points_rank(9));
+    print_status("play_match(1, 2)", system.play_match(1, 2));
+    print_ids("get_top_teams_by_points(8)", system.get_top_teams_by_points(8, output), output);
+    print_output("get_team_points_rank(2)", system.get_team_points_rank(2));
+    //Team 2 overtakes team 1 in strength: 3 + 44 - 11 = 36 against 8 + 11 = 19
+    for (int i = 0; i < 11; i++) {
+        system.update_player_stats(200 + i, 1, 2, 0);
+    }
+    print_ids("get_strongest_teams(1)", system.get_strongest_teams(1, output), output);
+    print_output("get_team_strength_rank(1)", system.get_team_strength_rank(1));
+    print_ids("get_top_teams_by_points(0)", system.get_top_teams_by_points(0, output), output);
+    print_ids("get_strongest_teams(nullptr)", system.get_strongest_teams(2, nullptr), output);
+    print_output("get_team_points_rank(0)", system.get_team_points_rank(0));
+
+    //Random streams of commands, checking every order and rank after each command
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 8, 120);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            TEST_CHECK(check_standings(randomSystem, model));
+        }
+    }
+    printf("random standings: ok\n");
+    return 0;
+}
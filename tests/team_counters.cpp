@@ -0,0 +1,120 @@
+//team_counters.cpp - Team::get_counters and the getters it serves, read while the counters change
+
+#include "TestUtils.h"
+#include "../Teams.h"
+#include <atomic>
+#include <thread>
+
+static const int NUM_READERS = 3;
+static const int NUM_UPDATES = 3000;
+
+//Read the counters of the team until stopped - every win adds a game, a player and 3 points in one update, so the
+//counters must always agree. Returns the number of torn reads
+static int read_counters(const Team* team, const std::atomic<bool>* stop)
+{
+    int failures = 0;
+    int lastGames = 0;
+    while (!stop->load()) {
+        TeamCounters counters = team->get_counters();
+        if (counters.m_points != 5 + 3 * counters.m_games || counters.m_players != counters.m_games ||
+            counters.m_games < lastGames) {
+            failures++;
+        }
+        lastGames = counters.m_games;
+        std::this_thread::yield();
+    }
+    return failures;
+}
+
+//Read the points of team 1 and the players of team 3 until stopped - team 1 only wins, and team 3 only gains
+//players. Returns the number of failed checks
+static int read_getters(world_cup_t* system, const std::atomic<bool>* stop)
+{
+    int failures = 0;
+    int lastPoints = 0;
+    int lastPlayers = 0;
+    while (!stop->load()) {
+        int points = system->get_team_points(1).ans();
+        int players = system->get_all_players_count(3).ans();
+        if (points % 3 != 0 || points < lastPoints || players < lastPlayers) {
+            failures++;
+        }
+        lastPoints = points;
+        lastPlayers = players;
+        std::this_thread::yield();
+    }
+    return failures;
+}
+
+//Run the readers while the writer runs, and return the number of failed checks
+template <class Read, class Write>
+static int run_readers(Read read, Write write)
+{
+    std::atomic<bool> stop(false);
+    std::atomic<int> started(0);
+    std::vector<int> failures(NUM_READERS, 0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; r++) {
+        readers.emplace_back([&, r] {
+            started++;
+            failures[r] = read(&stop);
+        });
+    }
+    while (started.load() < NUM_READERS) {
+        std::this_thread::yield();
+    }
+    write();
+    stop = true;
+    int total = 0;
+    for (int r = 0; r < NUM_READERS; r++) {
+        readers[r].join();
+        total += failures[r];
+    }
+    return total;
+}
+
+int main()
+{
+    Team team(1, 5);
+    TeamCounters counters = team.get_counters();
+    printf("new team: points %d, games %d, players %d\n", counters.m_points, counters.m_games, counters.m_players);
+    int failures = run_readers([&](const std::atomic<bool>* stop) { return read_counters(&team, stop); }, [&] {
+        for (int i = 0; i < NUM_UPDATES; i++) {
+            team.begin_update();
+            team.add_game();
+            //Now and then the writer is switched out in the middle of an update
+            if (i % 100 == 0) {
+                std::this_thread::yield();
+            }
+            team.update_points_won();
+            team.add_player_stats(0, 0, false);
+            team.end_update();
+            std::this_thread::yield();
+        }
+    });
+    counters = team.get_counters();
+    printf("torn counter reads: %d\n", failures);
+    printf("after %d wins: points %d, games %d, players %d\n", NUM_UPDATES, counters.m_points, counters.m_games,
+           counters.m_players);
+
+    //Team 1 outscores team 2 in every match, while players join team 3
+    world_cup_t* system = new world_cup_t();
+    for (int teamId = 1; teamId <= 3; teamId++) {
+        TEST_CHECK(system->add_team(teamId, 0) == StatusType::SUCCESS);
+    }
+    TEST_CHECK(add_squad(*system, 100, 1, 2, 0) && add_squad(*system, 200, 2, 0, 1));
+    failures = run_readers([&](const std::atomic<bool>* stop) { return read_getters(system, stop); }, [&] {
+        for (int i = 0; i < 500; i++) {
+            system->play_match(1, 2);
+            system->add_player(1000 + i, 3, 1, i % 4, 0, false);
+            std::this_thread::yield();
+        }
+    });
+    printf("failed getter reads: %d\n", failures);
+    print_output("get_team_points(1)", system->get_team_points(1));
+    print_output("get_team_points(2)", system->get_team_points(2));
+    print_output("get_all_players_count(3)", system->get_all_players_count(3));
+    print_output("get_num_played_games(100)", system->get_num_played_games(100));
+    delete system;
+    return 0;
+}
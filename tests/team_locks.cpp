@@ -0,0 +1,179 @@
+//team_locks.cpp - writers on disjoint teams in parallel, with readers of the whole game, end as if run one by one
+
+#include "TestUtils.h"
+#include <atomic>
+#include <thread>
+
+static const int NUM_WRITERS = 4;
+static const int TEAMS_PER_WRITER = 4;
+static const int NUM_READERS = 2;
+static const int OPS_PER_WRITER = 600;
+
+//A command of a writer - an add_player, an update_player_stats or a play_match, on the teams of the writer only
+struct TeamCommand {
+    int m_kind;
+    int m_playerId;
+    int m_teamId1;
+    int m_teamId2;
+    int m_goals;
+    int m_cards;
+    bool m_goalKeeper;
+};
+
+//The commands of a writer, which owns the teams writer * TEAMS_PER_WRITER + 1 to + TEAMS_PER_WRITER and the player
+//ID's from writer * 10000 + 1
+static std::vector<TeamCommand> make_commands(int writer, unsigned int seed)
+{
+    std::mt19937 rng(seed * 10 + writer);
+    std::vector<TeamCommand> commands;
+    int firstTeam = writer * TEAMS_PER_WRITER + 1;
+    int nextPlayer = writer * 10000 + 1;
+    for (int i = 0; i < OPS_PER_WRITER; i++) {
+        int kind = static_cast<int>(rng() % 10);
+        int teamId1 = firstTeam + static_cast<int>(rng() % TEAMS_PER_WRITER);
+        int teamId2 = firstTeam + (teamId1 - firstTeam + 1 + static_cast<int>(rng() % (TEAMS_PER_WRITER - 1))) %
+                                  TEAMS_PER_WRITER;
+        int goals = static_cast<int>(rng() % 4);
+        int cards = static_cast<int>(rng() % 3);
+        //Mostly new players, some of them added twice, and updates of players that may not exist yet
+        if (kind < 5) {
+            int playerId = (rng() % 8 == 0 && nextPlayer > writer * 10000 + 1) ? nextPlayer - 1 : nextPlayer++;
+            commands.push_back(TeamCommand{0, playerId, teamId1, 0, goals, cards, rng() % 6 == 0});
+        }
+        else if (kind < 8) {
+            int playerId = writer * 10000 + 1 + static_cast<int>(rng() % (nextPlayer - writer * 10000 + 5));
+            commands.push_back(TeamCommand{1, playerId, 0, 0, goals, cards, false});
+        }
+        else {
+            commands.push_back(TeamCommand{2, 0, teamId1, teamId2, 0, 0, false});
+        }
+    }
+    return commands;
+}
+
+//Run a command, on the system or on the model
+template <class System>
+static StatusType run_command(System& system, const TeamCommand& command)
+{
+    if (command.m_kind == 0) {
+        return system.add_player(command.m_playerId, command.m_teamId1, 1, command.m_goals, command.m_cards,
+                                 command.m_goalKeeper);
+    }
+    if (command.m_kind == 1) {
+        return system.update_player_stats(command.m_playerId, 1, command.m_goals, command.m_cards);
+    }
+    return system.play_match(command.m_teamId1, command.m_teamId2);
+}
+
+//Compare the system with the model - every player in order with its games, and the points and top scorer of every
+//team
+static bool check_state(world_cup_t& system, const Model& model)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(-1);
+    if (system.get_all_players_count(-1).ans() != static_cast<int>(players.size()) || !check_players(system, model)) {
+        return false;
+    }
+    for (std::map<int, Model::ModelTeam>::const_iterator it = model.m_teams.begin(); it != model.m_teams.end(); ++it) {
+        std::vector<Model::ModelPlayer> teamPlayers = model.get_team_players(it->first);
+        int topScorer = teamPlayers.empty() ? 0 : teamPlayers.back().m_id;
+        if (system.get_team_points(it->first).ans() != it->second.m_points ||
+            system.get_top_scorer(it->first).ans() != topScorer) {
+            return false;
+        }
+    }
+    return system.get_top_scorer(-1).ans() == players.back().m_id;
+}
+
+//Query the whole game and single teams until stopped - the answers are not checked, only that the queries run
+//alongside the writers
+static void read_until_stopped(world_cup_t* system, const std::atomic<bool>* stop, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int> output(NUM_WRITERS * 10000);
+    while (!stop->load()) {
+        int teamId = 1 + static_cast<int>(rng() % (NUM_WRITERS * TEAMS_PER_WRITER));
+        switch (rng() % 5) {
+            case 0:
+                system->get_all_players(-1, output.data());
+                break;
+            case 1:
+                system->get_top_scorer(teamId);
+                break;
+            case 2:
+                system->get_team_strength_rank(teamId);
+                break;
+            case 3:
+                system->get_closest_players(1 + static_cast<int>(rng() % 300), -1, 3, output.data());
+                break;
+            default:
+                system->knockout_winner(1, NUM_WRITERS * TEAMS_PER_WRITER);
+        }
+        std::this_thread::yield();
+    }
+}
+
+//Run the writers and readers on the system, then the writers one by one on the model, and compare the two. Returns
+//the number of commands whose status differed from the model, or -1 if the final states differ
+static int run_writers(world_cup_t* system, Model& model, unsigned int seed)
+{
+    std::vector<std::vector<TeamCommand> > commands;
+    std::vector<std::vector<StatusType> > statuses(NUM_WRITERS);
+    for (int w = 0; w < NUM_WRITERS; w++) {
+        commands.push_back(make_commands(w, seed));
+    }
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; r++) {
+        readers.emplace_back(read_until_stopped, system, &stop, seed * 100 + r);
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < NUM_WRITERS; w++) {
+        writers.emplace_back([&, w] {
+            for (const TeamCommand& command : commands[w]) {
+                statuses[w].push_back(run_command(*system, command));
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    stop = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    int differences = 0;
+    for (int w = 0; w < NUM_WRITERS; w++) {
+        for (size_t i = 0; i < commands[w].size(); i++) {
+            differences += (run_command(model, commands[w][i]) != statuses[w][i]);
+        }
+    }
+    return check_state(*system, model) ? differences : -1;
+}
+
+int main()
+{
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t* system = new world_cup_t();
+        Model model;
+        for (int teamId = 1; teamId <= NUM_WRITERS * TEAMS_PER_WRITER; teamId++) {
+            TEST_CHECK(system->add_team(teamId, teamId % 3) == model.add_team(teamId, teamId % 3));
+        }
+        //The first seed runs with frozen players, whose snapshot is shared by all the teams
+        if (seed == 1) {
+            TEST_CHECK(system->freeze_players(4) == StatusType::SUCCESS);
+        }
+        TEST_CHECK(run_writers(system, model, seed) == 0);
+        if (seed == 1) {
+            print_output("get_all_players_count(-1)", system->get_all_players_count(-1));
+            print_output("get_top_scorer(-1)", system->get_top_scorer(-1));
+            for (int teamId = 1; teamId <= NUM_WRITERS * TEAMS_PER_WRITER; teamId += 5) {
+                printf("team %d: ", teamId);
+                print_output("get_team_points", system->get_team_points(teamId));
+            }
+        }
+        delete system;
+    }
+    printf("random disjoint writers: ok\n");
+    return 0;
+}
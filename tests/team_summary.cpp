@@ -0,0 +1,80 @@
+//team_summary.cpp - get_teams_summary over ranges of team ID's
+
+#include "TestUtils.h"
+
+static const TeamStat STATS[] = {TeamStat::POINTS, TeamStat::GOALS, TeamStat::CARDS, TeamStat::PLAYERS};
+static const SummaryType TYPES[] = {SummaryType::SUM, SummaryType::MIN, SummaryType::MAX};
+
+//Compare the summary of every stat over [minTeamId, maxTeamId] with the model
+static bool check_summary(world_cup_t& system, const Model& model, int minTeamId, int maxTeamId)
+{
+    for (int stat = 0; stat < 4; stat++) {
+        int count = 0;
+        int sum = 0;
+        int min = 0;
+        int max = 0;
+        for (std::map<int, Model::ModelTeam>::const_iterator it = model.m_teams.lower_bound(minTeamId);
+             it != model.m_teams.end() && it->first <= maxTeamId; ++it) {
+            int value = model.get_team_stat(it->first, stat);
+            min = (count == 0 || value < min) ? value : min;
+            max = (count == 0 || value > max) ? value : max;
+            sum += value;
+            count++;
+        }
+        const int expected[] = {sum, min, max};
+        for (int type = 0; type < 3; type++) {
+            output_t<int> summary = system.get_teams_summary(minTeamId, maxTeamId, STATS[stat], TYPES[type]);
+            if (count == 0) {
+                if (summary.status() != StatusType::FAILURE) {
+                    return false;
+                }
+            }
+            else if (summary.status() != StatusType::SUCCESS || summary.ans() != expected[type]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    world_cup_t system;
+    print_output("summary of no teams", system.get_teams_summary(0, 10, TeamStat::POINTS, SummaryType::SUM));
+    system.add_team(2, 4);
+    system.add_team(5, 1);
+    system.add_team(9, 7);
+    system.add_player(20, 2, 1, 3, 1, false);
+    system.add_player(21, 2, 1, 5, 0, true);
+    system.add_player(50, 5, 2, 1, 4, false);
+    print_output("points sum [1, 9]", system.get_teams_summary(1, 9, TeamStat::POINTS, SummaryType::SUM));
+    print_output("points min [1, 9]", system.get_teams_summary(1, 9, TeamStat::POINTS, SummaryType::MIN));
+    print_output("points max [3, 8]", system.get_teams_summary(3, 8, TeamStat::POINTS, SummaryType::MAX));
+    print_output("goals sum [2, 5]", system.get_teams_summary(2, 5, TeamStat::GOALS, SummaryType::SUM));
+    print_output("goals min [2, 9]", system.get_teams_summary(2, 9, TeamStat::GOALS, SummaryType::MIN));
+    print_output("cards max [0, 100]", system.get_teams_summary(0, 100, TeamStat::CARDS, SummaryType::MAX));
+    print_output("players sum [2, 2]", system.get_teams_summary(2, 2, TeamStat::PLAYERS, SummaryType::SUM));
+    print_output("players sum [6, 8]", system.get_teams_summary(6, 8, TeamStat::PLAYERS, SummaryType::SUM));
+    print_status("update_player_stats(50, 1, 2, 1)", system.update_player_stats(50, 1, 2, 1));
+    print_output("goals max [5, 5]", system.get_teams_summary(5, 5, TeamStat::GOALS, SummaryType::MAX));
+    print_status("remove_player(21)", system.remove_player(21));
+    print_output("goals sum [0, 9]", system.get_teams_summary(0, 9, TeamStat::GOALS, SummaryType::SUM));
+    print_output("summary of [5, 2]", system.get_teams_summary(5, 2, TeamStat::POINTS, SummaryType::SUM));
+    print_output("summary of [-1, 2]", system.get_teams_summary(-1, 2, TeamStat::POINTS, SummaryType::SUM));
+
+    //Random streams of commands, checking random ranges after each command
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 12, 120);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            int minTeamId = stream.next(14);
+            int maxTeamId = minTeamId + stream.next(14);
+            TEST_CHECK(check_summary(randomSystem, model, minTeamId, maxTeamId));
+            TEST_CHECK(check_summary(randomSystem, model, 0, 13));
+        }
+    }
+    printf("random summaries: ok\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+//thread_pool.cpp - ThreadPool forks, nesting, exceptions and outside callers, and set_worker_threads in world_cup
+
+#include "TestUtils.h"
+#include "../ThreadPool.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+static const int NUM_PLAYERS = 20000;
+
+//Fibonacci by nested forks
+static long long fibonacci(ThreadPool& pool, int n)
+{
+    if (n < 2) {
+        return n;
+    }
+    long long first = 0;
+    long long second = 0;
+    pool.parallel_invoke([&]() { first = fibonacci(pool, n - 1); }, [&]() { second = fibonacci(pool, n - 2); });
+    return first + second;
+}
+
+//Sum i * i over [0, count) with parallel_for
+static long long sum_squares(ThreadPool& pool, int count, int grain)
+{
+    std::vector<long long> squares(count);
+    pool.parallel_for(0, count, grain, [&](int i) { squares[i] = static_cast<long long>(i) * i; });
+    long long sum = 0;
+    for (long long square : squares) {
+        sum += square;
+    }
+    return sum;
+}
+
+//Whether an exception of one forked function reaches the caller once the other function is done as well
+static bool check_exception(ThreadPool& pool)
+{
+    std::atomic<bool> otherDone(false);
+    try {
+        pool.parallel_invoke([]() { throw std::runtime_error("first"); }, [&]() { otherDone = true; });
+    }
+    catch (const std::runtime_error& e) {
+        return otherDone.load() && std::string(e.what()) == "first";
+    }
+    return false;
+}
+
+//Add the teams and the players of the system for the exports
+static void add_players(world_cup_t& system)
+{
+    for (int teamId = 1; teamId <= 4; teamId++) {
+        system.add_team(teamId, 0);
+    }
+    for (int playerId = 1; playerId <= NUM_PLAYERS; playerId++) {
+        system.add_player(playerId, playerId % 4 + 1, 1 + playerId % 3, playerId % 7, playerId % 5, playerId % 11 == 0);
+    }
+}
+
+//Unite the teams into team 7, compact the players, and export every player and the players of team 7
+static std::vector<int> unite_and_export(world_cup_t& system)
+{
+    std::vector<int> output(2 * NUM_PLAYERS);
+    system.unite_teams(1, 2, 5);
+    system.unite_teams(3, 4, 6);
+    system.unite_teams(5, 6, 7);
+    system.compact_players();
+    system.get_all_players(-1, output.data());
+    system.get_all_players(7, output.data() + NUM_PLAYERS);
+    for (int playerId = 1; playerId <= NUM_PLAYERS; playerId += 97) {
+        output.push_back(system.get_num_played_games(playerId).ans());
+        output.push_back(system.get_closest_player(playerId, 7).ans());
+    }
+    output.push_back(system.get_top_scorer(7).ans());
+    return output;
+}
+
+int main()
+{
+    const int sizes[] = {1, 2, 4};
+    for (int numThreads : sizes) {
+        ThreadPool pool(numThreads);
+        printf("pool of %d: fibonacci(20) %lld, squares %lld %lld, exception %s\n", pool.get_num_threads(),
+               fibonacci(pool, 20), sum_squares(pool, 100000, 1), sum_squares(pool, 100000, 4096),
+               check_exception(pool) ? "ok" : "lost");
+    }
+
+    //Several outside threads fork into one pool at the same time, and the pool is resized between the rounds
+    ThreadPool shared(3);
+    for (int round = 0; round < 3; round++) {
+        std::vector<long long> results(6, 0);
+        std::vector<std::thread> callers;
+        for (int c = 0; c < 6; c++) {
+            callers.emplace_back([&, c] { results[c] = fibonacci(shared, 15 + c) + sum_squares(shared, 5000, 64); });
+        }
+        for (std::thread& caller : callers) {
+            caller.join();
+        }
+        ThreadPool single(1);
+        for (int c = 0; c < 6; c++) {
+            TEST_CHECK(results[c] == fibonacci(single, 15 + c) + sum_squares(single, 5000, 64));
+        }
+        shared.resize(2 + round * 2);
+    }
+    printf("outside callers: ok\n");
+
+    world_cup_t system;
+    print_status("set_worker_threads(0)", system.set_worker_threads(0));
+    print_status("set_worker_threads(4)", system.set_worker_threads(4));
+    print_status("set_worker_threads(1)", system.set_worker_threads(1));
+
+    //The same unites and exports with every number of threads, then exports from several threads at once
+    world_cup_t serial;
+    add_players(serial);
+    std::vector<int> expected = unite_and_export(serial);
+    print_output("get_all_players_count(7)", serial.get_all_players_count(7));
+    print_output("get_top_scorer(7)", serial.get_top_scorer(7));
+    for (int numThreads : sizes) {
+        world_cup_t parallel;
+        TEST_CHECK(parallel.set_worker_threads(numThreads) == StatusType::SUCCESS);
+        add_players(parallel);
+        TEST_CHECK(unite_and_export(parallel) == expected);
+        std::vector<std::vector<int> > exports(4, std::vector<int>(NUM_PLAYERS));
+        std::vector<StatusType> statuses(4);
+        std::vector<std::thread> exporters;
+        for (int e = 0; e < 4; e++) {
+            exporters.emplace_back([&, e] { statuses[e] = parallel.get_all_players(-1, exports[e].data()); });
+        }
+        for (std::thread& exporter : exporters) {
+            exporter.join();
+        }
+        for (int e = 0; e < 4; e++) {
+            TEST_CHECK(statuses[e] == StatusType::SUCCESS &&
+                       std::equal(exports[e].begin(), exports[e].end(), expected.begin()));
+        }
+    }
+    printf("parallel unites and exports: ok\n");
+    return 0;
+}
@@ -0,0 +1,66 @@
+//top_scorers.cpp - get_top_scorers of a team and of the entire game
+
+#include "TestUtils.h"
+
+//Compare the top scorers of a team (or of the entire game, if teamId < 0) with the model
+static bool check_top_scorers(world_cup_t& system, const Model& model, int teamId, int amount)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(teamId);
+    std::vector<int> output(amount);
+    output_t<int> top = system.get_top_scorers(teamId, amount, output.data());
+    if (players.empty()) {
+        return top.status() == StatusType::FAILURE;
+    }
+    int expected = std::min(amount, static_cast<int>(players.size()));
+    if (top.status() != StatusType::SUCCESS || top.ans() != expected) {
+        return false;
+    }
+    for (int i = 0; i < expected; i++) {
+        if (output[i] != players[players.size() - 1 - i].m_id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    int output[8];
+    world_cup_t system;
+    print_ids("get_top_scorers(-1, 3) of no players", system.get_top_scorers(-1, 3, output), output);
+    system.add_team(1, 0);
+    system.add_team(2, 0);
+    print_ids("get_top_scorers(1, 3) of an empty team", system.get_top_scorers(1, 3, output), output);
+    system.add_player(10, 1, 1, 4, 0, false);
+    system.add_player(11, 1, 1, 4, 2, false);
+    system.add_player(12, 1, 1, 7, 1, false);
+    system.add_player(20, 2, 1, 4, 0, false);
+    system.add_player(21, 2, 1, 9, 3, false);
+    print_ids("get_top_scorers(1, 8)", system.get_top_scorers(1, 8, output), output);
+    print_ids("get_top_scorers(1, 2)", system.get_top_scorers(1, 2, output), output);
+    print_ids("get_top_scorers(-1, 4)", system.get_top_scorers(-1, 4, output), output);
+    print_status("update_player_stats(11, 1, 6, 0)", system.update_player_stats(11, 1, 6, 0));
+    print_ids("get_top_scorers(-1, 8)", system.get_top_scorers(-1, 8, output), output);
+    print_ids("get_top_scorers(3, 2)", system.get_top_scorers(3, 2, output), output);
+    print_ids("get_top_scorers(0, 2)", system.get_top_scorers(0, 2, output), output);
+    print_ids("get_top_scorers(1, 0)", system.get_top_scorers(1, 0, output), output);
+    print_ids("get_top_scorers(1, 2, nullptr)", system.get_top_scorers(1, 2, nullptr), output);
+
+    //Random streams of commands, checking the top scorers of a random team and of the game after each command
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 8, 120);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            int teamId = 1 + stream.next(8);
+            int amount = 1 + stream.next(30);
+            if (model.m_teams.count(teamId) != 0) {
+                TEST_CHECK(check_top_scorers(randomSystem, model, teamId, amount));
+            }
+            TEST_CHECK(check_top_scorers(randomSystem, model, -1, amount));
+        }
+    }
+    printf("random top scorers: ok\n");
+    return 0;
+}
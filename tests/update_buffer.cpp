@@ -0,0 +1,69 @@
+//update_buffer.cpp - set_update_buffer and flush_updates give the same results as unbuffered updates
+
+#include "TestUtils.h"
+
+//Compare everything that depends on the stats of the players with the model
+static bool check_stats(world_cup_t& system, const Model& model)
+{
+    std::vector<Model::ModelPlayer> players = model.get_team_players(-1);
+    if (players.empty()) {
+        return system.get_top_scorer(-1).status() == StatusType::FAILURE;
+    }
+    return check_players(system, model) && system.get_top_scorer(-1).ans() == players.back().m_id &&
+           check_teams(system, model);
+}
+
+int main()
+{
+    world_cup_t system;
+    print_status("set_update_buffer(-1, 0)", system.set_update_buffer(-1, 0));
+    print_status("set_update_buffer(4, -1)", system.set_update_buffer(4, -1));
+    print_status("flush_updates() of no updates", system.flush_updates());
+    print_status("set_update_buffer(4, 0)", system.set_update_buffer(4, 0));
+    system.add_team(1, 0);
+    system.add_team(2, 0);
+    system.add_player(10, 1, 2, 1, 0, false);
+    system.add_player(11, 1, 2, 2, 0, false);
+    system.add_player(20, 2, 2, 0, 0, false);
+    //Updates of the same player are coalesced, and every read sees them
+    print_status("update_player_stats(10, 1, 1, 0)", system.update_player_stats(10, 1, 1, 0));
+    print_status("update_player_stats(10, 1, 2, 1)", system.update_player_stats(10, 1, 2, 1));
+    print_status("update_player_stats(30, 1, 1, 0)", system.update_player_stats(30, 1, 1, 0));
+    print_status("update_player_stats(10, 0, 1, 0)", system.update_player_stats(10, 0, 1, 0));
+    print_output("get_num_played_games(10)", system.get_num_played_games(10));
+    print_output("get_top_scorer(-1)", system.get_top_scorer(-1));
+    print_status("update_player_stats(20, 1, 5, 0)", system.update_player_stats(20, 1, 5, 0));
+    print_output("get_top_scorer(2)", system.get_top_scorer(2));
+    //Held updates are applied before the teams are united and before a player is removed
+    print_status("update_player_stats(11, 1, 9, 0)", system.update_player_stats(11, 1, 9, 0));
+    print_status("unite_teams(1, 2, 3)", system.unite_teams(1, 2, 3));
+    print_output("get_top_scorer(3)", system.get_top_scorer(3));
+    print_status("update_player_stats(11, 1, 1, 0)", system.update_player_stats(11, 1, 1, 0));
+    print_status("remove_player(11)", system.remove_player(11));
+    print_output("get_top_scorer(-1)", system.get_top_scorer(-1));
+    print_status("update_player_stats(10, 1, 0, 0)", system.update_player_stats(10, 1, 0, 0));
+    print_status("set_update_buffer(0, 0)", system.set_update_buffer(0, 0));
+    print_output("get_num_played_games(10)", system.get_num_played_games(10));
+
+    //Random streams of commands with buffers of several sizes, with and without a time budget
+    const int limits[][2] = {{1, 0}, {3, 0}, {16, 0}, {1000, 0}, {16, 1}};
+    for (unsigned int seed = 1; seed <= 5; seed++) {
+        world_cup_t randomSystem;
+        Model model;
+        RandomStream stream(seed, 8, 120);
+        TEST_CHECK(randomSystem.set_update_buffer(limits[seed - 1][0], limits[seed - 1][1]) == StatusType::SUCCESS);
+        for (int i = 0; i < 1500; i++) {
+            TEST_CHECK(stream.step(randomSystem, model));
+            //Checking after every command would flush every update at once, so the buffer is left to fill up
+            if (stream.next(10) == 0) {
+                TEST_CHECK(check_stats(randomSystem, model));
+            }
+            if (stream.next(50) == 0) {
+                TEST_CHECK(randomSystem.flush_updates() == StatusType::SUCCESS);
+            }
+        }
+        TEST_CHECK(check_stats(randomSystem, model));
+    }
+    printf("random buffered updates: ok\n");
+    return 0;
+}
@@ -8,7 +8,22 @@ world_cup_t::world_cup_t() :
         m_teamsByID(),
         m_qualifiedTeams(),
         m_playersByID(),
-        m_playersByScore()
+        m_playersByScore(),
+        m_teamsByPoints(),
+        m_qualifiedByStrength(),
+        m_updateBuffer(),
+        m_inBatch(false),
+        m_topScorerDirty(false),
+        m_unlinkedTeams(),
+        m_frozenPlayers(),
+        m_frozenStale(false),
+        m_lock(),
+        m_indexLock(),
+        m_epochs(),
+        m_playersVersion(m_epochs),
+        m_teamsVersion(m_epochs),
+        m_snapshotReads(false),
+        m_pool()
 {}
 
 
@@ -26,13 +41,15 @@ world_cup_t::~world_cup_t()
 
 StatusType world_cup_t::add_team(int teamId, int points)
 {
+    WriteGuard guard(m_lock);
     if (teamId <= 0 || points < 0) {
         return StatusType::INVALID_INPUT;
     }
-    Team* newTeam;
+    Team* newTeam = nullptr;
     try  {
         newTeam = new Team(teamId, points);
         m_teamsByID.insert(newTeam, teamId);
+        link_team_stats(newTeam);
     }
     catch (const std::bad_alloc& e) {
         delete newTeam;
@@ -48,6 +65,7 @@ StatusType world_cup_t::add_team(int teamId, int points)
 
 StatusType world_cup_t::remove_team(int teamId)
 {
+    WriteGuard guard(m_lock);
     if (teamId <= 0) {
         return StatusType::INVALID_INPUT;
     }
@@ -56,6 +74,7 @@ StatusType world_cup_t::remove_team(int teamId)
         if (team->get_num_players()) {
             return StatusType::FAILURE;
         }
+        unlink_team_stats(team);
         m_teamsByID.remove(teamId);
 
         delete team;
@@ -76,35 +95,54 @@ StatusType world_cup_t::add_player(int playerId, int teamId, int gamesPlayed,
     if ((gamesPlayed == 0) && (goals > 0 || cards > 0)) {
         return StatusType::INVALID_INPUT;
     }
-    //Check if there already is a player with this ID.
-    //If not, then continue in "catch", otherwise return failure.
+    ReadGuard guard(m_lock, m_lock.lock_shared());
+    Team* tmpTeam;
+    //Check if there already is a team with this ID.
+    //If there is then continue after "catch", otherwise return failure.
     try {
-        m_playersByID.search_and_return_data(playerId);
+        tmpTeam = m_teamsByID.search_and_return_data(teamId);
     }
     catch (const NodeNotFound& e) {
-        Team* tmpTeam;
-        Player* tmpPlayer;
-        //Check if there already is a team with this ID.
-        //If there is then continue after "catch", otherwise return failure.
-        try {
-            tmpTeam = m_teamsByID.search_and_return_data(teamId);
-        }
-        catch (const NodeNotFound& e) {
+        return StatusType::FAILURE;
+    }
+    return add_team_player(tmpTeam, playerId, gamesPlayed, goals, cards, goalKeeper);
+}
+
+
+StatusType world_cup_t::add_team_player(Team* tmpTeam, int playerId, int gamesPlayed, int goals, int cards,
+                                        bool goalKeeper)
+{
+    const int teamId = tmpTeam->get_teamID();
+    Player* tmpPlayer;
+    std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+    //Check if there already is a player with this ID - if there is, return failure
+    {
+        ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+        if (m_playersByID.find_data(playerId) != nullptr) {
             return StatusType::FAILURE;
         }
-        //Calculate the number of games the player played
-        int playerGames = gamesPlayed - tmpTeam->get_games();
-        try {
-            //The inputs are okay - continue adding player:
-            tmpPlayer = new Player(playerId, playerGames, goals, cards, goalKeeper, tmpTeam);
-        }
-        catch (const std::bad_alloc& e) {
-            return StatusType::ALLOCATION_ERROR;
+    }
+    //Calculate the number of games the player played
+    int playerGames = gamesPlayed - tmpTeam->get_games();
+    try {
+        //The inputs are okay - continue adding player:
+        tmpPlayer = new Player(playerId, playerGames, goals, cards, goalKeeper, tmpTeam);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    {
+        WriteGuard indexGuard(m_indexLock);
+        //A player with this ID may have been added to another team since it was checked
+        if (m_playersByID.find_data(playerId) != nullptr) {
+            delete tmpPlayer;
+            return StatusType::FAILURE;
         }
         try {
             m_playersByID.insert(tmpPlayer, playerId);
             //Update top scorers
             m_playersByScore.insert(tmpPlayer, playerId, goals, cards);
+            update_version(m_playersVersion, true, playerId, goals, cards, playerId);
             try {
                 m_playersByScore.update_closest(playerId, goals, cards);
                 if (tmpPlayer->get_closest_left() != nullptr) {
@@ -117,8 +155,13 @@ StatusType world_cup_t::add_player(int playerId, int teamId, int gamesPlayed,
                 }
             }
             catch (const NodeNotFound& e) {}
-            m_overallTopScorer = m_playersByScore.search_and_return_max();
-            tmpTeam->add_player(tmpPlayer, playerId, goals, cards, goalKeeper);
+            update_top_scorer();
+            record_player_change(playerId, tmpPlayer);
+            unlink_team_stats(tmpTeam);
+            tmpTeam->begin_update();
+            tmpTeam->add_player_stats(goals, cards, goalKeeper);
+            tmpTeam->end_update();
+            link_team_stats(tmpTeam);
         }
         catch (const std::bad_alloc& e) {
             return StatusType::ALLOCATION_ERROR;
@@ -150,17 +193,28 @@ StatusType world_cup_t::add_player(int playerId, int teamId, int gamesPlayed,
         }
         //Add one to total num players (in entire game)
         m_totalNumPlayers++;
-        return StatusType::SUCCESS;
     }
-    return StatusType::FAILURE;
+    //The trees of the team are only read while holding the lock of the team, so m_indexLock is not needed here
+    try {
+        tmpTeam->insert_player(tmpPlayer, playerId, goals, cards);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
 }
 
 
 StatusType world_cup_t::remove_player(int playerId)
 {
+    WriteGuard guard(m_lock);
     if (playerId <= 0) {
         return StatusType::INVALID_INPUT;
     }
+    StatusType status = flush_updates();
+    if (status != StatusType::SUCCESS) {
+        return status;
+    }
     Player* tmpPlayer;
     try {
         tmpPlayer = m_playersByID.search_and_return_data(playerId);
@@ -172,14 +226,18 @@ StatusType world_cup_t::remove_player(int playerId)
     Team* tmpTeam = tmpPlayer->get_team();
     Player* closestLeft = tmpPlayer->get_closest_left();
     Player* closestRight = tmpPlayer->get_closest_right();
+    unlink_team_stats(tmpTeam);
     try {
         tmpTeam->remove_player(playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards(), tmpPlayer->get_goalkeeper());
         //Remove player from tree of all players
         m_playersByID.remove(playerId);
         //Remove player from overall game tree of players by score
         m_playersByScore.remove(playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards());
+        update_version(m_playersVersion, false, playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards(), playerId);
     }
     catch (const NodeNotFound& e) {}
+    record_player_change(playerId, nullptr);
+    link_team_stats(tmpTeam);
     try {
         //Remove team from tree of qualified teams
         if (!(tmpTeam->is_valid())) {
@@ -204,7 +262,7 @@ StatusType world_cup_t::remove_player(int playerId)
     tmpPlayer->update_closest_right(nullptr);
     tmpPlayer->update_closest_left(nullptr);
     //Change top scorer of all players and of team players
-    m_overallTopScorer = m_playersByScore.search_and_return_max();
+    update_top_scorer();
     tmpTeam->update_top_player();
     //Remove one from the counter of all players in game
     m_totalNumPlayers--;
@@ -219,6 +277,17 @@ StatusType world_cup_t::update_player_stats(int playerId, int gamesPlayed,
     if (playerId <= 0 || gamesPlayed < 0 || scoredGoals < 0 || cardsReceived < 0) {
         return StatusType::INVALID_INPUT;
     }
+    //Without the update buffer, only the team of the player is locked
+    {
+        ReadGuard guard(m_lock, m_lock.lock_shared());
+        if (!m_updateBuffer.is_enabled()) {
+            return update_team_player(playerId, gamesPlayed, scoredGoals, cardsReceived);
+        }
+    }
+    WriteGuard guard(m_lock);
+    if (!m_updateBuffer.is_enabled()) {
+        return update_team_player(playerId, gamesPlayed, scoredGoals, cardsReceived);
+    }
     Player* tmpPlayer;
     try {
         tmpPlayer = m_playersByID.search_and_return_data(playerId);
@@ -226,90 +295,228 @@ StatusType world_cup_t::update_player_stats(int playerId, int gamesPlayed,
     catch (const NodeNotFound& e) {
         return StatusType::FAILURE;
     }
-    //Pointer to the team the player plays in
-    Team* tmpTeam = tmpPlayer->get_team();
     try {
-        Player* closestLeftPrevious = tmpPlayer->get_closest_left();
-        Player* closestRightPrevious = tmpPlayer->get_closest_right();
-        tmpTeam->remove_player_by_score(playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards());
-        //Remove player from tree of all scorers
-        m_playersByScore.remove(playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards());
-        if (closestRightPrevious != nullptr) {
-            m_playersByScore.update_closest(closestRightPrevious->get_playerId(), closestRightPrevious->get_goals(), 
-                    closestRightPrevious->get_cards());
+        m_updateBuffer.add(tmpPlayer, gamesPlayed, scoredGoals, cardsReceived);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    if (m_updateBuffer.is_full()) {
+        return flush_updates();
+    }
+    return StatusType::SUCCESS;
+}
+
+
+StatusType world_cup_t::set_update_buffer(int maxPending, int maxDelayMs)
+{
+    WriteGuard guard(m_lock);
+    if (maxPending < 0 || maxDelayMs < 0) {
+        return StatusType::INVALID_INPUT;
+    }
+    //The updates held so far are applied under the previous limits
+    StatusType status = flush_updates();
+    m_updateBuffer.set_limits(maxPending, maxDelayMs);
+    return status;
+}
+
+
+StatusType world_cup_t::flush_updates()
+{
+    WriteGuard guard(m_lock);
+    int numDeltas = m_updateBuffer.get_size();
+    if (numDeltas == 0) {
+        return StatusType::SUCCESS;
+    }
+    //Everything the flush allocates is allocated before any team is unlinked - each delta may be of another team
+    PlayerDelta* deltas = nullptr;
+    Team** teams = nullptr;
+    Tree<GenericNode<Team*>, Team*>* updatedTeams = nullptr;
+    try {
+        deltas = new PlayerDelta[numDeltas];
+        teams = new Team*[numDeltas];
+        updatedTeams = new Tree<GenericNode<Team*>, Team*>();
+        m_updateBuffer.release(deltas);
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] deltas;
+        delete[] teams;
+        delete updatedTeams;
+        return StatusType::ALLOCATION_ERROR;
+    }
+    //Every team with updated players is unlinked once, before the first of its players is applied, and linked back
+    //once all of the updates were applied
+    StatusType status = StatusType::SUCCESS;
+    for (int i = 0; i < numDeltas; i++) {
+        Team* tmpTeam = deltas[i].m_player->get_team();
+        bool recorded = true;
+        if (updatedTeams->find_data(tmpTeam->get_teamID()) == nullptr) {
+            try {
+                updatedTeams->insert(tmpTeam, tmpTeam->get_teamID());
+            }
+            catch (const std::bad_alloc& e) {
+                recorded = false;
+                status = StatusType::ALLOCATION_ERROR;
+            }
+            unlink_team_stats(tmpTeam);
         }
-        if (closestLeftPrevious != nullptr) {
-            m_playersByScore.update_closest(closestLeftPrevious->get_playerId(), closestLeftPrevious->get_goals(), 
-                    closestLeftPrevious->get_cards());
+        const int previousGoals = deltas[i].m_player->get_goals();
+        const int previousCards = deltas[i].m_player->get_cards();
+        apply_player_stats(deltas[i].m_player, deltas[i].m_gamesPlayed, deltas[i].m_goals, deltas[i].m_cards);
+        reposition_team_player(deltas[i].m_player, previousGoals, previousCards);
+        tmpTeam->update_team_stats(deltas[i].m_goals, deltas[i].m_cards);
+        if (!recorded) {
+            //The team could not be recorded - link it back right away
+            link_team_stats(tmpTeam);
         }
-        tmpPlayer->update_closest_left(nullptr);
-        tmpPlayer->update_closest_right(nullptr);
     }
-    catch (const NodeNotFound& e) {}
+    delete[] deltas;
+    int numTeams = updatedTeams->get_size();
+    if (numTeams > 0) {
+        updatedTeams->m_node->unite_insert(teams, 0);
+        for (int i = 0; i < numTeams; i++) {
+            link_team_stats(teams[i]);
+        }
+    }
+    delete[] teams;
+    delete updatedTeams;
+    return status;
+}
+
+
+void world_cup_t::apply_player_stats(Player* tmpPlayer, int gamesPlayed, int scoredGoals, int cardsReceived)
+{
+    const int playerId = tmpPlayer->get_playerId();
+    const int previousGoals = tmpPlayer->get_goals();
+    const int previousCards = tmpPlayer->get_cards();
     tmpPlayer->update_gamesPlayed(gamesPlayed);
     tmpPlayer->update_cards(cardsReceived);
     tmpPlayer->update_goals(scoredGoals);
     try {
-        //Update overall game player by score tree and the overall game top scorer
-        m_playersByScore.insert(tmpPlayer, tmpPlayer->get_playerId(), tmpPlayer->get_goals(), tmpPlayer->get_cards());
-        //Update team - update the team players by score tree
-        tmpTeam->insert_player_by_score(tmpPlayer, playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards());
+        //Move the player within the tree of all scorers - the same nodes are reused, so nothing is allocated
+        if (m_playersByScore.reposition(playerId, previousGoals, previousCards, tmpPlayer->get_goals(),
+                                        tmpPlayer->get_cards())) {
+            //Link the previous closest players to each other, and the player to its new closest players
+            Player* closestLeftPrevious = tmpPlayer->get_closest_left();
+            Player* closestRightPrevious = tmpPlayer->get_closest_right();
+            if (closestRightPrevious != nullptr) {
+                closestRightPrevious->update_closest_left(closestLeftPrevious);
+            }
+            if (closestLeftPrevious != nullptr) {
+                closestLeftPrevious->update_closest_right(closestRightPrevious);
+            }
+            m_playersByScore.update_closest(playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards());
+            if (tmpPlayer->get_closest_right() != nullptr) {
+                tmpPlayer->get_closest_right()->update_closest_left(tmpPlayer);
+            }
+            if (tmpPlayer->get_closest_left() != nullptr) {
+                tmpPlayer->get_closest_left()->update_closest_right(tmpPlayer);
+            }
+            update_top_scorer();
+        }
     }
-    catch (const InvalidID& e) {}
-    catch (const std::bad_alloc& e) {
-        return StatusType::ALLOCATION_ERROR;
+    catch (const NodeNotFound& e) {}
+    if (tmpPlayer->get_goals() != previousGoals || tmpPlayer->get_cards() != previousCards) {
+        update_version(m_playersVersion, false, playerId, previousGoals, previousCards, playerId);
+        update_version(m_playersVersion, true, playerId, tmpPlayer->get_goals(), tmpPlayer->get_cards(), playerId);
     }
-    m_overallTopScorer = m_playersByScore.search_and_return_max();
-    //Update the teams total stats and the top scored player of the team
-    tmpTeam->update_team_stats(scoredGoals, cardsReceived);
-    try {
-        m_playersByScore.update_closest(tmpPlayer->get_playerId(), tmpPlayer->get_goals(), tmpPlayer->get_cards());
-        Player* closestLeft = tmpPlayer->get_closest_left();
-        Player* closestRight = tmpPlayer->get_closest_right();
-        if (closestRight != nullptr) {
-            m_playersByScore.update_closest(closestRight->get_playerId(), closestRight->get_goals(), 
-                    closestRight->get_cards());
-        }
-        if (closestLeft != nullptr) {
-            m_playersByScore.update_closest(closestLeft->get_playerId(), closestLeft->get_goals(), 
-                    closestLeft->get_cards());
+    record_player_change(playerId, tmpPlayer);
+}
+
+
+StatusType world_cup_t::update_team_player(int playerId, int gamesPlayed, int scoredGoals, int cardsReceived)
+{
+    Player* tmpPlayer;
+    {
+        ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+        Player** found = m_playersByID.find_data(playerId);
+        if (found == nullptr) {
+            return StatusType::FAILURE;
         }
+        tmpPlayer = *found;
     }
-    catch (const NodeNotFound& e) {}
+    //Pointer to the team the player plays in - players only move between teams while m_lock is held for writing
+    Team* tmpTeam = tmpPlayer->get_team();
+    std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+    const int previousGoals = tmpPlayer->get_goals();
+    const int previousCards = tmpPlayer->get_cards();
+    {
+        WriteGuard indexGuard(m_indexLock);
+        apply_player_stats(tmpPlayer, gamesPlayed, scoredGoals, cardsReceived);
+        //Update the teams total stats
+        unlink_team_stats(tmpTeam);
+        tmpTeam->update_team_stats(scoredGoals, cardsReceived);
+        link_team_stats(tmpTeam);
+    }
+    //Update team - move the player within the team players by score tree
+    reposition_team_player(tmpPlayer, previousGoals, previousCards);
     return StatusType::SUCCESS;
 }
 
 
+void world_cup_t::reposition_team_player(Player* tmpPlayer, int previousGoals, int previousCards)
+{
+    try {
+        tmpPlayer->get_team()->reposition_player_by_score(tmpPlayer, previousGoals, previousCards);
+    }
+    catch (const NodeNotFound& e) {}
+}
+
+
 StatusType world_cup_t::play_match(int teamId1, int teamId2)
 {
+    ReadGuard guard(m_lock, lock_for_read());
     if (teamId1 == teamId2 || teamId1 <= 0 || teamId2 <= 0) {
         return StatusType::INVALID_INPUT;
     }
     Team* team1;
     Team* team2;
     //Search for the teams in the qualified teams tree. If they're not there, they cannot play - return failure.
-    try {
-        team1 = m_qualifiedTeams.search_and_return_data(teamId1);
-        team2 = m_qualifiedTeams.search_and_return_data(teamId2);
-    }
-    catch (const NodeNotFound& e) {
-        return StatusType::FAILURE;
+    //Qualified teams stay qualified until m_lock is held for writing
+    {
+        ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+        try {
+            team1 = m_qualifiedTeams.search_and_return_data(teamId1);
+            team2 = m_qualifiedTeams.search_and_return_data(teamId2);
+        }
+        catch (const NodeNotFound& e) {
+            return StatusType::FAILURE;
+        }
     }
+    return play_team_match(team1, team2);
+}
+
+
+StatusType world_cup_t::play_team_match(Team* team1, Team* team2)
+{
+    const int teamId1 = team1->get_teamID();
+    const int teamId2 = team2->get_teamID();
+    //The teams are locked in the order of their ID's, so matches sharing teams never wait for each other in a cycle
+    std::lock_guard<std::mutex> firstGuard((teamId1 < teamId2) ? team1->get_lock() : team2->get_lock());
+    std::lock_guard<std::mutex> secondGuard((teamId1 < teamId2) ? team2->get_lock() : team1->get_lock());
+    WriteGuard indexGuard(m_indexLock);
+    unlink_team_stats(team1);
+    unlink_team_stats(team2);
+    team1->begin_update();
+    team2->begin_update();
     this->compete(*team1, *team2);
+    team1->end_update();
+    team2->end_update();
+    link_team_stats(team1);
+    link_team_stats(team2);
     return StatusType::SUCCESS;
 }
 
 
 output_t<int> world_cup_t::get_num_played_games(int playerId)
 {
+    ReadGuard guard(m_lock, lock_for_read());
     if (playerId <= 0) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
-    Player* tmpPlayer;
-    try {
-        tmpPlayer = m_playersByID.search_and_return_data(playerId);
-    }
-    catch (const NodeNotFound& e) {
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    Player* tmpPlayer = find_player(playerId);
+    if (tmpPlayer == nullptr) {
         return output_t<int>(StatusType::FAILURE);
     }
     //Extract the total games played by the player - their personal played games + the total team games
@@ -320,6 +527,8 @@ output_t<int> world_cup_t::get_num_played_games(int playerId)
 
 output_t<int> world_cup_t::get_team_points(int teamId)
 {
+    //The counters do not depend on the held updates, the top scorer or the frozen players, so none of them is applied
+    ReadGuard guard(m_lock, m_lock.lock_shared());
     if (teamId <= 0) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
@@ -330,15 +539,21 @@ output_t<int> world_cup_t::get_team_points(int teamId)
     catch (const NodeNotFound& e) {
         return output_t<int>(StatusType::FAILURE);
     }
-    return output_t<int>(tmpTeam->get_points());
+    //The counters of the team are read without its lock, so the query does not wait for a match of the team
+    return output_t<int>(tmpTeam->get_counters().m_points);
 }
 
 
 StatusType world_cup_t::unite_teams(int teamId1, int teamId2, int newTeamId)
 {
+    WriteGuard guard(m_lock);
     if (teamId1 == teamId2 || newTeamId <= 0 || teamId1 <= 0 || teamId2 <= 0) {
         return StatusType::INVALID_INPUT;
     }
+    StatusType status = flush_updates();
+    if (status != StatusType::SUCCESS) {
+        return status;
+    }
     //Search for the new team in the tree. If it's already there and is not equal to team1 or team2, return failure.
     bool alreadyExists = true;
     try {
@@ -374,9 +589,11 @@ StatusType world_cup_t::unite_teams(int teamId1, int teamId2, int newTeamId)
     catch (const std::bad_alloc& e) {
         return StatusType::ALLOCATION_ERROR;
     }
-    nTeam->Team::unite_teams(team1, team2);
+    nTeam->Team::unite_teams(team1, team2, m_pool);
     nTeam->update_team_id(nTeam);
     //Remove the old teams from the appropriate places. Change the closest pointers accordingly.
+    unlink_team_stats(team1);
+    unlink_team_stats(team2);
     try {
         m_qualifiedTeams.remove(teamId1);
         if (team1->get_closest_left() != nullptr) {
@@ -406,6 +623,7 @@ StatusType world_cup_t::unite_teams(int teamId1, int teamId2, int newTeamId)
     //Insert the new team into the appropriate trees. Update the closest pointers accordingly.
     try {
         m_teamsByID.insert(nTeam, newTeamId);
+        link_team_stats(nTeam);
     }
     catch (const std::bad_alloc& e) {
         return StatusType::ALLOCATION_ERROR;
@@ -433,6 +651,7 @@ StatusType world_cup_t::unite_teams(int teamId1, int teamId2, int newTeamId)
 
 output_t<int> world_cup_t::get_top_scorer(int teamId)
 {
+    ReadGuard guard(m_lock, lock_for_read());
     if (teamId == 0) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
@@ -448,17 +667,21 @@ output_t<int> world_cup_t::get_top_scorer(int teamId)
         catch (const NodeNotFound& e) {
             return outputFailure;
         }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
         if (tmpTeam->get_num_players() == 0) {
             return outputFailure;
         }
         return output_t<int>(tmpTeam->get_top_scorer()->get_playerId());
     }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
     return output_t<int>(m_overallTopScorer->get_playerId());
 }
 
 
 output_t<int> world_cup_t::get_all_players_count(int teamId)
 {
+    //The counters do not depend on the held updates, the top scorer or the frozen players, so none of them is applied
+    ReadGuard guard(m_lock, m_lock.lock_shared());
     if (teamId == 0) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
@@ -470,7 +693,7 @@ output_t<int> world_cup_t::get_all_players_count(int teamId)
         catch (const NodeNotFound& e) {
             return output_t<int>(StatusType::FAILURE);
         }
-        return output_t<int>(tmpTeam->get_num_players());
+        return output_t<int>(tmpTeam->get_counters().m_players);
     }
     return output_t<int>(m_totalNumPlayers);
 }
@@ -478,6 +701,7 @@ output_t<int> world_cup_t::get_all_players_count(int teamId)
 
 StatusType world_cup_t::get_all_players(int teamId, int *const output)
 {
+    ReadGuard guard(m_lock, lock_for_read());
     if (output == nullptr || teamId == 0) {
         return StatusType::INVALID_INPUT;
     }
@@ -494,21 +718,37 @@ StatusType world_cup_t::get_all_players(int teamId, int *const output)
         catch (const NodeNotFound& e) {
             return StatusType::FAILURE;
         }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
         if (tmpTeam-> get_num_players() == 0) {
             return StatusType::FAILURE;
         }
         //Get all the players of the specified team
-        tmpTeam->get_all_team_players(output);
+        tmpTeam->get_all_team_players(output, &m_pool);
         return StatusType::SUCCESS;
     }
-    //If the total players of the games is requested
-    m_playersByScore.get_all_data(output);
+    //If the total players of the games is requested - a published version of the players is walked without any
+    //lock, so writers continue while the players are written out
+    if (m_snapshotReads) {
+        EpochGuard epochGuard(m_epochs);
+        if (publish_versions()) {
+            const VersionedTree<int>::VersionNode* root = m_playersVersion.get_published();
+            guard.release();
+            VersionedTree<int>::get_all_ids(root, output);
+            return StatusType::SUCCESS;
+        }
+    }
+    //The frozen snapshot holds their order if none of them changed
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    if (!m_frozenPlayers.is_enabled() || !m_frozenPlayers.get_score_order(output)) {
+        m_playersByScore.get_all_data(output, &m_pool);
+    }
     return StatusType::SUCCESS;
 }
 
 
 output_t<int> world_cup_t::get_closest_player(int playerId, int teamId)
 {
+    ReadGuard guard(m_lock, lock_for_read());
     if (playerId <= 0 || teamId <= 0) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
@@ -524,6 +764,9 @@ output_t<int> world_cup_t::get_closest_player(int playerId, int teamId)
     catch (const NodeNotFound& e) {
         return outputFailure;
     }
+    //The closest players are linked across the teams
+    std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
     int closestPlayerId = 0;
     //Get the closest team player
     try {
@@ -541,29 +784,67 @@ output_t<int> world_cup_t::get_closest_player(int playerId, int teamId)
 
 output_t<int> world_cup_t::knockout_winner(int minTeamId, int maxTeamId)
 {
+    ReadGuard guard(m_lock, lock_for_read());
     if (maxTeamId < 0 || minTeamId < 0 || maxTeamId < minTeamId) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
-    if (m_qualifiedTeams.m_node->get_height() < 0) {
-        return output_t<int>(StatusType::FAILURE);
-    }
-    //Find number of teams invovled
-    int num = m_qualifiedTeams.m_node->numOfTeams(minTeamId, maxTeamId);
-    //If there are no qualified teams, return failure
-    if (num == 0) {
-        return output_t<int>(StatusType::FAILURE);
-    }
-    //Create an array for the qualified teams in the range
+    //The matches are played by copies of the teams - taken from a published version of the qualified teams when
+    //snapshot reads are enabled, and otherwise from stats that only change while holding m_indexLock
+    int num = 0;
     Team* teams = nullptr;
-    try {
-        teams = new Team[num*sizeof(Team)];
+    if (m_snapshotReads) {
+        EpochGuard epochGuard(m_epochs);
+        if (publish_versions()) {
+            const VersionedTree<int>::VersionNode* root = m_teamsVersion.get_published();
+            guard.release();
+            num = VersionedTree<int>::count_range(root, minTeamId, maxTeamId);
+            if (num == 0) {
+                return output_t<int>(StatusType::FAILURE);
+            }
+            int* ids = nullptr;
+            int* strengths = nullptr;
+            try {
+                ids = new int[num];
+                strengths = new int[num];
+                teams = new Team[num];
+            }
+            catch (const std::bad_alloc& e) {
+                delete[] ids;
+                delete[] strengths;
+                return output_t<int>(StatusType::ALLOCATION_ERROR);
+            }
+            VersionedTree<int>::get_range(root, minTeamId, maxTeamId, ids, strengths);
+            //Matches only compare and add up the strengths of the teams, so a copy holding its strength as its
+            //points plays the same as a copy of all of its stats
+            for (int i = 0; i < num; i++) {
+                teams[i] = Team(ids[i], strengths[i]);
+            }
+            delete[] ids;
+            delete[] strengths;
+        }
     }
-    catch (const std::bad_alloc& e) {
-        delete[] teams;
-        return output_t<int>(StatusType::ALLOCATION_ERROR);
+    if (teams == nullptr) {
+        ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+        if (m_qualifiedTeams.m_node->get_height() < 0) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        //Find number of teams invovled
+        num = m_qualifiedTeams.m_node->numOfTeams(minTeamId, maxTeamId);
+        //If there are no qualified teams, return failure
+        if (num == 0) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        //Create an array for the qualified teams in the range
+        try {
+            teams = new Team[num];
+        }
+        catch (const std::bad_alloc& e) {
+            delete[] teams;
+            return output_t<int>(StatusType::ALLOCATION_ERROR);
+        }
+        //Fill in teams according to their order
+        m_qualifiedTeams.m_node->addTeams(teams, minTeamId, maxTeamId);
     }
-    //Fill in teams according to their order
-    m_qualifiedTeams.m_node->addTeams(teams, minTeamId, maxTeamId);
     for (int i = 0; i < num-1; i++) {
         (teams+i)->update_closest_right(teams+i+1);
         (teams+i+1)->update_closest_left(teams+i);
@@ -587,76 +868,1173 @@ output_t<int> world_cup_t::knockout_winner(int minTeamId, int maxTeamId)
 }
 
 
-//-------------------------------------------Helper Functions----------------------------------------------
+//-------------------------------------------Team Standings----------------------------------------------
 
-int world_cup_t::compete(Team& team1, Team& team2) {
-    int point1 = team1.get_points() + team1.get_goals() - team1.get_cards();\
-    int point2 = team2.get_points() + team2.get_goals() - team2.get_cards();
-    int winnerID = 0;
-    if (point1 > point2) {
-        team1.update_points_won();
-        winnerID = team1.get_teamID();
+output_t<int> world_cup_t::get_top_teams_by_points(int amount, int *const output)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (amount <= 0 || output == nullptr) {
+        return output_t<int>(StatusType::INVALID_INPUT);
     }
-    else if (point1 == point2) {
-        team1.update_points_tie();
-        team2.update_points_tie();
-        winnerID = 0; //a tie - b/c no team id is equal to 0
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    if (m_teamsByPoints.get_size() == 0) {
+        return output_t<int>(StatusType::FAILURE);
     }
-    else {
-        team2.update_points_won();
-        winnerID = team2.get_teamID();
+    return output_t<int>(m_teamsByPoints.get_top_data(output, amount));
+}
+
+
+output_t<int> world_cup_t::get_strongest_teams(int amount, int *const output)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (amount <= 0 || output == nullptr) {
+        return output_t<int>(StatusType::INVALID_INPUT);
     }
-    team1.add_game();
-    team2.add_game();
-    return winnerID;
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    if (m_qualifiedByStrength.get_size() == 0) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(m_qualifiedByStrength.get_top_data(output, amount));
 }
 
 
-Team* world_cup_t::knockout_games(Team* teams) {
-    //If there is only one team in the array, return
-    if (teams->get_closest_right() == nullptr) {
-        return teams;
+output_t<int> world_cup_t::get_team_points_rank(int teamId)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (teamId <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
     }
-    //Find the first pair of the array
-    Team* second = teams->get_closest_right();
-    //If there are more teams in the array, call the function recursively in order to find the next pair
-    if (second->get_closest_right() != nullptr) {
-        knockout_games(second->get_closest_right());
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    Team* tmpTeam;
+    try {
+        tmpTeam = m_teamsByID.search_and_return_data(teamId);
     }
-    //Play the match between the pair of teams found
-    int winnerID = compete(*teams, *second);
-    //Unite the teams according to who won and lost
-    if (winnerID == teams->get_teamID()) {
-        teams->knockout_unite(*teams, *second);
-        teams->update_closest_right(second->get_closest_right());
-        if (second->get_closest_right() != nullptr) {
-            second->get_closest_right()->update_closest_left(teams);
-        }
+    catch (const NodeNotFound& e) {
+        return output_t<int>(StatusType::FAILURE);
     }
-    else if (winnerID == second->get_teamID()) {
-        teams->knockout_unite(*second, *teams);
-        second->update_closest_left(teams->get_closest_left());
-        if (teams->get_closest_left() != nullptr) {
-            teams->get_closest_left()->update_closest_right(second);
-        }
-        teams = second;
+    return output_t<int>(m_teamsByPoints.get_rank(teamId, tmpTeam->get_points(), 0));
+}
+
+
+output_t<int> world_cup_t::get_team_strength_rank(int teamId)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (teamId <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
     }
-    else {
-        if (teams->get_teamID() > second->get_teamID()) {
-            teams->knockout_unite(*teams, *second);
-            teams->update_closest_right(second->get_closest_right());
-            if (second->get_closest_right() != nullptr) {
-                second->get_closest_right()->update_closest_left(teams);
-            }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    Team* tmpTeam;
+    try {
+        tmpTeam = m_qualifiedTeams.search_and_return_data(teamId);
+    }
+    catch (const NodeNotFound& e) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(m_qualifiedByStrength.get_rank(teamId, tmpTeam->get_strength(), 0));
+}
+
+
+//-------------------------------------------Team Summaries----------------------------------------------
+
+output_t<int> world_cup_t::get_teams_summary(int minTeamId, int maxTeamId, TeamStat stat, SummaryType type)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (maxTeamId < 0 || minTeamId < 0 || maxTeamId < minTeamId) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    TeamSummary summary = m_teamsByID.m_node->summarize_range(minTeamId, maxTeamId);
+    //The minimum and maximum of an empty range are undefined
+    if (summary.get_count() == 0) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(summary.get(stat, type));
+}
+
+
+//-------------------------------------------Top Scorers----------------------------------------------
+
+output_t<int> world_cup_t::get_top_scorers(int teamId, int amount, int *const output)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (teamId == 0 || amount <= 0 || output == nullptr) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    output_t<int> outputFailure(StatusType::FAILURE);
+    if (m_totalNumPlayers == 0) {
+        return outputFailure;
+    }
+    if (teamId > 0) {
+        Team* tmpTeam;
+        try {
+            tmpTeam = m_teamsByID.search_and_return_data(teamId);
         }
-        else {
-            teams->knockout_unite(*second, *teams);
-            second->update_closest_left(teams->get_closest_left());
-            if (teams->get_closest_left() != nullptr) {
-                teams->get_closest_left()->update_closest_right(second);
-            }
-            teams = second;
+        catch (const NodeNotFound& e) {
+            return outputFailure;
+        }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+        if (tmpTeam->get_num_players() == 0) {
+            return outputFailure;
+        }
+        return output_t<int>(tmpTeam->get_top_team_scorers(output, amount));
+    }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    return output_t<int>(m_playersByScore.get_top_data(output, amount));
+}
+
+
+//-------------------------------------------Player Range Queries----------------------------------------------
+
+output_t<int> world_cup_t::count_players_by_goals(int teamId, int minGoals, int maxGoals)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (teamId == 0 || minGoals < 0 || maxGoals < minGoals) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    if (teamId > 0) {
+        Team* tmpTeam;
+        try {
+            tmpTeam = m_teamsByID.search_and_return_data(teamId);
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+        return output_t<int>(tmpTeam->count_players_by_goals(minGoals, maxGoals));
+    }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    return output_t<int>(m_playersByScore.count_goals_range(minGoals, maxGoals));
+}
+
+
+output_t<int> world_cup_t::get_players_by_goals(int teamId, int minGoals, int maxGoals, int *const output)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (output == nullptr || teamId == 0 || minGoals < 0 || maxGoals < minGoals) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    if (teamId > 0) {
+        Team* tmpTeam;
+        try {
+            tmpTeam = m_teamsByID.search_and_return_data(teamId);
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+        return output_t<int>(tmpTeam->get_players_by_goals(output, minGoals, maxGoals));
+    }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    return output_t<int>(m_playersByScore.get_goals_range(output, minGoals, maxGoals));
+}
+
+
+output_t<int> world_cup_t::count_players_by_cards(int teamId, int cards)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (teamId == 0 || cards < 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    if (teamId > 0) {
+        Team* tmpTeam;
+        try {
+            tmpTeam = m_teamsByID.search_and_return_data(teamId);
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+        return output_t<int>(tmpTeam->count_players_by_cards(cards));
+    }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    return output_t<int>(m_playersByScore.count_above_cards(cards));
+}
+
+
+output_t<int> world_cup_t::get_players_by_cards(int teamId, int cards, int *const output)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (output == nullptr || teamId == 0 || cards < 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    if (teamId > 0) {
+        Team* tmpTeam;
+        try {
+            tmpTeam = m_teamsByID.search_and_return_data(teamId);
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+        return output_t<int>(tmpTeam->get_players_by_cards(output, cards));
+    }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    return output_t<int>(m_playersByScore.get_above_cards(output, cards));
+}
+
+
+output_t<int> world_cup_t::get_players_chunk(int teamId, PlayerCursor& cursor, int *const output, int capacity)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (output == nullptr || teamId == 0 || capacity <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    if (teamId > 0) {
+        Team* tmpTeam;
+        try {
+            tmpTeam = m_teamsByID.search_and_return_data(teamId);
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+        return output_t<int>(tmpTeam->get_players_after(output, capacity, cursor.m_goals, cursor.m_cards,
+                                                        cursor.m_id));
+    }
+    ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+    return output_t<int>(m_playersByScore.get_data_after(output, capacity, cursor.m_goals, cursor.m_cards,
+                                                         cursor.m_id));
+}
+
+
+//---------------------------------------------Closest Players------------------------------------------------
+
+output_t<int> world_cup_t::get_closest_players(int playerId, int teamId, int amount, int *const output)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (output == nullptr || playerId <= 0 || teamId == 0 || amount <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    int numFound = 0;
+    try {
+        if (teamId > 0) {
+            Team* tmpTeam = m_teamsByID.search_and_return_data(teamId);
+            std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+            numFound = tmpTeam->get_closest_team_players(output, amount, playerId);
+        }
+        else {
+            ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+            Player* tmpPlayer = find_player(playerId);
+            if (tmpPlayer == nullptr) {
+                return output_t<int>(StatusType::FAILURE);
+            }
+            numFound = m_playersByScore.get_closest_data(output, amount, tmpPlayer->get_goals(),
+                                                         tmpPlayer->get_cards(), playerId);
+        }
+    }
+    catch (const NodeNotFound& e) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    //If the player is the only one in the searched players, return failure
+    if (numFound == 0) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(numFound);
+}
+
+
+output_t<int> world_cup_t::get_closest_to_profile(int goals, int cards, int teamId, int amount, int *const output)
+{
+    ReadGuard guard(m_lock, lock_for_read());
+    if (output == nullptr || goals < 0 || cards < 0 || teamId == 0 || amount <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    int numFound = 0;
+    if (teamId > 0) {
+        Team* tmpTeam;
+        try {
+            tmpTeam = m_teamsByID.search_and_return_data(teamId);
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
+        std::lock_guard<std::mutex> teamGuard(tmpTeam->get_lock());
+        numFound = tmpTeam->get_closest_team_players(output, amount, goals, cards);
+    }
+    else {
+        ReadGuard indexGuard(m_indexLock, m_indexLock.lock_shared());
+        numFound = m_playersByScore.get_closest_data(output, amount, goals, cards, 0);
+    }
+    if (numFound == 0) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(numFound);
+}
+
+
+//---------------------------------------------Batch of Commands----------------------------------------------
+
+StatusType world_cup_t::apply_batch(const Command* commands, size_t numCommands, Result* results)
+{
+    WriteGuard guard(m_lock);
+    if (commands == nullptr || results == nullptr) {
+        return StatusType::INVALID_INPUT;
+    }
+    //Check all of the commands first - invalid commands are not run at all
+    for (size_t i = 0; i < numCommands; i++) {
+        if (is_valid_command(commands[i])) {
+            results[i].m_status = StatusType::SUCCESS;
+        }
+        else {
+            results[i].m_status = StatusType::INVALID_INPUT;
+        }
+        results[i].m_value = 0;
+    }
+    Tree<GenericNode<Team*>, Team*> batchTeams;
+    try {
+        find_batch_teams(commands, numCommands, results, batchTeams);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    m_inBatch = true;
+    for (size_t i = 0; i < numCommands; i++) {
+        if (results[i].m_status == StatusType::SUCCESS) {
+            apply_batch_command(commands[i], batchTeams, results[i]);
+        }
+    }
+    link_batch_teams();
+    m_inBatch = false;
+    refresh_top_scorer();
+    return StatusType::SUCCESS;
+}
+
+
+bool world_cup_t::is_valid_command(const Command& command)
+{
+    const int* args = command.m_args;
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+            return args[0] > 0 && args[1] >= 0;
+        case CommandType::ADD_PLAYER:
+            if (args[0] <= 0 || args[1] <= 0 || args[2] < 0 || args[3] < 0 || args[4] < 0) {
+                return false;
+            }
+            return args[2] > 0 || (args[3] == 0 && args[4] == 0);
+        case CommandType::UPDATE_PLAYER_STATS:
+            return args[0] > 0 && args[1] >= 0 && args[2] >= 0 && args[3] >= 0;
+        case CommandType::PLAY_MATCH:
+            return args[0] != args[1] && args[0] > 0 && args[1] > 0;
+        case CommandType::UNITE_TEAMS:
+            return args[0] != args[1] && args[2] > 0 && args[0] > 0 && args[1] > 0;
+        case CommandType::REMOVE_TEAM:
+        case CommandType::REMOVE_PLAYER:
+        case CommandType::GET_NUM_PLAYED_GAMES:
+        case CommandType::GET_TEAM_POINTS:
+            return args[0] > 0;
+        case CommandType::GET_TOP_SCORER:
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+            return args[0] != 0;
+        case CommandType::GET_ALL_PLAYERS:
+            return args[0] != 0 && command.m_output != nullptr;
+        case CommandType::GET_CLOSEST_PLAYER:
+            return args[0] > 0 && args[1] > 0;
+        case CommandType::KNOCKOUT_WINNER:
+            return args[0] >= 0 && args[1] >= 0 && args[1] >= args[0];
+    }
+    return false;
+}
+
+
+int world_cup_t::get_command_teams(const Command& command, int* teamIds)
+{
+    const int* args = command.m_args;
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+        case CommandType::REMOVE_TEAM:
+        case CommandType::GET_TEAM_POINTS:
+            teamIds[0] = args[0];
+            return 1;
+        case CommandType::ADD_PLAYER:
+        case CommandType::GET_CLOSEST_PLAYER:
+            teamIds[0] = args[1];
+            return 1;
+        case CommandType::PLAY_MATCH:
+            teamIds[0] = args[0];
+            teamIds[1] = args[1];
+            return 2;
+        case CommandType::UNITE_TEAMS:
+            teamIds[0] = args[0];
+            teamIds[1] = args[1];
+            teamIds[2] = args[2];
+            return 3;
+        case CommandType::GET_TOP_SCORER:
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+        case CommandType::GET_ALL_PLAYERS:
+            //A negative ID stands for all of the players, not for a team
+            if (args[0] > 0) {
+                teamIds[0] = args[0];
+                return 1;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+
+void world_cup_t::find_batch_teams(const Command* commands, size_t numCommands, const Result* results,
+                                   Tree<GenericNode<Team*>, Team*>& batchTeams)
+{
+    int teamIds[3];
+    for (size_t i = 0; i < numCommands; i++) {
+        if (results[i].m_status != StatusType::SUCCESS) {
+            continue;
+        }
+        int numTeams = get_command_teams(commands[i], teamIds);
+        for (int j = 0; j < numTeams; j++) {
+            if (batchTeams.find_data(teamIds[j]) != nullptr) {
+                continue;
+            }
+            Team** found = m_teamsByID.find_data(teamIds[j]);
+            batchTeams.insert((found != nullptr) ? *found : nullptr, teamIds[j]);
+        }
+    }
+}
+
+
+void world_cup_t::refresh_batch_teams(const Command& command, Tree<GenericNode<Team*>, Team*>& batchTeams)
+{
+    int teamIds[3];
+    int numTeams = get_command_teams(command, teamIds);
+    for (int i = 0; i < numTeams; i++) {
+        Team** found = m_teamsByID.find_data(teamIds[i]);
+        *batchTeams.find_data(teamIds[i]) = (found != nullptr) ? *found : nullptr;
+    }
+}
+
+
+void world_cup_t::apply_batch_command(const Command& command, Tree<GenericNode<Team*>, Team*>& batchTeams,
+                                      Result& result)
+{
+    const int* args = command.m_args;
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+            if (*batchTeams.find_data(args[0]) != nullptr) {
+                result.m_status = StatusType::FAILURE;
+                return;
+            }
+            apply_command(command, result);
+            refresh_batch_teams(command, batchTeams);
+            return;
+        case CommandType::REMOVE_TEAM:
+        case CommandType::UNITE_TEAMS:
+            //The teams these remove must not wait in m_unlinkedTeams - the held updates are applied first, since
+            //applying them unlinks the teams of the updated players again
+            flush_updates();
+            link_batch_teams();
+            apply_command(command, result);
+            refresh_batch_teams(command, batchTeams);
+            return;
+        case CommandType::KNOCKOUT_WINNER:
+            //The knockout reads the qualified teams by strength
+            flush_updates();
+            link_batch_teams();
+            apply_command(command, result);
+            return;
+        case CommandType::ADD_PLAYER: {
+            Team* team = *batchTeams.find_data(args[1]);
+            if (team == nullptr || m_playersByID.find_data(args[0]) != nullptr) {
+                result.m_status = StatusType::FAILURE;
+                return;
+            }
+            result.m_status = add_team_player(team, args[0], args[2], args[3], args[4], command.m_flag);
+            return;
+        }
+        case CommandType::PLAY_MATCH: {
+            Team* team1 = *batchTeams.find_data(args[0]);
+            Team* team2 = *batchTeams.find_data(args[1]);
+            //A team is in m_qualifiedTeams exactly while it is valid
+            if (team1 == nullptr || team2 == nullptr || !team1->is_valid() || !team2->is_valid()) {
+                result.m_status = StatusType::FAILURE;
+                return;
+            }
+            //The strength of the teams includes the held updates of their players
+            flush_updates();
+            result.m_status = play_team_match(team1, team2);
+            return;
+        }
+        case CommandType::GET_TEAM_POINTS: {
+            Team* team = *batchTeams.find_data(args[0]);
+            if (team == nullptr) {
+                result.m_status = StatusType::FAILURE;
+                return;
+            }
+            result.m_value = team->get_counters().m_points;
+            return;
+        }
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+            if (args[0] > 0) {
+                Team* team = *batchTeams.find_data(args[0]);
+                if (team == nullptr) {
+                    result.m_status = StatusType::FAILURE;
+                    return;
+                }
+                result.m_value = team->get_counters().m_players;
+                return;
+            }
+            apply_command(command, result);
+            return;
+        case CommandType::GET_TOP_SCORER:
+        case CommandType::GET_ALL_PLAYERS:
+        case CommandType::GET_CLOSEST_PLAYER: {
+            int teamId = (command.m_type == CommandType::GET_CLOSEST_PLAYER) ? args[1] : args[0];
+            if (teamId > 0 && *batchTeams.find_data(teamId) == nullptr) {
+                result.m_status = StatusType::FAILURE;
+                return;
+            }
+            apply_command(command, result);
+            return;
+        }
+        default:
+            if (fails_lookup(command)) {
+                result.m_status = StatusType::FAILURE;
+                return;
+            }
+            apply_command(command, result);
+            return;
+    }
+}
+
+
+bool world_cup_t::fails_lookup(const Command& command) const
+{
+    switch (command.m_type) {
+        case CommandType::REMOVE_PLAYER:
+        case CommandType::UPDATE_PLAYER_STATS:
+        case CommandType::GET_NUM_PLAYED_GAMES:
+            return m_playersByID.find_data(command.m_args[0]) == nullptr;
+        default:
+            return false;
+    }
+}
+
+
+void world_cup_t::apply_command(const Command& command, Result& result)
+{
+    const int* args = command.m_args;
+    switch (command.m_type) {
+        case CommandType::ADD_TEAM:
+            result.m_status = add_team(args[0], args[1]);
+            return;
+        case CommandType::REMOVE_TEAM:
+            result.m_status = remove_team(args[0]);
+            return;
+        case CommandType::ADD_PLAYER:
+            result.m_status = add_player(args[0], args[1], args[2], args[3], args[4], command.m_flag);
+            return;
+        case CommandType::REMOVE_PLAYER:
+            result.m_status = remove_player(args[0]);
+            return;
+        case CommandType::UPDATE_PLAYER_STATS:
+            result.m_status = update_player_stats(args[0], args[1], args[2], args[3]);
+            return;
+        case CommandType::PLAY_MATCH:
+            result.m_status = play_match(args[0], args[1]);
+            return;
+        case CommandType::UNITE_TEAMS:
+            result.m_status = unite_teams(args[0], args[1], args[2]);
+            return;
+        case CommandType::GET_ALL_PLAYERS:
+            result.m_status = get_all_players(args[0], command.m_output);
+            return;
+        case CommandType::GET_NUM_PLAYED_GAMES:
+            store_output(get_num_played_games(args[0]), result);
+            return;
+        case CommandType::GET_TEAM_POINTS:
+            store_output(get_team_points(args[0]), result);
+            return;
+        case CommandType::GET_TOP_SCORER:
+            store_output(get_top_scorer(args[0]), result);
+            return;
+        case CommandType::GET_ALL_PLAYERS_COUNT:
+            store_output(get_all_players_count(args[0]), result);
+            return;
+        case CommandType::GET_CLOSEST_PLAYER:
+            store_output(get_closest_player(args[0], args[1]), result);
+            return;
+        case CommandType::KNOCKOUT_WINNER:
+            store_output(knockout_winner(args[0], args[1]), result);
+            return;
+    }
+}
+
+
+void world_cup_t::store_output(output_t<int> output, Result& result)
+{
+    result.m_status = output.status();
+    result.m_value = output.ans();
+}
+
+
+//---------------------------------------------Batch of Matches-----------------------------------------------
+
+StatusType world_cup_t::play_matches(const int* teamIds1, const int* teamIds2, size_t numMatches, StatusType* results)
+{
+    WriteGuard guard(m_lock);
+    if (teamIds1 == nullptr || teamIds2 == nullptr || results == nullptr) {
+        return StatusType::INVALID_INPUT;
+    }
+    StatusType status = flush_updates();
+    if (status != StatusType::SUCCESS) {
+        return status;
+    }
+    if (numMatches == 0) {
+        return StatusType::SUCCESS;
+    }
+    int num = (int) numMatches;
+    Team** teams1 = nullptr;
+    Team** teams2 = nullptr;
+    int* strengths1 = nullptr;
+    int* strengths2 = nullptr;
+    Tree<GenericNode<Team*>, Team*>* playing = nullptr;
+    try {
+        teams1 = new Team*[num];
+        teams2 = new Team*[num];
+        strengths1 = new int[num];
+        strengths2 = new int[num];
+        playing = new Tree<GenericNode<Team*>, Team*>();
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] teams1;
+        delete[] teams2;
+        delete[] strengths1;
+        delete[] strengths2;
+        return StatusType::ALLOCATION_ERROR;
+    }
+    //Find all of the teams first - playing a match does not change which teams are qualified
+    for (int i = 0; i < num; i++) {
+        teams1[i] = nullptr;
+        teams2[i] = nullptr;
+        if (teamIds1[i] == teamIds2[i] || teamIds1[i] <= 0 || teamIds2[i] <= 0) {
+            results[i] = StatusType::INVALID_INPUT;
+            continue;
+        }
+        Team** team1 = m_qualifiedTeams.find_data(teamIds1[i]);
+        Team** team2 = m_qualifiedTeams.find_data(teamIds2[i]);
+        if (team1 == nullptr || team2 == nullptr) {
+            results[i] = StatusType::FAILURE;
+            continue;
+        }
+        teams1[i] = *team1;
+        teams2[i] = *team2;
+        results[i] = StatusType::SUCCESS;
+    }
+    //Split the matches into runs where no team plays twice - a match with a team that already plays in the current
+    //run depends on its result, so the run is played before it and a new run begins
+    int first = 0;
+    for (int i = 0; i < num; i++) {
+        if (results[i] != StatusType::SUCCESS) {
+            continue;
+        }
+        try {
+            if (playing->find_data(teamIds1[i]) != nullptr || playing->find_data(teamIds2[i]) != nullptr) {
+                play_independent_matches(teams1, teams2, first, i - 1, results, strengths1, strengths2);
+                first = i;
+                delete playing;
+                playing = nullptr;
+                playing = new Tree<GenericNode<Team*>, Team*>();
+            }
+            playing->insert(teams1[i], teamIds1[i]);
+            playing->insert(teams2[i], teamIds2[i]);
+        }
+        catch (const std::bad_alloc& e) {
+            //The runs cannot be recorded - play the rest of the matches one at a time
+            for (int j = first; j < num; j++) {
+                play_independent_matches(teams1, teams2, j, j, results, strengths1, strengths2);
+            }
+            first = num;
+            break;
+        }
+    }
+    play_independent_matches(teams1, teams2, first, num - 1, results, strengths1, strengths2);
+    delete playing;
+    delete[] teams1;
+    delete[] teams2;
+    delete[] strengths1;
+    delete[] strengths2;
+    return StatusType::SUCCESS;
+}
+
+
+void world_cup_t::play_independent_matches(Team** teams1, Team** teams2, const int first, const int last,
+                                           const StatusType* results, int* strengths1, int* strengths2)
+{
+    if (first > last) {
+        return;
+    }
+    for (int i = first; i <= last; i++) {
+        if (results[i] == StatusType::SUCCESS) {
+            strengths1[i] = teams1[i]->get_strength();
+            strengths2[i] = teams2[i]->get_strength();
+        }
+        else {
+            strengths1[i] = 0;
+            strengths2[i] = 0;
+        }
+    }
+    //Replace the strengths by the points each team is awarded - 3 for a win, 1 for a tie and 0 for a loss
+    for (int i = first; i <= last; i++) {
+        int strength1 = strengths1[i];
+        int strength2 = strengths2[i];
+        int tie = (strength1 == strength2);
+        strengths1[i] = 3 * (strength1 > strength2) + tie;
+        strengths2[i] = 3 * (strength2 > strength1) + tie;
+    }
+    for (int i = first; i <= last; i++) {
+        if (results[i] != StatusType::SUCCESS) {
+            continue;
+        }
+        unlink_team_stats(teams1[i]);
+        unlink_team_stats(teams2[i]);
+        teams1[i]->add_points(strengths1[i]);
+        teams2[i]->add_points(strengths2[i]);
+        teams1[i]->add_game();
+        teams2[i]->add_game();
+        link_team_stats(teams1[i]);
+        link_team_stats(teams2[i]);
+    }
+}
+
+
+//----------------------------------------------Frozen Players------------------------------------------------
+
+StatusType world_cup_t::freeze_players(int maxDelta)
+{
+    WriteGuard guard(m_lock);
+    if (maxDelta < 0) {
+        return StatusType::INVALID_INPUT;
+    }
+    StatusType status = flush_updates();
+    if (status != StatusType::SUCCESS) {
+        return status;
+    }
+    m_frozenPlayers.set_limit(maxDelta);
+    m_frozenStale = false;
+    if (maxDelta == 0) {
+        m_frozenPlayers.clear();
+        return StatusType::SUCCESS;
+    }
+    try {
+        m_frozenPlayers.freeze(m_playersByID, m_playersByScore);
+    }
+    catch (const std::bad_alloc& e) {
+        m_frozenPlayers.set_limit(0);
+        m_frozenPlayers.clear();
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
+}
+
+
+//-------------------------------------------------Compaction-------------------------------------------------
+
+StatusType world_cup_t::compact_players()
+{
+    WriteGuard guard(m_lock);
+    StatusType status = flush_updates();
+    if (status != StatusType::SUCCESS) {
+        return status;
+    }
+    try {
+        m_pool.parallel_invoke([this]() { m_playersByID.compact(); }, [this]() { m_playersByScore.compact(); });
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
+}
+
+
+//----------------------------------------------Relaxed Balance-----------------------------------------------
+
+StatusType world_cup_t::set_relaxed_balance(int slack)
+{
+    WriteGuard guard(m_lock);
+    if (slack < 1) {
+        return StatusType::INVALID_INPUT;
+    }
+    StatusType status = flush_updates();
+    if (status != StatusType::SUCCESS) {
+        return status;
+    }
+    m_playersByID.set_relaxed(slack);
+    m_playersByScore.set_relaxed(slack);
+    m_teamsByID.set_relaxed(slack);
+    if (slack > 1) {
+        return StatusType::SUCCESS;
+    }
+    try {
+        m_playersByID.rebalance_all();
+        m_playersByScore.rebalance_all();
+        m_teamsByID.rebalance_all();
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
+}
+
+
+//----------------------------------------------Snapshot Reads------------------------------------------------
+
+StatusType world_cup_t::set_snapshot_reads(bool enabled)
+{
+    WriteGuard guard(m_lock);
+    StatusType status = flush_updates();
+    if (status != StatusType::SUCCESS) {
+        return status;
+    }
+    if (enabled == m_snapshotReads) {
+        return StatusType::SUCCESS;
+    }
+    if (!enabled) {
+        m_snapshotReads = false;
+        clear_versions();
+        return StatusType::SUCCESS;
+    }
+    //Build the versions from the trees, in the order of their keys
+    int numPlayers = m_playersByScore.get_size();
+    int numTeams = m_qualifiedTeams.get_size();
+    Player** players = nullptr;
+    Team** teams = nullptr;
+    int* ids = nullptr;
+    int* goals = nullptr;
+    int* cards = nullptr;
+    int* zeros = nullptr;
+    try {
+        int size = (numPlayers > numTeams) ? numPlayers : numTeams;
+        players = new Player*[numPlayers];
+        teams = new Team*[numTeams];
+        ids = new int[size];
+        goals = new int[size];
+        cards = new int[size];
+        zeros = new int[size]();
+        if (numPlayers > 0) {
+            m_playersByScore.m_node->unite_insert(players, 0);
+        }
+        m_pool.parallel_for(0, numPlayers, 4096, [&](int i) {
+            ids[i] = players[i]->get_playerId();
+            goals[i] = players[i]->get_goals();
+            cards[i] = players[i]->get_cards();
+        });
+        m_playersVersion.build(ids, ids, goals, cards, numPlayers);
+        if (numTeams > 0) {
+            m_qualifiedTeams.m_node->unite_insert(teams, 0);
+        }
+        for (int i = 0; i < numTeams; i++) {
+            ids[i] = teams[i]->get_teamID();
+            goals[i] = teams[i]->get_strength();
+        }
+        m_teamsVersion.build(goals, ids, zeros, zeros, numTeams);
+        m_snapshotReads = true;
+        publish_versions();
+    }
+    catch (const std::bad_alloc& e) {
+        clear_versions();
+        status = StatusType::ALLOCATION_ERROR;
+    }
+    delete[] players;
+    delete[] teams;
+    delete[] ids;
+    delete[] goals;
+    delete[] cards;
+    delete[] zeros;
+    return status;
+}
+
+
+//----------------------------------------------Worker Threads------------------------------------------------
+
+StatusType world_cup_t::set_worker_threads(int numThreads)
+{
+    WriteGuard guard(m_lock);
+    if (numThreads < 1) {
+        return StatusType::INVALID_INPUT;
+    }
+    //Every user of the pool holds m_lock, so no work is running in it
+    try {
+        m_pool.resize(numThreads);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    catch (const std::system_error& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
+}
+
+
+//-------------------------------------------Helper Functions----------------------------------------------
+
+int world_cup_t::compete(Team& team1, Team& team2) {
+    int point1 = team1.get_strength();
+    int point2 = team2.get_strength();
+    int winnerID = 0;
+    if (point1 > point2) {
+        team1.update_points_won();
+        winnerID = team1.get_teamID();
+    }
+    else if (point1 == point2) {
+        team1.update_points_tie();
+        team2.update_points_tie();
+        winnerID = 0; //a tie - b/c no team id is equal to 0
+    }
+    else {
+        team2.update_points_won();
+        winnerID = team2.get_teamID();
+    }
+    team1.add_game();
+    team2.add_game();
+    return winnerID;
+}
+
+
+Team* world_cup_t::knockout_games(Team* teams) {
+    //If there is only one team in the array, return
+    if (teams->get_closest_right() == nullptr) {
+        return teams;
+    }
+    //Find the first pair of the array
+    Team* second = teams->get_closest_right();
+    //If there are more teams in the array, call the function recursively in order to find the next pair
+    if (second->get_closest_right() != nullptr) {
+        knockout_games(second->get_closest_right());
+    }
+    //Play the match between the pair of teams found
+    int winnerID = compete(*teams, *second);
+    //Unite the teams according to who won and lost
+    if (winnerID == teams->get_teamID()) {
+        teams->knockout_unite(*teams, *second);
+        teams->update_closest_right(second->get_closest_right());
+        if (second->get_closest_right() != nullptr) {
+            second->get_closest_right()->update_closest_left(teams);
+        }
+    }
+    else if (winnerID == second->get_teamID()) {
+        teams->knockout_unite(*second, *teams);
+        second->update_closest_left(teams->get_closest_left());
+        if (teams->get_closest_left() != nullptr) {
+            teams->get_closest_left()->update_closest_right(second);
+        }
+        teams = second;
+    }
+    else {
+        if (teams->get_teamID() > second->get_teamID()) {
+            teams->knockout_unite(*teams, *second);
+            teams->update_closest_right(second->get_closest_right());
+            if (second->get_closest_right() != nullptr) {
+                second->get_closest_right()->update_closest_left(teams);
+            }
+        }
+        else {
+            teams->knockout_unite(*second, *teams);
+            second->update_closest_left(teams->get_closest_left());
+            if (teams->get_closest_left() != nullptr) {
+                teams->get_closest_left()->update_closest_right(second);
+            }
+            teams = second;
         }
     }
     return teams;
-}
\ No newline at end of file
+}
+
+
+void world_cup_t::unlink_team_stats(Team* team) {
+    if (m_inBatch && m_unlinkedTeams.find_data(team->get_teamID()) != nullptr) {
+        return;
+    }
+    try {
+        m_teamsByPoints.remove(team->get_teamID(), team->get_points(), 0);
+    }
+    catch (const NodeNotFound& e) {}
+    //Only qualified teams are ranked by strength
+    if (team->is_valid()) {
+        try {
+            m_qualifiedByStrength.remove(team->get_teamID(), team->get_strength(), 0);
+        }
+        catch (const NodeNotFound& e) {}
+        update_version(m_teamsVersion, false, team->get_teamID(), 0, 0, team->get_strength());
+    }
+}
+
+
+void world_cup_t::link_team_stats(Team* team) {
+    if (m_inBatch) {
+        try {
+            if (m_unlinkedTeams.find_data(team->get_teamID()) == nullptr) {
+                m_unlinkedTeams.insert(team, team->get_teamID());
+            }
+            return;
+        }
+        catch (const std::bad_alloc& e) {
+            //The team could not be recorded - link it back right away
+        }
+    }
+    insert_team_stats(team);
+}
+
+
+void world_cup_t::insert_team_stats(Team* team) {
+    //Teams are sorted by a single stat and their ID, so the secondary key of MultiTree is always 0
+    m_teamsByPoints.insert(team, team->get_teamID(), team->get_points(), 0);
+    if (team->is_valid()) {
+        m_qualifiedByStrength.insert(team, team->get_teamID(), team->get_strength(), 0);
+        update_version(m_teamsVersion, true, team->get_teamID(), 0, 0, team->get_strength());
+    }
+    m_teamsByID.update_path(team->get_teamID());
+}
+
+
+void world_cup_t::link_batch_teams()
+{
+    //The teams are taken one by one from the largest ID, so nothing is allocated to walk them
+    Team** last;
+    while ((last = m_unlinkedTeams.find_max_data()) != nullptr) {
+        Team* team = *last;
+        m_unlinkedTeams.remove(team->get_teamID());
+        insert_team_stats(team);
+    }
+}
+
+
+void world_cup_t::update_top_scorer() {
+    if (m_inBatch) {
+        m_topScorerDirty = true;
+        return;
+    }
+    m_overallTopScorer = m_playersByScore.search_and_return_max();
+}
+
+
+void world_cup_t::refresh_top_scorer() {
+    if (m_topScorerDirty) {
+        m_overallTopScorer = m_playersByScore.search_and_return_max();
+        m_topScorerDirty = false;
+    }
+}
+
+
+void world_cup_t::record_player_change(int playerId, Player* tmpPlayer)
+{
+    if (!m_frozenPlayers.is_enabled()) {
+        return;
+    }
+    try {
+        m_frozenPlayers.record(playerId, tmpPlayer);
+        if (m_frozenPlayers.is_stale()) {
+            m_frozenStale = true;
+        }
+    }
+    catch (const std::bad_alloc& e) {
+        //The trees are always up to date, so the system can simply stop using the snapshot
+        m_frozenPlayers.set_limit(0);
+        m_frozenPlayers.clear();
+    }
+}
+
+
+void world_cup_t::refresh_frozen_players()
+{
+    if (!m_frozenPlayers.is_stale()) {
+        return;
+    }
+    try {
+        m_frozenPlayers.freeze(m_playersByID, m_playersByScore);
+    }
+    catch (const std::bad_alloc& e) {
+        m_frozenPlayers.set_limit(0);
+        m_frozenPlayers.clear();
+    }
+    m_frozenStale = false;
+}
+
+
+Player* world_cup_t::find_player(int playerId)
+{
+    if (m_frozenPlayers.is_enabled()) {
+        return m_frozenPlayers.find(playerId);
+    }
+    Player** found = m_playersByID.find_data(playerId);
+    if (found == nullptr) {
+        return nullptr;
+    }
+    return *found;
+}
+
+
+int world_cup_t::lock_for_read()
+{
+    bool flushFailed = false;
+    while (true) {
+        int slot = m_lock.lock_shared();
+        if (flushFailed || !has_deferred_work()) {
+            return slot;
+        }
+        m_lock.unlock_shared(slot);
+        {
+            WriteGuard guard(m_lock);
+            //A flush that could not allocate keeps the updates held, so the query reads without them instead of
+            //retrying
+            flushFailed = (flush_updates() == StatusType::ALLOCATION_ERROR && m_updateBuffer.get_size() > 0);
+            refresh_top_scorer();
+            refresh_frozen_players();
+        }
+    }
+}
+
+
+bool world_cup_t::has_deferred_work() const
+{
+    //The held updates and the top scorer only change while m_lock is held for writing, and the snapshot may grow
+    //stale while m_lock is held for reading, so m_frozenStale is read instead of the snapshot
+    return m_updateBuffer.get_size() > 0 || m_topScorerDirty || m_frozenStale;
+}
+
+
+void world_cup_t::update_version(VersionedTree<int>& version, bool insert, int id, int primary, int secondary,
+                                 int data)
+{
+    if (!m_snapshotReads) {
+        return;
+    }
+    try {
+        if (insert) {
+            version.insert(data, id, primary, secondary);
+        }
+        else {
+            version.remove(id, primary, secondary);
+        }
+    }
+    catch (const NodeNotFound& e) {}
+    catch (const InvalidID& e) {}
+    catch (const std::bad_alloc& e) {
+        //The versions no longer match the trees - the readers go back to reading the trees
+        m_snapshotReads = false;
+        clear_versions();
+    }
+}
+
+
+bool world_cup_t::publish_versions()
+{
+    WriteGuard indexGuard(m_indexLock);
+    if (!m_snapshotReads) {
+        return false;
+    }
+    m_playersVersion.publish();
+    m_teamsVersion.publish();
+    m_epochs.reclaim();
+    return true;
+}
+
+
+void world_cup_t::clear_versions()
+{
+    m_playersVersion.clear();
+    m_teamsVersion.clear();
+    m_playersVersion.publish();
+    m_teamsVersion.publish();
+    m_epochs.reclaim();
+}
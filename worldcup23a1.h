@@ -21,18 +21,30 @@
 #include "AVLTree.h"
 #include "GenericNode.h"
 #include "AVLMultiVariable.h"
+#include "AggregateNode.h"
+#include "TeamSummary.h"
+#include "UpdateBuffer.h"
+#include "FrozenPlayers.h"
+#include "RWLock.h"
+#include "EpochManager.h"
+#include "VersionedTree.h"
+#include "ThreadPool.h"
+#include "Command.h"
 #include <memory.h>
+#include <cstddef>
+#include <atomic>
 
 class world_cup_t {
 private:
     //Total number of players throughout the entire game
-    int m_totalNumPlayers;
+    std::atomic<int> m_totalNumPlayers;
 
     //Shared pointer to the player with the top stats (goals + cards + ID)
     Player* m_overallTopScorer;
 
     //Tree of shared pointers of the type team, with all the teams in the game sorted by their ID
-    Tree<GenericNode<Team*>, Team*> m_teamsByID;
+    //      Every node also holds the summary of the stats of the teams in its subtree
+    Tree<AggregateNode<Team*>, Team*> m_teamsByID;
 
     //Tree of shared pointers of the type team, with all the teams in the game with more than 11 players, and at least
     //      one goalkeeper, sorted by the team ID
@@ -44,6 +56,55 @@ private:
     //Tree of shared pointers of the type player, with all the players in the game sorted by their goals, cards and ID
     MultiTree<Player*> m_playersByScore;
 
+    //Tree of pointers of the type team, with all the teams in the game sorted by their points and ID
+    MultiTree<Team*> m_teamsByPoints;
+
+    //Tree of pointers of the type team, with all the qualified teams sorted by their match strength
+    //      (points + goals - cards) and ID
+    MultiTree<Team*> m_qualifiedByStrength;
+
+    //The player stat updates that were not applied yet, when the update buffer is enabled
+    UpdateBuffer m_updateBuffer;
+
+    //Whether a batch is running, and whether m_overallTopScorer is out of date because its update was deferred
+    bool m_inBatch;
+    bool m_topScorerDirty;
+
+    //Tree of pointers of the type team, with the teams of a running batch that are out of m_teamsByPoints and
+    //      m_qualifiedByStrength, sorted by their ID - they are linked back once, before the standings are read
+    Tree<GenericNode<Team*>, Team*> m_unlinkedTeams;
+
+    //Read-only snapshot of the players, used for the reads of players when the system is frozen
+    FrozenPlayers m_frozenPlayers;
+
+    //Whether the snapshot should be taken again - set while m_indexLock is held for writing, and read without it
+    std::atomic<bool> m_frozenStale;
+
+    //Locks of the system, always taken in this order:
+    //      m_lock - held for writing by the functions that add, remove or unite teams, remove players or change the
+    //          settings of the system, and for reading by every other function
+    //      The locks of the teams, in the order of their ID's - held by the functions that change a team, and by the
+    //          queries of a single team
+    //      m_indexLock - held for writing while the trees and counters shared by all the teams change, and for
+    //          reading by the queries that read them
+    //The stats of players and teams only change while holding both the lock of their team and m_indexLock, so
+    //      either of them is enough to read the stats.
+    RWLock m_lock;
+    RWLock m_indexLock;
+
+    //Versions of the players sorted by their goals, cards and ID, and of the qualified teams sorted by their ID with
+    //      their match strength, read without any lock when snapshot reads are enabled. Their working versions only
+    //      change while holding m_indexLock for writing (or m_lock), and the nodes a published version no longer
+    //      uses are freed once the readers pinned in m_epochs are done.
+    EpochManager m_epochs;
+    VersionedTree<int> m_playersVersion;
+    VersionedTree<int> m_teamsVersion;
+    std::atomic<bool> m_snapshotReads;
+
+    //The threads that run independent parts of heavy operations, such as the merges of unite_teams and the
+    //      compaction of the players. A single thread by default, running them inline.
+    ThreadPool m_pool;
+
 	/*
 	 * Helper functions for world_cup:
 	 * compete: finds the winner and loser of each match according the relevant parameters.
@@ -53,6 +114,120 @@ private:
 	int compete(Team& team1, Team& team2);
 	Team* knockout_games(Team* teams);
 
+	/*
+	 * Helper functions for the team standings:
+	 * unlink_team_stats: removes a team from the trees sorted by its points and strength, before its stats change.
+	 * link_team_stats: inserts a team back into the trees sorted by its points and strength, after its stats changed,
+	 * 		and updates the summaries of m_teamsByID that include the team. During a batch the team is only recorded
+	 * 		in m_unlinkedTeams, and unlink_team_stats leaves the teams recorded there as they are.
+	 * insert_team_stats: inserts a team back into the trees right away.
+	 * link_batch_teams: links back all the teams recorded in m_unlinkedTeams.
+	*/
+	void unlink_team_stats(Team* team);
+	void link_team_stats(Team* team);
+	void insert_team_stats(Team* team);
+	void link_batch_teams();
+
+	/*
+	 * Helper functions for add_player, play_match and apply_batch, once the teams were found:
+	 * add_team_player: adds a player to the team, as add_player does after checking its arguments.
+	 * play_team_match: plays a match between two qualified teams.
+	*/
+	StatusType add_team_player(Team* tmpTeam, int playerId, int gamesPlayed, int goals, int cards, bool goalKeeper);
+	StatusType play_team_match(Team* team1, Team* team2);
+
+	/*
+	 * Helper function for update_player_stats and flush_updates:
+	 * apply_player_stats: updates the stats of a player and moves it within the tree of all the players sorted by
+	 * 		score, without changing its team - reposition_team_player moves it within its team.
+	*/
+	void apply_player_stats(Player* tmpPlayer, int gamesPlayed, int scoredGoals, int cardsReceived);
+
+	/*
+	 * Helper functions for update_player_stats without the update buffer:
+	 * update_team_player: applies an update while holding only the lock of the team of the player, and m_indexLock
+	 * 		while the trees shared by all the teams change.
+	 * reposition_team_player: moves an updated player within the players by score tree of its team.
+	*/
+	StatusType update_team_player(int playerId, int gamesPlayed, int scoredGoals, int cardsReceived);
+	void reposition_team_player(Player* tmpPlayer, int previousGoals, int previousCards);
+
+	/*
+	 * Helper functions for the overall top scorer:
+	 * update_top_scorer: recalculates m_overallTopScorer after the players by score changed - during a batch it only
+	 * 		marks it as out of date, and it is recalculated once it is read or the batch ends.
+	 * refresh_top_scorer: recalculates m_overallTopScorer if it is out of date.
+	*/
+	void update_top_scorer();
+	void refresh_top_scorer();
+
+	/*
+	 * Helper functions for the frozen players:
+	 * record_player_change: records a player that was added, updated or removed (nullptr) in the delta of the
+	 * 		snapshot, if the system is frozen.
+	 * refresh_frozen_players: takes the snapshot again if its delta grew too large.
+	 * find_player: searches for a player by ID in the snapshot if the system is frozen, and in the tree of all the
+	 * 		players otherwise.
+	*/
+	void record_player_change(int playerId, Player* tmpPlayer);
+	void refresh_frozen_players();
+	Player* find_player(int playerId);
+
+	/*
+	 * Helper functions for the lock:
+	 * lock_for_read: locks m_lock for reading and returns the reader slot. The queries apply the held updates and
+	 * 		refresh the overall top scorer and the frozen players first, so if any of these is due, it is done while
+	 * 		holding the lock for writing, before locking for reading. If the held updates cannot be applied for lack
+	 * 		of memory, they stay held and the query reads without them.
+	 * has_deferred_work: checks whether any of these is due, without m_indexLock.
+	*/
+	int lock_for_read();
+	bool has_deferred_work() const;
+
+	/*
+	 * Helper functions for the snapshot reads:
+	 * update_version: inserts or removes a node of a version, if snapshot reads are enabled - if there is not enough
+	 * 		memory, snapshot reads are disabled instead.
+	 * publish_versions: publishes the working versions and frees the nodes no reader uses anymore. Returns false if
+	 * 		snapshot reads are disabled, so the caller reads the trees instead.
+	 * clear_versions: empties and publishes the versions.
+	*/
+	void update_version(VersionedTree<int>& version, bool insert, int id, int primary, int secondary, int data);
+	bool publish_versions();
+	void clear_versions();
+
+	/*
+	 * Helper functions for apply_batch:
+	 * is_valid_command: checks the arguments of a command, the same way the matching function does.
+	 * get_command_teams: stores the ID's of the teams a command names, and returns their number.
+	 * find_batch_teams: looks up every team the valid commands name once, and stores it (or nullptr, if there is no
+	 * 		such team) in batchTeams.
+	 * refresh_batch_teams: looks up the teams a command added or removed again.
+	 * apply_batch_command: runs a single command with the teams of batchTeams and stores its result.
+	 * fails_lookup: checks whether a command fails because the player it needs does not exist, without throwing -
+	 * 		the matching function would find the same by catching NodeNotFound.
+	 * apply_command: runs a single command through the matching function and stores its result.
+	 * store_output: stores the status and answer of an output_t in a result.
+	*/
+	static bool is_valid_command(const Command& command);
+	static int get_command_teams(const Command& command, int* teamIds);
+	void find_batch_teams(const Command* commands, size_t numCommands, const Result* results,
+						  Tree<GenericNode<Team*>, Team*>& batchTeams);
+	void refresh_batch_teams(const Command& command, Tree<GenericNode<Team*>, Team*>& batchTeams);
+	void apply_batch_command(const Command& command, Tree<GenericNode<Team*>, Team*>& batchTeams, Result& result);
+	bool fails_lookup(const Command& command) const;
+	void apply_command(const Command& command, Result& result);
+	static void store_output(output_t<int> output, Result& result);
+
+	/*
+	 * Helper function for play_matches:
+	 * Plays the matches first to last, where no team plays more than one of them - the strength of every team is
+	 * 		read before any match is played, and the points each team is awarded are computed in one pass.
+	 * 		Matches whose result is not SUCCESS are skipped.
+	*/
+	void play_independent_matches(Team** teams1, Team** teams2, const int first, const int last,
+								  const StatusType* results, int* strengths1, int* strengths2);
+
 public:
 	// <DO-NOT-MODIFY> {
 	
@@ -90,6 +265,151 @@ public:
 	output_t<int> knockout_winner(int minTeamId, int maxTeamId);
 	
 	// } </DO-NOT-MODIFY>
+
+	/*
+	 * Team standings:
+	 * get_top_teams_by_points: inserts the ID's of up to amount teams with the most points into output, ties are
+	 * 		broken by the higher team ID. Returns the number of ID's inserted.
+	 * get_strongest_teams: the same, for the qualified teams ordered by their strength (points + goals - cards).
+	 * get_team_points_rank / get_team_strength_rank: the position of a team in these orders, starting at 1.
+	*/
+	output_t<int> get_top_teams_by_points(int amount, int *const output);
+
+	output_t<int> get_strongest_teams(int amount, int *const output);
+
+	output_t<int> get_team_points_rank(int teamId);
+
+	output_t<int> get_team_strength_rank(int teamId);
+
+	/*
+	 * Team summaries:
+	 * get_teams_summary: the sum, minimum or maximum of a stat over all the teams with an ID in
+	 * 		[minTeamId, maxTeamId], in O(log n).
+	*/
+	output_t<int> get_teams_summary(int minTeamId, int maxTeamId, TeamStat stat, SummaryType type);
+
+	/*
+	 * Top scorers:
+	 * get_top_scorers: inserts the ID's of up to amount top scorers of the team (or of the entire game, if teamId < 0)
+	 * 		into output, starting with the top scorer. Returns the number of ID's inserted.
+	*/
+	output_t<int> get_top_scorers(int teamId, int amount, int *const output);
+
+	/*
+	 * Player range queries, for the players of a team (or of the entire game, if teamId < 0):
+	 * count_players_by_goals / get_players_by_goals: the players with minGoals to maxGoals goals, in O(log n).
+	 * count_players_by_cards / get_players_by_cards: the players with more than the given number of cards, in
+	 * 		O(log n) per distinct number of goals.
+	 * The get functions insert the ID's into output in the order of get_all_players and return their number.
+	*/
+	output_t<int> count_players_by_goals(int teamId, int minGoals, int maxGoals);
+
+	output_t<int> get_players_by_goals(int teamId, int minGoals, int maxGoals, int *const output);
+
+	output_t<int> count_players_by_cards(int teamId, int cards);
+
+	output_t<int> get_players_by_cards(int teamId, int cards, int *const output);
+
+	/*
+	 * Streaming the players, for the players of a team (or of the entire game, if teamId < 0):
+	 * get_players_chunk: inserts the ID's of up to capacity players that come after the cursor into output, in the
+	 * 		order of get_all_players, and moves the cursor to the last of them. Returns the number of ID's inserted -
+	 * 		fewer than capacity once the last player was reached. Each call runs in O(log n + capacity) and needs no
+	 * 		memory beyond output, so a walk over any number of players takes a fixed buffer. Each chunk is read under
+	 * 		the locks, but the walk is not - a player whose goals or cards change between calls may be passed twice
+	 * 		or not at all, while a player that is not changed, added or removed during the walk is passed once.
+	*/
+	output_t<int> get_players_chunk(int teamId, PlayerCursor& cursor, int *const output, int capacity);
+
+	/*
+	 * Closest players, among the players of a team (or of the entire game, if teamId < 0):
+	 * get_closest_players: inserts the ID's of up to amount players closest to the given player into output,
+	 * 		starting with the closest. Players are compared as in get_closest_player - by the difference in goals,
+	 * 		then in cards, then in ID, and finally preferring the bigger ID - but over all the searched players
+	 * 		rather than only the two neighbours in the ranking. Returns the number of ID's inserted.
+	 * get_closest_to_profile: the same, for the players closest to the given goals and cards.
+	 * Both run in O(log n) per distinct distance of goals and cards reached, plus O(1) amortized per player.
+	*/
+	output_t<int> get_closest_players(int playerId, int teamId, int amount, int *const output);
+
+	output_t<int> get_closest_to_profile(int goals, int cards, int teamId, int amount, int *const output);
+
+	/*
+	 * Update buffer:
+	 * set_update_buffer: while maxPending > 0, update_player_stats only validates the update and coalesces it with
+	 * 		the previous updates of the same player. The updates are applied in a batch sorted by player ID once
+	 * 		maxPending players have updates, once the oldest update waited maxDelayMs milliseconds (0 for no time
+	 * 		budget), or before any operation that reads player stats or the order of the players.
+	 * 		maxPending = 0 applies the held updates and disables the buffer.
+	 * flush_updates: applies the held updates.
+	*/
+	StatusType set_update_buffer(int maxPending, int maxDelayMs);
+
+	StatusType flush_updates();
+
+	/*
+	 * Batch of commands:
+	 * apply_batch: runs numCommands commands in order and stores the result of each one in results, exactly as if
+	 * 		the matching functions were called one after the other. The arguments of all the commands are checked
+	 * 		before the first one runs, and every team the commands name is looked up once. The overall top scorer
+	 * 		is recalculated only when it is read or once the batch ends, and the teams whose stats changed are put
+	 * 		back in the standings once, when a command reads them or the batch ends.
+	*/
+	StatusType apply_batch(const Command* commands, size_t numCommands, Result* results);
+
+	/*
+	 * Batch of matches:
+	 * play_matches: plays numMatches matches in order and stores the result of each one in results, exactly as if
+	 * 		play_match(teamIds1[i], teamIds2[i]) was called for every i. Consecutive matches where no team plays twice
+	 * 		do not depend on each other, so they are scored together.
+	*/
+	StatusType play_matches(const int* teamIds1, const int* teamIds2, size_t numMatches, StatusType* results);
+
+	/*
+	 * Frozen players:
+	 * freeze_players: for workloads that are almost only reads. While maxDelta > 0, a read-only snapshot of the
+	 * 		players is kept - the players by ID in a cache-friendly array, and the ID's of all the players in the order
+	 * 		of their score. get_num_played_games, get_closest_players and get_all_players read the snapshot, after
+	 * 		checking the players changed since it was taken. Once more than maxDelta players changed, the snapshot is
+	 * 		taken again on the next read. Writes still update the trees, so every other function is unaffected.
+	 * 		maxDelta = 0 frees the snapshot.
+	*/
+	StatusType freeze_players(int maxDelta);
+
+	/*
+	 * Compaction:
+	 * compact_players: moves the nodes of the trees of all the players into contiguous memory, in the order of their
+	 * 		keys, so walks and searches of long-lived trees touch fewer cache lines. The trees keep working as usual
+	 * 		afterwards, and the function may be called again whenever they become fragmented.
+	*/
+	StatusType compact_players();
+
+	/*
+	 * Relaxed balance:
+	 * set_relaxed_balance: for bursts of writes, such as roster imports. While slack > 1, the trees of all the
+	 * 		players and of the teams by ID only rotate a node once the heights of its subtrees differ by more than
+	 * 		slack, so most rotations are skipped. slack = 1 restores strict AVL balance, rebalancing the trees once.
+	*/
+	StatusType set_relaxed_balance(int slack);
+
+	/*
+	 * Snapshot reads:
+	 * set_snapshot_reads: for long reads running alongside writers. While enabled, a version of the players by score
+	 * 		and of the qualified teams is kept beside the trees. get_all_players of the whole game and knockout_winner
+	 * 		publish the current version, release the lock, and walk the version while writers continue - a writer
+	 * 		copies the nodes of a published version instead of changing them, and they are freed once every reader
+	 * 		that may use them is done.
+	*/
+	StatusType set_snapshot_reads(bool enabled);
+
+	/*
+	 * Worker threads:
+	 * set_worker_threads: sets the number of threads that run the heavy operations of the system (numThreads >= 1,
+	 * 		counting the thread that calls them). numThreads = 1 runs everything on the calling thread. get_all_players
+	 * 		also fills the ranges of large subtrees in parallel, unless it walks a published version, which it does
+	 * 		after releasing m_lock.
+	*/
+	StatusType set_worker_threads(int numThreads);
 };
 
 #endif // WORLDCUP23A1_H_